@@ -1,14 +1,399 @@
 #include "cashpage.h"
+#include "databaseservice.h"
+#include "thememanager.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
-#include <QLabel>
+#include <QHBoxLayout>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QLocale>
+#include <QDebug>
 
-CashPage::CashPage(QWidget *parent) : QFrame(parent)
+namespace {
+// Le tableau montre la fin du journal ; les totaux couvrent toute la session
+const int LedgerRows = 200;
+
+QString movementLabel(const QString &type)
+{
+    if (type == "OUVERTURE") return "Ouverture";
+    if (type == "VENTE") return "Vente";
+    if (type == "ANNULATION") return "Annulation";
+    if (type == "ENTREE") return "Entrée";
+    if (type == "SORTIE") return "Sortie";
+    return type;
+}
+}
+
+CashPage::CashPage(int userId, QWidget *parent)
+    : QFrame(parent), currentUserId(userId), hasSession(false), loadGeneration(0)
 {
     setObjectName("cashPage");
+    setupUI();
+    loadSession();
+}
+
+void CashPage::setupUI()
+{
     QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setSpacing(24);
+    layout->setContentsMargins(40, 40, 40, 40);
+
+    QHBoxLayout *headerLayout = new QHBoxLayout();
     QLabel *title = new QLabel("Gestion de la Caisse", this);
     title->setObjectName("titleH1");
-    layout->addWidget(title);
-    // Ajouter des widgets pour la gestion de la caisse ici
-    layout->addStretch();
-}
\ No newline at end of file
+    headerLayout->addWidget(title);
+    headerLayout->addStretch();
+
+    statusLabel = new QLabel(this);
+    statusLabel->setObjectName("sessionStatus");
+    ThemeManager::setTone(statusLabel, "secondary");
+    headerLayout->addWidget(statusLabel);
+    layout->addLayout(headerLayout);
+
+    // Totaux de la session
+    QGridLayout *totalsLayout = new QGridLayout();
+    totalsLayout->setHorizontalSpacing(32);
+    totalsLayout->setVerticalSpacing(12);
+
+    auto addTotal = [this, totalsLayout](const QString &caption, int row, int column) {
+        QLabel *captionLabel = new QLabel(caption, this);
+        captionLabel->setObjectName("totalCaption");
+        ThemeManager::setTone(captionLabel, "secondary");
+        QLabel *valueLabel = new QLabel("—", this);
+        valueLabel->setObjectName("totalValue");
+        totalsLayout->addWidget(captionLabel, row * 2, column);
+        totalsLayout->addWidget(valueLabel, row * 2 + 1, column);
+        return valueLabel;
+    };
+    fondLabel = addTotal("Fond de caisse", 0, 0);
+    ventesLabel = addTotal("Ventes", 0, 1);
+    annulationsLabel = addTotal("Annulations", 0, 2);
+    entreesLabel = addTotal("Entrées d'espèces", 1, 0);
+    sortiesLabel = addTotal("Sorties d'espèces", 1, 1);
+    soldeLabel = addTotal("Solde théorique", 1, 2);
+    layout->addLayout(totalsLayout);
+
+    QHBoxLayout *actionsLayout = new QHBoxLayout();
+    actionsLayout->setSpacing(12);
+
+    openBtn = createButton("🔓 Ouvrir la caisse", "success");
+    cashInBtn = createButton("➕ Entrée d'espèces", "primary");
+    cashOutBtn = createButton("➖ Sortie d'espèces", "warning");
+    xReportBtn = createButton("📄 Rapport X", "info");
+    closeBtn = createButton("🔒 Clôturer (Z)", "danger");
+    QPushButton *refreshBtn = createButton("🔄 Actualiser", "primary");
+
+    connect(openBtn, &QPushButton::clicked, this, &CashPage::onOpenSession);
+    connect(cashInBtn, &QPushButton::clicked, this, &CashPage::onCashIn);
+    connect(cashOutBtn, &QPushButton::clicked, this, &CashPage::onCashOut);
+    connect(xReportBtn, &QPushButton::clicked, this, &CashPage::onXReport);
+    connect(closeBtn, &QPushButton::clicked, this, &CashPage::onCloseSession);
+    connect(refreshBtn, &QPushButton::clicked, this, &CashPage::loadSession);
+
+    actionsLayout->addWidget(openBtn);
+    actionsLayout->addWidget(cashInBtn);
+    actionsLayout->addWidget(cashOutBtn);
+    actionsLayout->addWidget(xReportBtn);
+    actionsLayout->addWidget(closeBtn);
+    actionsLayout->addStretch();
+    actionsLayout->addWidget(refreshBtn);
+    layout->addLayout(actionsLayout);
+
+    // Journal de la session
+    ledgerTable = new QTableWidget(this);
+    ledgerTable->setColumnCount(4);
+    ledgerTable->setHorizontalHeaderLabels(QStringList() << "Date" << "Type" << "Libellé" << "Montant");
+    ledgerTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    ledgerTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    ledgerTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ledgerTable->setShowGrid(false);
+    ledgerTable->verticalHeader()->setVisible(false);
+    ledgerTable->verticalHeader()->setDefaultSectionSize(44);
+    ledgerTable->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+    ledgerTable->horizontalHeader()->setStretchLastSection(true);
+    ledgerTable->setColumnWidth(0, 180);
+    ledgerTable->setColumnWidth(1, 140);
+    ledgerTable->setColumnWidth(2, 320);
+    layout->addWidget(ledgerTable, 1);
+}
+
+QString CashPage::styleRules()
+{
+    return QString(
+        "#cashPage QLabel#sessionStatus {"
+        "   font-size: 15px;"
+        "   font-weight: 600;"
+        "}"
+        "#cashPage QLabel#totalCaption {"
+        "   font-size: 13px;"
+        "}"
+        "#cashPage QLabel#totalValue {"
+        "   color: palette(window-text);"
+        "   font-size: 20px;"
+        "   font-weight: 700;"
+        "}"
+        "#cashPage QPushButton#actionButton {"
+        "   border: none;"
+        "   border-radius: 12px;"
+        "   padding: 10px 20px;"
+        "   font-size: 14px;"
+        "   font-weight: 600;"
+        "}"
+    );
+}
+
+QPushButton *CashPage::createButton(const QString &text, const QString &variant)
+{
+    QPushButton *button = new QPushButton(text, this);
+    button->setMinimumHeight(44);
+    button->setCursor(Qt::PointingHandCursor);
+    // Couleurs (normal, survol, désactivé) données par la feuille globale
+    button->setProperty("variant", variant);
+    button->setObjectName("actionButton");
+    return button;
+}
+
+void CashPage::loadSession()
+{
+    UiProfiler::Scope scope("CashPage::loadSession");
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+
+    pendingLoad = DatabaseService::instance().run<CashSnapshot>([](QSqlDatabase &db) {
+        CashSnapshot snapshot;
+        snapshot.hasSession = CashRepository::currentSession(snapshot.session, db);
+        if (!snapshot.hasSession && !CashRepository::lastError().isEmpty()) {
+            snapshot.error = CashRepository::lastError();
+            return snapshot;
+        }
+        if (snapshot.hasSession) {
+            snapshot.movements = CashRepository::movements(snapshot.session.id, LedgerRows, db);
+            if (!CashRepository::lastError().isEmpty()) {
+                snapshot.error = CashRepository::lastError();
+                return snapshot;
+            }
+        } else {
+            snapshot.pendingPayments = CashRepository::pendingCount(db);
+            if (snapshot.pendingPayments < 0) {
+                snapshot.error = CashRepository::lastError();
+                return snapshot;
+            }
+        }
+        snapshot.ok = true;
+        return snapshot;
+    });
+
+    pendingLoad.then(this, [this, generation](const CashSnapshot &snapshot) {
+        if (generation == loadGeneration) {
+            displaySnapshot(snapshot);
+        }
+    });
+}
+
+void CashPage::displaySnapshot(const CashSnapshot &snapshot)
+{
+    // Boîte d'erreur (boucle d'événements imbriquée) hors de la portion mesurée
+    if (!snapshot.ok) {
+        qDebug() << "Erreur lors du chargement de la caisse:" << snapshot.error;
+        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement de la caisse: " + snapshot.error);
+        return;
+    }
+    UiProfiler::Scope scope("CashPage::displaySnapshot");
+
+    hasSession = snapshot.hasSession;
+    session = snapshot.session;
+
+    openBtn->setEnabled(!hasSession);
+    cashInBtn->setEnabled(hasSession);
+    cashOutBtn->setEnabled(hasSession);
+    xReportBtn->setEnabled(hasSession);
+    closeBtn->setEnabled(hasSession);
+
+    if (!hasSession) {
+        statusLabel->setText(snapshot.pendingPayments > 0
+                                 ? QString("Caisse fermée — %1 paiement(s) hors session, reporté(s) à l'ouverture")
+                                       .arg(snapshot.pendingPayments)
+                                 : QString("Caisse fermée"));
+        for (QLabel *label : {fondLabel, ventesLabel, annulationsLabel, entreesLabel, sortiesLabel, soldeLabel}) {
+            label->setText("—");
+        }
+        ledgerTable->setRowCount(0);
+        return;
+    }
+
+    statusLabel->setText(QString("Session n°%1 ouverte le %2")
+                             .arg(session.id)
+                             .arg(session.openedAt.toString("dd/MM/yyyy hh:mm")));
+    fondLabel->setText(formatAmount(session.fondInitial));
+    ventesLabel->setText(QString("%1 (%2)").arg(formatAmount(session.totalVentes)).arg(session.nbVentes));
+    annulationsLabel->setText(QString("%1 (%2)").arg(formatAmount(session.totalAnnulations)).arg(session.nbAnnulations));
+    entreesLabel->setText(formatAmount(session.totalEntrees));
+    sortiesLabel->setText(formatAmount(session.totalSorties));
+    soldeLabel->setText(formatAmount(session.soldeTheorique));
+
+    ledgerTable->setRowCount(snapshot.movements.size());
+    for (int row = 0; row < snapshot.movements.size(); ++row) {
+        const CashMovement &movement = snapshot.movements.at(row);
+        ledgerTable->setItem(row, 0, new QTableWidgetItem(movement.date.toString("dd/MM/yyyy hh:mm")));
+        ledgerTable->setItem(row, 1, new QTableWidgetItem(movementLabel(movement.type)));
+        ledgerTable->setItem(row, 2, new QTableWidgetItem(movement.libelle));
+        ledgerTable->setItem(row, 3, new QTableWidgetItem(formatAmount(movement.montant)));
+    }
+}
+
+void CashPage::onOpenSession()
+{
+    bool ok = false;
+    double fond = QInputDialog::getDouble(this, "Ouverture de caisse", "Fond de caisse (€) :",
+                                          0.0, 0.0, 1000000.0, 2, &ok);
+    if (!ok) {
+        return;
+    }
+
+    const int userId = currentUserId;
+    runAction([userId, fond](QSqlDatabase &db) {
+        CashAction action;
+        action.ok = CashRepository::openSession(userId, fond, db) >= 0;
+        action.error = CashRepository::lastError();
+        return action;
+    }, "Erreur lors de l'ouverture de la caisse: ");
+}
+
+void CashPage::onCashIn()
+{
+    addMovement("ENTREE", "Entrée d'espèces");
+}
+
+void CashPage::onCashOut()
+{
+    addMovement("SORTIE", "Sortie d'espèces");
+}
+
+void CashPage::addMovement(const QString &type, const QString &title)
+{
+    if (!hasSession) {
+        return;
+    }
+
+    bool ok = false;
+    double montant = QInputDialog::getDouble(this, title, "Montant (€) :", 0.0, 0.01, 1000000.0, 2, &ok);
+    if (!ok) {
+        return;
+    }
+    QString libelle = QInputDialog::getText(this, title, "Motif :", QLineEdit::Normal, QString(), &ok).trimmed();
+    if (!ok) {
+        return;
+    }
+
+    const int sessionId = session.id;
+    runAction([sessionId, type, montant, libelle](QSqlDatabase &db) {
+        CashAction action;
+        action.ok = CashRepository::addMovement(sessionId, type, montant, libelle, db);
+        action.error = CashRepository::lastError();
+        return action;
+    }, "Erreur lors de l'enregistrement du mouvement: ");
+}
+
+void CashPage::onXReport()
+{
+    if (!hasSession) {
+        return;
+    }
+
+    // Rapport X : lecture des totaux de la session, sans la clôturer
+    const int sessionId = session.id;
+    runAction([sessionId](QSqlDatabase &db) {
+        CashAction action;
+        action.ok = CashRepository::find(sessionId, action.session, db);
+        action.error = CashRepository::lastError();
+        if (!action.ok && action.error.isEmpty()) {
+            action.error = "Session de caisse introuvable.";
+        }
+        return action;
+    }, "Erreur lors de la lecture de la session: ", "Rapport X");
+}
+
+void CashPage::onCloseSession()
+{
+    if (!hasSession) {
+        return;
+    }
+
+    bool ok = false;
+    double compte = QInputDialog::getDouble(this, "Clôture de caisse", "Espèces comptées dans le tiroir (€) :",
+                                            session.soldeTheorique, 0.0, 1000000.0, 2, &ok);
+    if (!ok) {
+        return;
+    }
+
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this,
+        "Confirmation",
+        QString("Clôturer la session n°%1 ? Aucun mouvement ne pourra plus y être ajouté.").arg(session.id),
+        QMessageBox::Yes | QMessageBox::No
+    );
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+
+    // Rapport Z : totaux définitifs de la session clôturée, relus dans le même job
+    const int sessionId = session.id;
+    const int userId = currentUserId;
+    runAction([sessionId, userId, compte](QSqlDatabase &db) {
+        CashAction action;
+        action.ok = CashRepository::closeSession(sessionId, userId, compte, db);
+        action.error = CashRepository::lastError();
+        if (action.ok) {
+            CashRepository::find(sessionId, action.session, db);
+        }
+        return action;
+    }, "Erreur lors de la clôture: ", "Rapport Z", true);
+}
+
+void CashPage::runAction(std::function<CashAction(QSqlDatabase &)> job, const QString &errorContext,
+                         const QString &reportTitle, bool closing)
+{
+    // Pas de seconde action tant que celle-ci n'est pas revenue
+    for (QPushButton *button : {openBtn, cashInBtn, cashOutBtn, xReportBtn, closeBtn}) {
+        button->setEnabled(false);
+    }
+
+    DatabaseService::instance().run<CashAction>(job).then(this,
+        [this, errorContext, reportTitle, closing](const CashAction &action) {
+            if (!action.ok) {
+                QMessageBox::critical(this, "Erreur", errorContext + action.error);
+            } else if (!reportTitle.isEmpty() && action.session.id >= 0) {
+                QMessageBox::information(this, reportTitle, reportText(action.session, closing));
+            }
+            loadSession();
+        });
+}
+
+QString CashPage::reportText(const CashSession &report, bool closing) const
+{
+    QStringList lines;
+    lines << QString("Session n°%1").arg(report.id)
+          << QString("Ouverture : %1").arg(report.openedAt.toString("dd/MM/yyyy hh:mm"));
+    if (closing) {
+        lines << QString("Clôture : %1").arg(report.closedAt.toString("dd/MM/yyyy hh:mm"));
+    }
+    lines << ""
+          << QString("Fond de caisse : %1").arg(formatAmount(report.fondInitial))
+          << QString("Ventes : %1 (%2)").arg(formatAmount(report.totalVentes)).arg(report.nbVentes)
+          << QString("Annulations : %1 (%2)").arg(formatAmount(report.totalAnnulations)).arg(report.nbAnnulations)
+          << QString("Entrées d'espèces : %1").arg(formatAmount(report.totalEntrees))
+          << QString("Sorties d'espèces : %1").arg(formatAmount(report.totalSorties))
+          << QString("Solde théorique : %1").arg(formatAmount(report.soldeTheorique));
+    if (closing) {
+        lines << QString("Espèces comptées : %1").arg(formatAmount(report.montantCompte))
+              << QString("Écart : %1").arg(formatAmount(report.ecart()));
+    }
+    return lines.join('\n');
+}
+
+QString CashPage::formatAmount(double amount)
+{
+    return QLocale(QLocale::French).toString(amount, 'f', 2) + " €";
+}
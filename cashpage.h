@@ -2,13 +2,84 @@
 #define CASHPAGE_H
 
 #include <QFrame>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QFuture>
+#include <QSqlDatabase>
+#include <functional>
+#include "cashrepository.h"
+
+// Session en cours et ses derniers mouvements, lus sur le thread base de données
+struct CashSnapshot
+{
+    bool ok = false;
+    QString error;
+    bool hasSession = false;
+    int pendingPayments = 0;     // paiements hors session, reportés à l'ouverture
+    CashSession session;
+    QVector<CashMovement> movements;
+};
+
+// Ouverture, mouvement, rapport ou clôture exécuté sur le thread base de
+// données ; session est la session relue pour les rapports X et Z
+struct CashAction
+{
+    bool ok = false;
+    QString error;
+    CashSession session;
+};
 
 class CashPage : public QFrame
 {
     Q_OBJECT
 
 public:
-    explicit CashPage(QWidget *parent = nullptr);
+    explicit CashPage(int userId, QWidget *parent = nullptr);
+
+    static QString styleRules();
+
+public slots:
+    void loadSession();
+
+private slots:
+    void onOpenSession();
+    void onCashIn();
+    void onCashOut();
+    void onXReport();
+    void onCloseSession();
+
+private:
+    void setupUI();
+    void displaySnapshot(const CashSnapshot &snapshot);
+    void addMovement(const QString &type, const QString &title);
+    void runAction(std::function<CashAction(QSqlDatabase &)> job, const QString &errorContext,
+                   const QString &reportTitle = QString(), bool closing = false);
+    QPushButton *createButton(const QString &text, const QString &variant);
+    QString reportText(const CashSession &session, bool closing) const;
+
+    static QString formatAmount(double amount);
+
+    int currentUserId;
+    CashSession session;
+    bool hasSession;
+
+    QLabel *statusLabel;
+    QLabel *fondLabel;
+    QLabel *ventesLabel;
+    QLabel *annulationsLabel;
+    QLabel *entreesLabel;
+    QLabel *sortiesLabel;
+    QLabel *soldeLabel;
+    QPushButton *openBtn;
+    QPushButton *cashInBtn;
+    QPushButton *cashOutBtn;
+    QPushButton *xReportBtn;
+    QPushButton *closeBtn;
+    QTableWidget *ledgerTable;
+
+    QFuture<CashSnapshot> pendingLoad;
+    int loadGeneration;
 };
 
-#endif // CASHPAGE_H
\ No newline at end of file
+#endif // CASHPAGE_H
@@ -0,0 +1,308 @@
+#include "cashrepository.h"
+#include "repositoryerror.h"
+#include <QSqlError>
+#include <QStringList>
+#include <QDebug>
+
+namespace {
+thread_local RepositoryError repositoryError;
+
+const QString SessionColumns =
+    "SELECT id_session, id_user_ouverture, date_ouverture, fond_initial, statut, solde_theorique, "
+    "nb_ventes, total_ventes, nb_annulations, total_annulations, total_entrees, total_sorties, "
+    "id_user_cloture, date_cloture, montant_compte FROM CASH_SESSIONS ";
+
+// Report d'un paiement dans la session ouverte ; sans session ouverte, il
+// attend dans CASH_PENDING (reporté par openSession)
+QString ledgerFromPayment(const QString &type, const QString &montant, const QString &row,
+                          const QString &libelle)
+{
+    return QString("INSERT INTO CASH_LEDGER (id_session, type, montant, id_paiement, libelle) "
+                   "SELECT id_session, '%1', %2, %3.id_paiement, '%4' || %3.id_commande "
+                   "FROM CASH_SESSIONS WHERE statut = 'OUVERTE'; "
+                   "INSERT INTO CASH_PENDING (type, montant, id_paiement, libelle) "
+                   "SELECT '%1', %2, %3.id_paiement, '%4' || %3.id_commande "
+                   "WHERE NOT EXISTS (SELECT 1 FROM CASH_SESSIONS WHERE statut = 'OUVERTE'); ")
+        .arg(type, montant, row, libelle);
+}
+}
+
+CashRepository::CashRepository() {}
+
+QString CashRepository::lastError()
+{
+    return repositoryError.text();
+}
+
+QStringList CashRepository::createStatements()
+{
+    return {
+        "CREATE TABLE IF NOT EXISTS CASH_SESSIONS ("
+        "id_session INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "id_user_ouverture INTEGER NOT NULL, "
+        "date_ouverture DATETIME DEFAULT CURRENT_TIMESTAMP, "
+        "fond_initial REAL NOT NULL DEFAULT 0, "
+        "statut TEXT NOT NULL DEFAULT 'OUVERTE' CHECK(statut IN ('OUVERTE', 'CLOTUREE')), "
+        "solde_theorique REAL NOT NULL DEFAULT 0, "
+        "nb_ventes INTEGER NOT NULL DEFAULT 0, "
+        "total_ventes REAL NOT NULL DEFAULT 0, "
+        "nb_annulations INTEGER NOT NULL DEFAULT 0, "
+        "total_annulations REAL NOT NULL DEFAULT 0, "
+        "total_entrees REAL NOT NULL DEFAULT 0, "
+        "total_sorties REAL NOT NULL DEFAULT 0, "
+        "id_user_cloture INTEGER, "
+        "date_cloture DATETIME, "
+        "montant_compte REAL, "
+        "FOREIGN KEY(id_user_ouverture) REFERENCES USERS(id_user))",
+
+        // Au plus une session ouverte, retrouvée par cet index
+        "CREATE UNIQUE INDEX IF NOT EXISTS idx_cash_sessions_ouverte ON CASH_SESSIONS(statut) "
+        "WHERE statut = 'OUVERTE'",
+
+        "CREATE TABLE IF NOT EXISTS CASH_LEDGER ("
+        "id_mouvement INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "id_session INTEGER NOT NULL, "
+        "date_mouvement DATETIME DEFAULT CURRENT_TIMESTAMP, "
+        "type TEXT NOT NULL CHECK(type IN ('OUVERTURE', 'VENTE', 'ANNULATION', 'ENTREE', 'SORTIE')), "
+        "montant REAL NOT NULL, "
+        "id_paiement INTEGER, "
+        "libelle TEXT, "
+        "FOREIGN KEY(id_session) REFERENCES CASH_SESSIONS(id_session))",
+
+        "CREATE INDEX IF NOT EXISTS idx_cash_ledger_session ON CASH_LEDGER(id_session, id_mouvement)",
+
+        // Ventes et annulations faites caisse fermée, en attente de session
+        "CREATE TABLE IF NOT EXISTS CASH_PENDING ("
+        "id_attente INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "date_mouvement DATETIME DEFAULT CURRENT_TIMESTAMP, "
+        "type TEXT NOT NULL CHECK(type IN ('VENTE', 'ANNULATION')), "
+        "montant REAL NOT NULL, "
+        "id_paiement INTEGER, "
+        "libelle TEXT)",
+
+        "CREATE TRIGGER CASH_LEDGER_BI BEFORE INSERT ON CASH_LEDGER "
+        "WHEN (SELECT statut FROM CASH_SESSIONS WHERE id_session = NEW.id_session) IS NOT 'OUVERTE' BEGIN "
+        "SELECT RAISE(ABORT, 'La session de caisse est clôturée'); END",
+
+        "CREATE TRIGGER CASH_LEDGER_BU BEFORE UPDATE ON CASH_LEDGER BEGIN "
+        "SELECT RAISE(ABORT, 'Le journal de caisse ne peut pas être modifié'); END",
+
+        "CREATE TRIGGER CASH_LEDGER_BD BEFORE DELETE ON CASH_LEDGER BEGIN "
+        "SELECT RAISE(ABORT, 'Le journal de caisse ne peut pas être modifié'); END",
+
+        // Totaux de la session tenus à jour mouvement par mouvement
+        "CREATE TRIGGER CASH_LEDGER_AI AFTER INSERT ON CASH_LEDGER BEGIN "
+        "UPDATE CASH_SESSIONS SET "
+        "solde_theorique = solde_theorique + NEW.montant, "
+        "nb_ventes = nb_ventes + (NEW.type = 'VENTE'), "
+        "total_ventes = total_ventes + CASE WHEN NEW.type = 'VENTE' THEN NEW.montant ELSE 0 END, "
+        "nb_annulations = nb_annulations + (NEW.type = 'ANNULATION'), "
+        "total_annulations = total_annulations - CASE WHEN NEW.type = 'ANNULATION' THEN NEW.montant ELSE 0 END, "
+        "total_entrees = total_entrees + CASE WHEN NEW.type = 'ENTREE' THEN NEW.montant ELSE 0 END, "
+        "total_sorties = total_sorties - CASE WHEN NEW.type = 'SORTIE' THEN NEW.montant ELSE 0 END "
+        "WHERE id_session = NEW.id_session; END",
+
+        "CREATE TRIGGER CASH_LEDGER_PAIEMENT_AI AFTER INSERT ON PAIEMENTS "
+        "WHEN NEW.statut = 'VALIDE' BEGIN "
+        + ledgerFromPayment("VENTE", "NEW.montant", "NEW", "Commande #") + "END",
+
+        "CREATE TRIGGER CASH_LEDGER_PAIEMENT_AU AFTER UPDATE OF statut ON PAIEMENTS "
+        "WHEN OLD.statut = 'VALIDE' AND NEW.statut = 'ANNULE' BEGIN "
+        + ledgerFromPayment("ANNULATION", "-OLD.montant", "OLD", "Annulation commande #") + "END"
+    };
+}
+
+bool CashRepository::readSession(const QString &sql, const QVariant &bindValue, CashSession &session,
+                                 const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, sql);
+    if (!query) {
+        return false;
+    }
+    if (bindValue.isValid()) {
+        query->bindValue(0, bindValue);
+    }
+    if (!repositoryError.exec(*query)) {
+        return false;
+    }
+    if (!query->next()) {
+        query->finish();
+        return false;
+    }
+
+    session.id = query->value(0).toInt();
+    session.openedBy = query->value(1).toInt();
+    session.openedAt = query->value(2).toDateTime();
+    session.fondInitial = query->value(3).toDouble();
+    session.statut = query->value(4).toString();
+    session.soldeTheorique = query->value(5).toDouble();
+    session.nbVentes = query->value(6).toInt();
+    session.totalVentes = query->value(7).toDouble();
+    session.nbAnnulations = query->value(8).toInt();
+    session.totalAnnulations = query->value(9).toDouble();
+    session.totalEntrees = query->value(10).toDouble();
+    session.totalSorties = query->value(11).toDouble();
+    session.closedBy = query->value(12).isNull() ? -1 : query->value(12).toInt();
+    session.closedAt = query->value(13).toDateTime();
+    session.montantCompte = query->value(14).toDouble();
+    query->finish();
+    return true;
+}
+
+QString CashRepository::currentSessionSql()
+{
+    return SessionColumns + "WHERE statut = 'OUVERTE'";
+}
+
+QString CashRepository::movementsSql()
+{
+    return "SELECT id_mouvement, date_mouvement, type, montant, libelle FROM CASH_LEDGER "
+           "WHERE id_session = ? ORDER BY id_mouvement DESC LIMIT ?";
+}
+
+bool CashRepository::currentSession(CashSession &session, const QSqlDatabase &db)
+{
+    return readSession(currentSessionSql(), QVariant(), session, db);
+}
+
+bool CashRepository::find(int sessionId, CashSession &session, const QSqlDatabase &db)
+{
+    return readSession(SessionColumns + "WHERE id_session = ?", sessionId, session, db);
+}
+
+int CashRepository::openSession(int userId, double fondInitial, QSqlDatabase db)
+{
+    if (!db.transaction()) {
+        repositoryError.set(db.lastError().text());
+        return -1;
+    }
+
+    QSqlQuery *sessionQuery = repositoryError.prepare(db,
+        "INSERT INTO CASH_SESSIONS (id_user_ouverture, fond_initial) VALUES (?, ?)");
+    if (!sessionQuery) {
+        db.rollback();
+        return -1;
+    }
+    sessionQuery->bindValue(0, userId);
+    sessionQuery->bindValue(1, fondInitial);
+    if (!repositoryError.exec(*sessionQuery)) {
+        db.rollback();
+        return -1;
+    }
+    int sessionId = sessionQuery->lastInsertId().toInt();
+
+    // Le fond de caisse est le premier mouvement du journal, suivi des
+    // paiements faits caisse fermée
+    QSqlQuery *ledgerQuery = repositoryError.prepare(db,
+        "INSERT INTO CASH_LEDGER (id_session, type, montant, libelle) VALUES (?, 'OUVERTURE', ?, 'Fond de caisse')");
+    if (!ledgerQuery) {
+        db.rollback();
+        return -1;
+    }
+    ledgerQuery->bindValue(0, sessionId);
+    ledgerQuery->bindValue(1, fondInitial);
+    if (!repositoryError.exec(*ledgerQuery)) {
+        db.rollback();
+        return -1;
+    }
+
+    QSqlQuery *pendingQuery = repositoryError.prepare(db,
+        "INSERT INTO CASH_LEDGER (id_session, date_mouvement, type, montant, id_paiement, libelle) "
+        "SELECT ?, date_mouvement, type, montant, id_paiement, 'Hors session : ' || libelle "
+        "FROM CASH_PENDING ORDER BY id_attente");
+    if (!pendingQuery) {
+        db.rollback();
+        return -1;
+    }
+    pendingQuery->bindValue(0, sessionId);
+    if (!repositoryError.exec(*pendingQuery)) {
+        db.rollback();
+        return -1;
+    }
+
+    QSqlQuery *clearQuery = repositoryError.prepare(db, "DELETE FROM CASH_PENDING");
+    if (!clearQuery || !repositoryError.exec(*clearQuery)) {
+        db.rollback();
+        return -1;
+    }
+
+    if (!db.commit()) {
+        repositoryError.set(db.lastError().text());
+        db.rollback();
+        return -1;
+    }
+    return sessionId;
+}
+
+int CashRepository::pendingCount(const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, "SELECT COUNT(*) FROM CASH_PENDING");
+    if (!query || !repositoryError.exec(*query) || !query->next()) {
+        return -1;
+    }
+    int count = query->value(0).toInt();
+    query->finish();
+    return count;
+}
+
+bool CashRepository::addMovement(int sessionId, const QString &type, double montant, const QString &libelle,
+                                 const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "INSERT INTO CASH_LEDGER (id_session, type, montant, libelle) VALUES (?, ?, ?, ?)");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, sessionId);
+    query->bindValue(1, type);
+    query->bindValue(2, type == "SORTIE" ? -montant : montant);
+    query->bindValue(3, libelle);
+    return repositoryError.exec(*query);
+}
+
+bool CashRepository::closeSession(int sessionId, int userId, double montantCompte, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "UPDATE CASH_SESSIONS SET statut = 'CLOTUREE', date_cloture = CURRENT_TIMESTAMP, "
+        "id_user_cloture = ?, montant_compte = ? WHERE id_session = ? AND statut = 'OUVERTE'");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, userId);
+    query->bindValue(1, montantCompte);
+    query->bindValue(2, sessionId);
+    if (!repositoryError.exec(*query)) {
+        return false;
+    }
+    if (query->numRowsAffected() != 1) {
+        repositoryError.set("La session de caisse est déjà clôturée.");
+        return false;
+    }
+    return true;
+}
+
+QVector<CashMovement> CashRepository::movements(int sessionId, int limit, const QSqlDatabase &db)
+{
+    QVector<CashMovement> movements;
+    QSqlQuery *query = repositoryError.prepare(db, movementsSql());
+    if (!query) {
+        return movements;
+    }
+    query->bindValue(0, sessionId);
+    query->bindValue(1, limit);
+    if (!repositoryError.exec(*query)) {
+        return movements;
+    }
+
+    while (query->next()) {
+        CashMovement movement;
+        movement.id = query->value(0).toInt();
+        movement.date = query->value(1).toDateTime();
+        movement.type = query->value(2).toString();
+        movement.montant = query->value(3).toDouble();
+        movement.libelle = query->value(4).toString();
+        movements.append(movement);
+    }
+    query->finish();
+    return movements;
+}
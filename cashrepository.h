@@ -0,0 +1,88 @@
+#ifndef CASHREPOSITORY_H
+#define CASHREPOSITORY_H
+
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Session de caisse (ouverture -> clôture). Les totaux sont tenus à jour par
+// trigger à chaque mouvement du journal : les rapports X et Z les lisent
+// directement, sans parcourir les paiements.
+struct CashSession {
+    int id = -1;
+    int openedBy = -1;
+    QDateTime openedAt;
+    double fondInitial = 0.0;
+    QString statut;              // OUVERTE ou CLOTUREE
+    double soldeTheorique = 0.0;
+    int nbVentes = 0;
+    double totalVentes = 0.0;
+    int nbAnnulations = 0;
+    double totalAnnulations = 0.0;
+    double totalEntrees = 0.0;
+    double totalSorties = 0.0;
+    int closedBy = -1;
+    QDateTime closedAt;
+    double montantCompte = 0.0;  // espèces comptées à la clôture
+
+    bool isOpen() const { return statut == "OUVERTE"; }
+    double ecart() const { return montantCompte - soldeTheorique; }
+};
+
+struct CashMovement {
+    int id = -1;
+    QDateTime date;
+    QString type;                // OUVERTURE, VENTE, ANNULATION, ENTREE, SORTIE
+    double montant = 0.0;        // signé : négatif pour une sortie de caisse
+    QString libelle;
+};
+
+// Tables CASH_SESSIONS / CASH_LEDGER. Le journal est en ajout seul
+// (modification et suppression refusées par trigger) ; les paiements validés
+// et annulés y sont reportés par trigger dans la session ouverte. Sans
+// session ouverte, ils attendent dans CASH_PENDING et sont reportés dans la
+// prochaine session, juste après son fond de caisse. Une seule session peut
+// être ouverte à la fois.
+class CashRepository
+{
+public:
+    CashRepository();
+
+    // Tables, index et triggers (migration du schéma)
+    static QStringList createStatements();
+
+    // Session ouverte ; false s'il n'y en a pas (lastError() vide) ou en cas d'erreur
+    static bool currentSession(CashSession &session, const QSqlDatabase &db = QSqlDatabase::database());
+    static bool find(int sessionId, CashSession &session, const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Nouvelle session avec son fond de caisse ; -1 en cas d'erreur
+    static int openSession(int userId, double fondInitial, QSqlDatabase db = QSqlDatabase::database());
+    // Paiements encaissés ou annulés hors session, en attente de report
+    static int pendingCount(const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Entrée (ENTREE) ou sortie (SORTIE) d'espèces ; montant positif
+    static bool addMovement(int sessionId, const QString &type, double montant, const QString &libelle,
+                            const QSqlDatabase &db = QSqlDatabase::database());
+
+    static bool closeSession(int sessionId, int userId, double montantCompte,
+                             const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Derniers mouvements d'une session, du plus récent au plus ancien
+    static QVector<CashMovement> movements(int sessionId, int limit,
+                                           const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Requêtes de currentSession() et movements(), vérifiées par QueryPlanCheck
+    static QString currentSessionSql();
+    static QString movementsSql();
+
+    static QString lastError();
+
+private:
+    static bool readSession(const QString &sql, const QVariant &bindValue, CashSession &session,
+                            const QSqlDatabase &db);
+};
+
+#endif // CASHREPOSITORY_H
@@ -1,4 +1,6 @@
 #include "clientdialog.h"
+#include "clientrepository.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QLabel>
@@ -9,6 +11,7 @@
 ClientDialog::ClientDialog(QWidget *parent, int clientId)
     : QDialog(parent), currentClientId(clientId)
 {
+    UiProfiler::Scope scope("ClientDialog::ClientDialog");
     setupUI();
     if (clientId != -1) {
         loadClient(clientId);
@@ -20,6 +23,7 @@ void ClientDialog::setupUI()
     setWindowTitle(currentClientId == -1 ? "Ajouter un client" : "Modifier le client");
     setMinimumWidth(500);
     setModal(true);
+    setObjectName("clientDialog");
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setSpacing(20);
@@ -27,7 +31,7 @@ void ClientDialog::setupUI()
 
     // Titre
     QLabel *title = new QLabel(currentClientId == -1 ? "➕ Nouveau Client" : "✏️ Modifier le Client", this);
-    title->setStyleSheet("font-size: 20px; font-weight: bold;");
+    title->setObjectName("dialogTitle");
     mainLayout->addWidget(title);
 
     // Formulaire
@@ -81,18 +85,25 @@ void ClientDialog::setupUI()
     mainLayout->addLayout(buttonLayout);
 }
 
+QString ClientDialog::styleRules()
+{
+    return QString(
+        "#clientDialog QLabel#dialogTitle {"
+        "   font-size: 20px;"
+        "   font-weight: bold;"
+        "}"
+    );
+}
+
 void ClientDialog::loadClient(int clientId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT nom, prenom, telephone, email, adresse FROM CLIENTS WHERE id_client = :id");
-    query.bindValue(":id", clientId);
-    
-    if (query.exec() && query.next()) {
-        txtNom->setText(query.value(0).toString());
-        txtPrenom->setText(query.value(1).toString());
-        txtTelephone->setText(query.value(2).toString());
-        txtEmail->setText(query.value(3).toString());
-        txtAdresse->setText(query.value(4).toString());
+    Client client;
+    if (ClientRepository::find(clientId, client)) {
+        txtNom->setText(client.nom);
+        txtPrenom->setText(client.prenom);
+        txtTelephone->setText(client.telephone);
+        txtEmail->setText(client.email);
+        txtAdresse->setText(client.adresse);
     }
 }
 
@@ -126,36 +137,25 @@ void ClientDialog::onSave()
         return;
     }
 
-    QSqlQuery query;
-    
-    if (currentClientId == -1) {
-        // Insertion
-        query.prepare("INSERT INTO CLIENTS (nom, prenom, telephone, email, adresse) "
-                     "VALUES (:nom, :prenom, :telephone, :email, :adresse)");
-        query.bindValue(":nom", txtNom->text().trimmed());
-        query.bindValue(":prenom", txtPrenom->text().trimmed());
-        query.bindValue(":telephone", txtTelephone->text().trimmed());
-        query.bindValue(":email", txtEmail->text().trimmed());
-        query.bindValue(":adresse", txtAdresse->text().trimmed());
-    } else {
-        // Mise à jour
-        query.prepare("UPDATE CLIENTS SET nom = :nom, prenom = :prenom, telephone = :telephone, "
-                     "email = :email, adresse = :adresse WHERE id_client = :id");
-        query.bindValue(":id", currentClientId);
-        query.bindValue(":nom", txtNom->text().trimmed());
-        query.bindValue(":prenom", txtPrenom->text().trimmed());
-        query.bindValue(":telephone", txtTelephone->text().trimmed());
-        query.bindValue(":email", txtEmail->text().trimmed());
-        query.bindValue(":adresse", txtAdresse->text().trimmed());
-    }
+    Client client;
+    client.id = currentClientId;
+    client.nom = txtNom->text().trimmed();
+    client.prenom = txtPrenom->text().trimmed();
+    client.telephone = txtTelephone->text().trimmed();
+    client.email = txtEmail->text().trimmed();
+    client.adresse = txtAdresse->text().trimmed();
+
+    bool saved = currentClientId == -1
+        ? ClientRepository::insert(client) >= 0
+        : ClientRepository::update(client);
 
-    if (query.exec()) {
+    if (saved) {
         QMessageBox::information(this, "Succès", 
             currentClientId == -1 ? "Client ajouté avec succès!" : "Client modifié avec succès!");
         accept();
     } else {
         QMessageBox::critical(this, "Erreur", 
-            "Erreur lors de l'enregistrement: " + query.lastError().text());
+            "Erreur lors de l'enregistrement: " + ClientRepository::lastError());
     }
 }
 
@@ -13,6 +13,8 @@ class ClientDialog : public QDialog
 public:
     explicit ClientDialog(QWidget *parent = nullptr, int clientId = -1);
 
+    static QString styleRules();
+
 private slots:
     void onSave();
     void onCancel();
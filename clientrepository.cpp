@@ -0,0 +1,82 @@
+#include "clientrepository.h"
+#include "repositoryerror.h"
+
+namespace {
+thread_local RepositoryError repositoryError;
+}
+
+ClientRepository::ClientRepository() {}
+
+QString ClientRepository::lastError()
+{
+    return repositoryError.text();
+}
+
+bool ClientRepository::find(int clientId, Client &client, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "SELECT nom, prenom, telephone, email, adresse FROM CLIENTS WHERE id_client = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, clientId);
+
+    if (!repositoryError.exec(*query) || !query->next()) {
+        query->finish();
+        return false;
+    }
+
+    client.id = clientId;
+    client.nom = query->value(0).toString();
+    client.prenom = query->value(1).toString();
+    client.telephone = query->value(2).toString();
+    client.email = query->value(3).toString();
+    client.adresse = query->value(4).toString();
+    query->finish();
+    return true;
+}
+
+int ClientRepository::insert(const Client &client, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "INSERT INTO CLIENTS (nom, prenom, telephone, email, adresse) VALUES (?, ?, ?, ?, ?)");
+    if (!query) {
+        return -1;
+    }
+    query->bindValue(0, client.nom);
+    query->bindValue(1, client.prenom);
+    query->bindValue(2, client.telephone);
+    query->bindValue(3, client.email);
+    query->bindValue(4, client.adresse);
+
+    if (!repositoryError.exec(*query)) {
+        return -1;
+    }
+    return query->lastInsertId().toInt();
+}
+
+bool ClientRepository::update(const Client &client, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "UPDATE CLIENTS SET nom = ?, prenom = ?, telephone = ?, email = ?, adresse = ? WHERE id_client = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, client.nom);
+    query->bindValue(1, client.prenom);
+    query->bindValue(2, client.telephone);
+    query->bindValue(3, client.email);
+    query->bindValue(4, client.adresse);
+    query->bindValue(5, client.id);
+    return repositoryError.exec(*query);
+}
+
+bool ClientRepository::remove(int clientId, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, "DELETE FROM CLIENTS WHERE id_client = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, clientId);
+    return repositoryError.exec(*query);
+}
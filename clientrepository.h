@@ -0,0 +1,30 @@
+#ifndef CLIENTREPOSITORY_H
+#define CLIENTREPOSITORY_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+struct Client {
+    int id = -1;
+    QString nom;
+    QString prenom;
+    QString telephone;
+    QString email;
+    QString adresse;
+};
+
+// Accès à CLIENTS par requêtes préparées une fois par connexion (StatementCache)
+class ClientRepository
+{
+public:
+    ClientRepository();
+
+    static bool find(int clientId, Client &client, const QSqlDatabase &db = QSqlDatabase::database());
+    static int insert(const Client &client, const QSqlDatabase &db = QSqlDatabase::database());
+    static bool update(const Client &client, const QSqlDatabase &db = QSqlDatabase::database());
+    static bool remove(int clientId, const QSqlDatabase &db = QSqlDatabase::database());
+
+    static QString lastError();
+};
+
+#endif // CLIENTREPOSITORY_H
@@ -1,5 +1,9 @@
 #include "clientspage.h"
 #include "clientdialog.h"
+#include "clientrepository.h"
+#include "clienttablemodel.h"
+#include "rowactiondelegate.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -9,30 +13,20 @@
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QScrollBar>
-#include "thememanager.h"
-
-ClientsPage::ClientsPage(QWidget *parent) : QFrame(parent), currentPage(0), itemsPerPage(5), totalItems(0)
+#include <algorithm>
+#include "searchindex.h"
+#include "databaseservice.h"
+#include "searchcontroller.h"
+#include "countcache.h"
+
+ClientsPage::ClientsPage(QWidget *parent) : QFrame(parent), currentPage(0), itemsPerPage(20), totalItems(0),
+    pager(listPager(itemsPerPage)), loadGeneration(0)
 {
     setObjectName("clientsPage");
-    setupDatabase();
     setupUI();
-    applyStyles();
     loadClients();
 }
 
-void ClientsPage::setupDatabase()
-{
-    QSqlQuery query;
-    query.exec("CREATE TABLE IF NOT EXISTS CLIENTS ("
-               "id_client INTEGER PRIMARY KEY AUTOINCREMENT, "
-               "nom TEXT NOT NULL, "
-               "prenom TEXT, "
-               "telephone TEXT, "
-               "email TEXT, "
-               "adresse TEXT, "
-               "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP)");
-}
-
 void ClientsPage::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -41,23 +35,10 @@ void ClientsPage::setupUI()
 
     QHBoxLayout *headerLayout = new QHBoxLayout();
     QLabel *icon = new QLabel(this);
-    icon->setStyleSheet(
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "stop:0 #667eea, stop:1 #764ba2);"
-        "border-radius: 12px;"
-        "min-width: 48px; max-width: 48px;"
-        "min-height: 48px; max-height: 48px;"
-    );
+    icon->setObjectName("pageIcon");
     
     QLabel *title = new QLabel("Gestion des Clients", this);
     title->setObjectName("titleH1");
-    ThemeManager& theme = ThemeManager::instance();
-    title->setStyleSheet(QString(
-        "font-size: 32px;"
-        "font-weight: 700;"
-        "color: %1;"
-        "letter-spacing: -0.5px;").arg(theme.textColor().name())
-    );
     
     headerLayout->addWidget(icon);
     headerLayout->addWidget(title);
@@ -70,7 +51,8 @@ void ClientsPage::setupUI()
     searchInput = new QLineEdit(this);
     searchInput->setPlaceholderText("Rechercher par nom ou email...");
     searchInput->setMinimumHeight(48);
-    connect(searchInput, &QLineEdit::textChanged, this, &ClientsPage::onSearchTextChanged);
+    searchController = new SearchController(searchInput, this);
+    connect(searchController, &SearchController::searchRequested, this, &ClientsPage::onSearchTextChanged);
 
     searchLayout->addWidget(searchInput, 1);
     mainLayout->addLayout(searchLayout);
@@ -94,33 +76,38 @@ void ClientsPage::setupUI()
 
     mainLayout->addLayout(buttonLayout);
 
-    tableWidget = new QTableWidget(this);
-    tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    tableWidget->setAlternatingRowColors(false);
-    tableWidget->verticalHeader()->setVisible(false);
-    tableWidget->horizontalHeader()->setStretchLastSection(true);
-    tableWidget->setShowGrid(false);
-    tableWidget->verticalHeader()->setDefaultSectionSize(60);
-    tableWidget->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    
-    QStringList headers = {"ID", "NOM", "PRÉNOM", "TÉLÉPHONE", "EMAIL", "ADRESSE", "ACTIONS"};
-    tableWidget->setColumnCount(headers.size());
-    tableWidget->setHorizontalHeaderLabels(headers);
-
-    tableWidget->setColumnWidth(0, 60);
-    tableWidget->setColumnWidth(1, 130);
-    tableWidget->setColumnWidth(2, 130);
-    tableWidget->setColumnWidth(3, 130);
-    tableWidget->setColumnWidth(4, 170);
-    tableWidget->setColumnWidth(5, 150);
-    tableWidget->setColumnWidth(6, 150);
-
-    // Définir la hauteur des lignes pour accommoder les boutons
-    tableWidget->verticalHeader()->setDefaultSectionSize(50);
-
-    mainLayout->addWidget(tableWidget);
+    clientsModel = new ClientTableModel(this);
+    rowDelegate = new RowActionDelegate(ClientTableModel::ActionsColumn,
+                                        "Modifier le client", "Supprimer le client", this);
+    connect(rowDelegate, &RowActionDelegate::editRequested, this, &ClientsPage::onEditClient);
+    connect(rowDelegate, &RowActionDelegate::deleteRequested, this, &ClientsPage::onDeleteClient);
+
+    tableView = new QTableView(this);
+    tableView->setModel(clientsModel);
+    tableView->setItemDelegate(rowDelegate);
+    tableView->setMouseTracking(true);
+    tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableView->setAlternatingRowColors(false);
+    tableView->verticalHeader()->setVisible(false);
+    tableView->horizontalHeader()->setStretchLastSection(true);
+    tableView->setShowGrid(false);
+    tableView->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+
+    tableView->setColumnWidth(ClientTableModel::IdColumn, 60);
+    tableView->setColumnWidth(ClientTableModel::NomColumn, 130);
+    tableView->setColumnWidth(ClientTableModel::PrenomColumn, 130);
+    tableView->setColumnWidth(ClientTableModel::TelephoneColumn, 130);
+    tableView->setColumnWidth(ClientTableModel::EmailColumn, 170);
+    tableView->setColumnWidth(ClientTableModel::AdresseColumn, 150);
+    tableView->setColumnWidth(ClientTableModel::ActionsColumn, 150);
+
+    // Hauteur fixe : la vue n'a pas à mesurer chaque ligne
+    tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tableView->verticalHeader()->setDefaultSectionSize(50);
+
+    mainLayout->addWidget(tableView);
 
     QHBoxLayout *paginationLayout = new QHBoxLayout();
     paginationLayout->setSpacing(12);
@@ -128,100 +115,30 @@ void ClientsPage::setupUI()
     btnFirstPage = new QPushButton("|<", this);
     btnFirstPage->setFixedSize(45, 45);
     btnFirstPage->setCursor(Qt::PointingHandCursor);
-    btnFirstPage->setStyleSheet(
-        "QPushButton {"
-        "   background: white;"
-        "   color: #4a5568;"
-        "   border: 2px solid #e2e8f0;"
-        "   border-radius: 10px;"
-        "   font-size: 16px;"
-        "   font-weight: bold;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
-        "   color: white;"
-        "   border-color: transparent;"
-        "}"
-        "QPushButton:disabled {"
-        "   background: #f7fafc;"
-        "   color: #cbd5e0;"
-        "   border-color: #e2e8f0;"
-        "}"
-    );
+    btnFirstPage->setObjectName("paginationButton");
     connect(btnFirstPage, &QPushButton::clicked, this, &ClientsPage::onFirstPage);
     
     btnPrevPage = new QPushButton("<", this);
     btnPrevPage->setFixedSize(45, 45);
     btnPrevPage->setCursor(Qt::PointingHandCursor);
-    btnPrevPage->setStyleSheet(
-        "QPushButton {"
-        "   background: white;"
-        "   color: #4a5568;"
-        "   border: 2px solid #e2e8f0;"
-        "   border-radius: 10px;"
-        "   font-size: 18px;"
-        "   font-weight: bold;"
-        "   padding: 0px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
-        "   color: white;"
-        "   border-color: transparent;"
-        "}"
-        "QPushButton:disabled {"
-        "   background: #f7fafc;"
-        "   color: #cbd5e0;"
-        "   border-color: #e2e8f0;"
-        "}"
-    );
+    btnPrevPage->setObjectName("paginationArrow");
     connect(btnPrevPage, &QPushButton::clicked, this, &ClientsPage::onPreviousPage);
     
     lblPageInfo = new QLabel("Page 1 / 1", this);
     lblPageInfo->setAlignment(Qt::AlignCenter);
     lblPageInfo->setMinimumWidth(150);
-    lblPageInfo->setStyleSheet(
-        "font-size: 14px;"
-        "font-weight: 600;"
-        "color: #4a5568;"
-        "background: white;"
-        "border: 2px solid #e2e8f0;"
-        "border-radius: 10px;"
-        "padding: 10px 20px;"
-    );
+    lblPageInfo->setObjectName("pageInfo");
     
     btnNextPage = new QPushButton(">", this);
     btnNextPage->setFixedSize(45, 45);
     btnNextPage->setCursor(Qt::PointingHandCursor);
-    btnNextPage->setStyleSheet(
-        "QPushButton {"
-        "   background: white;"
-        "   color: #4a5568;"
-        "   border: 2px solid #e2e8f0;"
-        "   border-radius: 10px;"
-        "   font-size: 18px;"
-        "   font-weight: bold;"
-        "   padding: 0px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
-        "   color: white;"
-        "   border-color: transparent;"
-        "}"
-        "QPushButton:disabled {"
-        "   background: #f7fafc;"
-        "   color: #cbd5e0;"
-        "   border-color: #e2e8f0;"
-        "}"
-    );
+    btnNextPage->setObjectName("paginationArrow");
     connect(btnNextPage, &QPushButton::clicked, this, &ClientsPage::onNextPage);
     
     btnLastPage = new QPushButton(">|", this);
     btnLastPage->setFixedSize(45, 45);
     btnLastPage->setCursor(Qt::PointingHandCursor);
-    btnLastPage->setStyleSheet(btnFirstPage->styleSheet());
+    btnLastPage->setObjectName("paginationButton");
     connect(btnLastPage, &QPushButton::clicked, this, &ClientsPage::onLastPage);
     
     paginationLayout->addStretch();
@@ -235,173 +152,217 @@ void ClientsPage::setupUI()
     mainLayout->addLayout(paginationLayout);
 }
 
-void ClientsPage::applyStyles()
+QString ClientsPage::styleRules()
 {
-    // Mode sombre forcé
-    setStyleSheet(QString(
-        "#clientsPage {"
-        "   background: %1;"
-        "}"
-        "QTableWidget {"
-        "   background: %1;"
-        "   color: #e2e8f0;"
-        "   gridline-color: #334155;"
+    return QString(
+        "#clientsPage QLabel#pageIcon {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
+        "   border-radius: 12px;"
+        "   min-width: 48px;"
+        "   max-width: 48px;"
+        "   min-height: 48px;"
+        "   max-height: 48px;"
         "}"
-        "QTableWidget::item {"
-        "   color: #f1f5f9;"
-        "   padding: 8px;"
+        "#clientsPage QLabel#titleH1 {"
+        "   font-size: 32px;"
+        "   font-weight: 700;"
+        "   color: palette(window-text);"
+        "   letter-spacing: -0.5px;"
         "}"
-        "QHeaderView::section {"
-        "   background: #1e293b;"
-        "   color: #e2e8f0;"
-        "   padding: 8px;"
-        "   border: none;"
-        "   border-right: 1px solid #334155;"
+        "#clientsPage QPushButton#paginationButton {"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   font-size: 16px;"
         "   font-weight: bold;"
         "}"
-    ).arg(ThemeManager::instance().backgroundColor().name()));
-}
-
-QWidget* ClientsPage::createActionButtons(int clientId)
-{
-    QWidget *actionWidget = new QWidget();
-    QHBoxLayout *actionLayout = new QHBoxLayout(actionWidget);
-    actionLayout->setContentsMargins(2, 2, 2, 2);
-    actionLayout->setSpacing(4);
-    actionLayout->setAlignment(Qt::AlignCenter);
-
-    QPushButton *editBtn = new QPushButton("✏️", this);
-    editBtn->setFixedSize(22, 22);
-    editBtn->setCursor(Qt::PointingHandCursor);
-    editBtn->setToolTip("Modifier le client");
-    editBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
+        "#clientsPage QPushButton#paginationButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
         "   color: white;"
-        "   border: none;"
-        "   border-radius: 4px;"
-        "   font-size: 11px;"
+        "   border-color: transparent;"
+        "}"
+        "#clientsPage QPushButton#paginationButton:disabled {"
+        "   background: palette(alternate-base);"
+        "   color: palette(placeholder-text);"
+        "   border-color: palette(mid);"
+        "}"
+        "#clientsPage QPushButton#paginationArrow {"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   font-size: 18px;"
         "   font-weight: bold;"
         "   padding: 0px;"
         "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #5568d3, stop:1 #6a3a8a);"
+        "#clientsPage QPushButton#paginationArrow:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
+        "   color: white;"
+        "   border-color: transparent;"
         "}"
-        "QPushButton:pressed {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #4556b8, stop:1 #5a2a7a);"
+        "#clientsPage QPushButton#paginationArrow:disabled {"
+        "   background: palette(alternate-base);"
+        "   color: palette(placeholder-text);"
+        "   border-color: palette(mid);"
         "}"
-    );
-    connect(editBtn, &QPushButton::clicked, this, [this, clientId]() { onEditClient(clientId); });
-
-    QPushButton *deleteBtn = new QPushButton("🗑️", this);
-    deleteBtn->setFixedSize(22, 22);
-    deleteBtn->setCursor(Qt::PointingHandCursor);
-    deleteBtn->setToolTip("Supprimer le client");
-    deleteBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #f56565, stop:1 #e53e3e);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 4px;"
-        "   font-size: 11px;"
-        "   font-weight: bold;"
-        "   padding: 0px;"
+        "#clientsPage QLabel#pageInfo {"
+        "   font-size: 14px;"
+        "   font-weight: 600;"
+        "   color: palette(text);"
+        "   background: palette(base);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   padding: 10px 20px;"
         "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #e53e3e, stop:1 #c53030);"
+        "#clientsPage {"
+        "   background: palette(window);"
+        "}"
+        "#clientsPage QTableView {"
+        "   background: palette(window);"
+        "   color: palette(text);"
+        "   gridline-color: palette(mid);"
+        "}"
+        "#clientsPage QTableView::item {"
+        "   color: palette(text);"
+        "   padding: 8px;"
         "}"
-        "QPushButton:pressed {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #c53030, stop:1 #742a2a);"
+        "#clientsPage QHeaderView::section {"
+        "   background: palette(button);"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "   border: none;"
+        "   border-right: 1px solid palette(mid);"
+        "   font-weight: bold;"
         "}"
     );
-    connect(deleteBtn, &QPushButton::clicked, this, [this, clientId]() { onDeleteClient(clientId); });
+}
 
-    actionLayout->addWidget(editBtn);
-    actionLayout->addWidget(deleteBtn);
+KeysetPager ClientsPage::listPager(int pageSize)
+{
+    return KeysetPager("c.date_creation", "c.id_client", pageSize);
+}
 
-    return actionWidget;
+QString ClientsPage::listSource(const QString &match)
+{
+    if (match.isEmpty()) {
+        return "CLIENTS c";
+    }
+    return "CLIENTS c JOIN (SELECT rowid AS id, rank AS score FROM CLIENTS_FTS "
+           "WHERE CLIENTS_FTS MATCH ?) s ON s.id = c.id_client";
 }
 
-void ClientsPage::loadClients()
+QString ClientsPage::listSql(const QString &source, const QString &filter, const KeysetPager &pager, int page)
 {
-    QSqlQuery countQuery;
-    QString filter = "1=1";
+    return QString("SELECT c.id_client, c.nom, c.prenom, c.telephone, c.email, c.adresse, c.date_creation "
+                   "FROM %1 WHERE %2 AND %3 %4 %5")
+        .arg(source, filter, pager.seekCondition(page), pager.orderClause(page), pager.limitClause(page));
+}
 
-    QString searchText = searchInput->text();
-    if (!searchText.isEmpty()) {
-        filter += QString(" AND (nom LIKE '%%1%' OR prenom LIKE '%%1%' OR email LIKE '%%1%')").arg(searchText);
-    }
+void ClientsPage::loadClients()
+{
+    UiProfiler::Scope scope("ClientsPage::loadClients");
+    // Recherche plein texte (classée par bm25) si l'index FTS5 est disponible
+    QString searchText = searchController->term();
+    QString match = SearchIndex::isAvailable() ? SearchIndex::matchExpression(searchText) : QString();
+    QString likePattern = "%" + searchText + "%";
 
-    countQuery.prepare(QString("SELECT COUNT(*) FROM CLIENTS WHERE %1").arg(filter));
-    if (countQuery.exec() && countQuery.next()) {
-        totalItems = countQuery.value(0).toInt();
+    QString source = listSource(match);
+    QString filter = "1=1";
+    QString rankedOrder;
+    QVariantList filterValues;
+    if (!match.isEmpty()) {
+        rankedOrder = "s.score, c.date_creation DESC, c.id_client DESC";
+        filterValues << match;
+    } else if (!searchText.isEmpty()) {
+        filter = "(c.nom LIKE ? OR c.prenom LIKE ? OR c.email LIKE ?)";
+        filterValues << likePattern << likePattern << likePattern;
     }
+    pager.setCustomOrder(rankedOrder);
+    pager.setFilterKey(searchText);
+
+    countQuery.table = "CLIENTS";
+    countQuery.filterKey = searchText;
+    countQuery.sql = QString("SELECT COUNT(*) FROM %1 WHERE %2").arg(source, filter);
+    countQuery.bindValues = filterValues;
+
+    QString pageSql = listSql(source, filter, pager, currentPage);
+    QVariantList pageValues = filterValues + pager.pageBindValues(currentPage);
+
+    // La requête part sur le thread base de données ; une recherche plus
+    // récente annule celle-ci si elle n'a pas encore démarré.
+    int page = currentPage;
+    bool reversed = pager.isReversed(page);
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    searchController->forgetResult();
+    // Une seule lecture par page : le total vient des compteurs ou du cache,
+    // il n'est recalculé que pour aller à la dernière page
+    const CountQuery count = countQuery;
+    const int pageSize = pager.pageSize();
+    pendingLoad = DatabaseService::instance().run<QueryResult>(
+        [count, pageSql, pageValues, page, pageSize, reversed](QSqlDatabase &db) {
+            QueryResult result = DatabaseService::select(db, pageSql, pageValues);
+            if (result.ok) {
+                CountCache::resolveTotal(db, count, page, pageSize, reversed, result);
+            }
+            return result;
+        });
+    SearchController::MatchMode mode = matchMode(searchText);
+    pendingLoad.then(this, [this, generation, page, reversed, searchText, mode](const QueryResult &result) {
+        if (generation != loadGeneration) {
+            return;
+        }
+        // Tous les clients trouvés tiennent dans la page : gardés pour filtrer
+        // en mémoire la suite de la saisie
+        if (result.ok && page == 0 && result.rows.size() <= pager.pageSize()) {
+            searchController->rememberResult(searchText, mode, result.rows);
+        }
+        displayClients(result, page, reversed);
+    });
+}
 
-    tableWidget->setRowCount(0);
-
-    QSqlQuery query;
-    int offset = currentPage * itemsPerPage;
-    
-    query.prepare(QString("SELECT id_client, nom, prenom, telephone, email, adresse FROM CLIENTS WHERE %1 ORDER BY date_creation DESC LIMIT %2 OFFSET %3")
-                  .arg(filter).arg(itemsPerPage).arg(offset));
+SearchController::MatchMode ClientsPage::matchMode(const QString &searchText)
+{
+    bool fullText = SearchIndex::isAvailable() && !SearchIndex::matchExpression(searchText).isEmpty();
+    return fullText ? SearchController::PrefixWords : SearchController::Substring;
+}
 
-    if (!query.exec()) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement des clients: " + query.lastError().text());
+void ClientsPage::displayClients(const QueryResult &result, int page, bool reversed)
+{
+    if (!result.ok) {
+        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement des clients: " + result.error);
         return;
     }
+    UiProfiler::Scope scope("ClientsPage::displayClients");
+
+    if (result.dataVersion >= 0) {
+        pager.setDataVersion(result.dataVersion);
+    }
+    totalItems = result.totalRows;
+    pager.setTotalRows(totalItems);
+
+    // Une page lue depuis la fin arrive en ordre croissant : on la retourne.
+    // La ligne lue en plus n'est pas affichée.
+    pager.beginPage(page, reversed, result.rows.size());
+    const int visibleRows = pager.visibleRows(result.rows.size());
+    QVector<Client> clients;
+    clients.reserve(visibleRows);
+    for (int i = 0; i < visibleRows; ++i) {
+        const QSqlRecord &record = result.rows.at(i);
+        pager.collect(record.value(6), record.value(0).toInt());
+        clients.append(ClientTableModel::fromRecord(record));
+    }
+    if (reversed) {
+        std::reverse(clients.begin(), clients.end());
+    }
+    clientsModel->setClients(clients);
+    pager.endPage();
 
-    int row = 0;
-    while (query.next()) {
-        tableWidget->insertRow(row);
-
-        int id = query.value(0).toInt();
-        QString nom = query.value(1).toString();
-        QString prenom = query.value(2).toString();
-        QString telephone = query.value(3).toString();
-        QString email = query.value(4).toString();
-        QString adresse = query.value(5).toString();
-
-        QTableWidgetItem *idItem = new QTableWidgetItem(QString::number(id));
-        idItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        idItem->setForeground(QColor("#718096"));
-        idItem->setFont(QFont("Arial", 13, QFont::Bold));
-        
-        QTableWidgetItem *nomItem = new QTableWidgetItem(nom);
-        nomItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        nomItem->setFont(QFont("Arial", 14, QFont::DemiBold));
-        nomItem->setForeground(QColor("#1a202c"));
-        
-        QTableWidgetItem *prenomItem = new QTableWidgetItem(prenom);
-        prenomItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        prenomItem->setForeground(QColor("#4a5568"));
-
-        QTableWidgetItem *telephoneItem = new QTableWidgetItem(telephone);
-        telephoneItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        telephoneItem->setForeground(QColor("#4a5568"));
-
-        QTableWidgetItem *emailItem = new QTableWidgetItem(email);
-        emailItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        emailItem->setForeground(QColor("#4a5568"));
-
-        QTableWidgetItem *adresseItem = new QTableWidgetItem(adresse);
-        adresseItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        adresseItem->setForeground(QColor("#4a5568"));
-
-        tableWidget->setItem(row, 0, idItem);
-        tableWidget->setItem(row, 1, nomItem);
-        tableWidget->setItem(row, 2, prenomItem);
-        tableWidget->setItem(row, 3, telephoneItem);
-        tableWidget->setItem(row, 4, emailItem);
-        tableWidget->setItem(row, 5, adresseItem);
-        tableWidget->setCellWidget(row, 6, createActionButtons(id));
-
-        row++;
+    // Dernière page atteinte en avançant : le total s'en déduit
+    if (!pager.hasTotalRows() && !pager.hasNextPage()) {
+        totalItems = page * pager.pageSize() + visibleRows;
+        pager.setTotalRows(totalItems);
     }
     
     updatePaginationControls();
@@ -409,18 +370,19 @@ void ClientsPage::loadClients()
 
 void ClientsPage::updatePaginationControls()
 {
-    int totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-    if (totalPages == 0) totalPages = 1;
-    
-    lblPageInfo->setText(QString("Page %1 / %2 (%3 clients)")
-                         .arg(currentPage + 1)
-                         .arg(totalPages)
-                         .arg(totalItems));
+    if (pager.hasTotalRows()) {
+        lblPageInfo->setText(QString("Page %1 / %2 (%3 clients)")
+                             .arg(currentPage + 1)
+                             .arg(pager.pageCount())
+                             .arg(totalItems));
+    } else {
+        lblPageInfo->setText(QString("Page %1").arg(currentPage + 1));
+    }
     
     btnFirstPage->setEnabled(currentPage > 0);
     btnPrevPage->setEnabled(currentPage > 0);
-    btnNextPage->setEnabled(currentPage < totalPages - 1);
-    btnLastPage->setEnabled(currentPage < totalPages - 1);
+    btnNextPage->setEnabled(pager.hasNextPage());
+    btnLastPage->setEnabled(pager.hasNextPage());
 }
 
 void ClientsPage::onFirstPage()
@@ -439,8 +401,7 @@ void ClientsPage::onPreviousPage()
 
 void ClientsPage::onNextPage()
 {
-    int totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-    if (currentPage < totalPages - 1) {
+    if (pager.hasNextPage()) {
         currentPage++;
         loadClients();
     }
@@ -448,10 +409,27 @@ void ClientsPage::onNextPage()
 
 void ClientsPage::onLastPage()
 {
-    int totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-    currentPage = totalPages - 1;
-    if (currentPage < 0) currentPage = 0;
-    loadClients();
+    if (pager.hasTotalRows()) {
+        currentPage = pager.pageCount() - 1;
+        loadClients();
+        return;
+    }
+
+    // Seul cas où le total filtré est compté (puis mémorisé)
+    const CountQuery count = countQuery;
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    DatabaseService::instance().run<int>([count](QSqlDatabase &db) {
+        return CountCache::count(db, count);
+    }).then(this, [this, generation](int total) {
+        if (generation != loadGeneration || total < 0) {
+            return;
+        }
+        totalItems = total;
+        pager.setTotalRows(total);
+        currentPage = pager.pageCount() - 1;
+        loadClients();
+    });
 }
 
 void ClientsPage::onAddClient()
@@ -473,30 +451,25 @@ void ClientsPage::onEditClient(int clientId)
 
 void ClientsPage::onDeleteClient(int clientId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT nom FROM CLIENTS WHERE id_client = :id");
-    query.bindValue(":id", clientId);
-    if (!query.exec() || !query.next()) {
+    Client client;
+    if (!ClientRepository::find(clientId, client)) {
         QMessageBox::critical(this, "Erreur", "Client introuvable.");
         return;
     }
-    QString nom = query.value(0).toString();
 
     QMessageBox::StandardButton reply = QMessageBox::question(
         this, 
         "Confirmation", 
-        QString("Voulez-vous vraiment supprimer le client '%1' ?").arg(nom),
+        QString("Voulez-vous vraiment supprimer le client '%1' ?").arg(client.nom),
         QMessageBox::Yes | QMessageBox::No
     );
 
     if (reply == QMessageBox::Yes) {
-        query.prepare("DELETE FROM CLIENTS WHERE id_client = :id");
-        query.bindValue(":id", clientId);
-        if (query.exec()) {
+        if (ClientRepository::remove(clientId)) {
             QMessageBox::information(this, "Succès", "Client supprimé avec succès.");
             loadClients();
         } else {
-            QMessageBox::critical(this, "Erreur", "Erreur lors de la suppression: " + query.lastError().text());
+            QMessageBox::critical(this, "Erreur", "Erreur lors de la suppression: " + ClientRepository::lastError());
         }
     }
 }
@@ -504,11 +477,27 @@ void ClientsPage::onDeleteClient(int clientId)
 void ClientsPage::onSearchTextChanged(const QString &text)
 {
     currentPage = 0;
-    loadClients();
-}
 
-void ClientsPage::onThemeChanged()
-{
-    applyStyles();
-    loadClients();
+    QVector<QSqlRecord> rows;
+    bool narrowed = searchController->narrowedResult(text, matchMode(text), [](const QSqlRecord &record) {
+        return QStringList{record.value(1).toString(), record.value(2).toString(),
+                           record.value(4).toString()}.join('\n');
+    }, &rows);
+    if (!narrowed) {
+        loadClients();
+        return;
+    }
+
+    // Sous-ensemble du résultat précédent : pas de requête
+    ++loadGeneration;
+    pendingLoad.cancel();
+    pager.setFilterKey(text);
+
+    QueryResult result;
+    result.ok = true;
+    result.rows = rows;
+    result.totalRows = rows.size();
+    searchController->rememberResult(text, matchMode(text), rows);
+    displayClients(result, 0, false);
 }
+
@@ -2,11 +2,19 @@
 #define CLIENTSPAGE_H
 
 #include <QFrame>
-#include <QTableWidget>
+#include <QTableView>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QComboBox>
 #include <QLabel>
+#include <QFuture>
+#include "keysetpager.h"
+#include "databaseservice.h"
+#include "searchcontroller.h"
+#include "countcache.h"
+
+class ClientTableModel;
+class RowActionDelegate;
 
 class ClientsPage : public QFrame
 {
@@ -15,6 +23,14 @@ class ClientsPage : public QFrame
 public:
     explicit ClientsPage(QWidget *parent = nullptr);
 
+    static QString styleRules();
+
+    // Requêtes de la liste, construites ici et vérifiées par QueryPlanCheck.
+    // listSource joint l'index plein texte quand match n'est pas vide.
+    static KeysetPager listPager(int pageSize);
+    static QString listSource(const QString &match);
+    static QString listSql(const QString &source, const QString &filter, const KeysetPager &pager, int page);
+
 private slots:
     void onAddClient();
     void onEditClient(int clientId);
@@ -25,19 +41,18 @@ private slots:
     void onNextPage();
     void onLastPage();
 
-public slots:
-    void onThemeChanged();
-
 private:
     void setupUI();
-    void setupDatabase();
     void loadClients();
-    void applyStyles();
+    void displayClients(const QueryResult &result, int page, bool reversed);
+    static SearchController::MatchMode matchMode(const QString &searchText);
     void updatePaginationControls();
-    QWidget* createActionButtons(int clientId);
     
-    QTableWidget *tableWidget;
+    QTableView *tableView;
+    ClientTableModel *clientsModel;
+    RowActionDelegate *rowDelegate;
     QLineEdit *searchInput;
+    SearchController *searchController;
     QPushButton *btnAdd;
     QPushButton *btnRefresh;
     QPushButton *btnFirstPage;
@@ -49,6 +64,10 @@ private:
     int currentPage;
     int itemsPerPage;
     int totalItems;
+    KeysetPager pager;
+    CountQuery countQuery;
+    QFuture<QueryResult> pendingLoad;
+    int loadGeneration;
 };
 
 #endif // CLIENTSPAGE_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "clienttablemodel.h"
+#include "rowactiondelegate.h"
+#include "thememanager.h"
+#include <QColor>
+#include <QFont>
+
+ClientTableModel::ClientTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int ClientTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_clients.size();
+}
+
+int ClientTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ClientTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_clients.size()) {
+        return QVariant();
+    }
+
+    static const QFont idFont("Arial", 13, QFont::Bold);
+    static const QFont nomFont("Arial", 14, QFont::DemiBold);
+
+    const Client &client = m_clients.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case IdColumn: return QString::number(client.id);
+        case NomColumn: return client.nom;
+        case PrenomColumn: return client.prenom;
+        case TelephoneColumn: return client.telephone;
+        case EmailColumn: return client.email;
+        case AdresseColumn: return client.adresse;
+        default: return QVariant();
+        }
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignLeft | Qt::AlignVCenter);
+    case Qt::FontRole:
+        if (index.column() == IdColumn) {
+            return idFont;
+        }
+        if (index.column() == NomColumn) {
+            return nomFont;
+        }
+        return QVariant();
+    case Qt::ForegroundRole:
+        // Couleurs du thème courant ; le nom garde le texte de la palette
+        if (index.column() == NomColumn) {
+            return QVariant();
+        }
+        return ThemeManager::instance().textSecondaryColor();
+    case RowActionDelegate::RowIdRole:
+        return client.id;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ClientTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case IdColumn: return "ID";
+    case NomColumn: return "NOM";
+    case PrenomColumn: return "PRÉNOM";
+    case TelephoneColumn: return "TÉLÉPHONE";
+    case EmailColumn: return "EMAIL";
+    case AdresseColumn: return "ADRESSE";
+    case ActionsColumn: return "ACTIONS";
+    default: return QVariant();
+    }
+}
+
+void ClientTableModel::setClients(const QVector<Client> &clients)
+{
+    beginResetModel();
+    m_clients = clients;
+    endResetModel();
+}
+
+Client ClientTableModel::fromRecord(const QSqlRecord &record)
+{
+    Client client;
+    client.id = record.value(0).toInt();
+    client.nom = record.value(1).toString();
+    client.prenom = record.value(2).toString();
+    client.telephone = record.value(3).toString();
+    client.email = record.value(4).toString();
+    client.adresse = record.value(5).toString();
+    return client;
+}
@@ -0,0 +1,44 @@
+#ifndef CLIENTTABLEMODEL_H
+#define CLIENTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QSqlRecord>
+#include <QVector>
+#include "clientrepository.h"
+
+// Page courante de la liste des clients. Les lignes sont de simples
+// valeurs : polices et couleurs sont partagées par toutes les cellules,
+// les boutons d'action sont peints par RowActionDelegate.
+class ClientTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        IdColumn,
+        NomColumn,
+        PrenomColumn,
+        TelephoneColumn,
+        EmailColumn,
+        AdresseColumn,
+        ActionsColumn,
+        ColumnCount
+    };
+
+    explicit ClientTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void setClients(const QVector<Client> &clients);
+
+    // Ligne lue par ClientsPage : id, nom, prénom, téléphone, email, adresse
+    static Client fromRecord(const QSqlRecord &record);
+
+private:
+    QVector<Client> m_clients;
+};
+
+#endif // CLIENTTABLEMODEL_H
@@ -1,45 +1,59 @@
 
 #include "connexion.h"
+#include "queryprofiler.h"
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QCryptographicHash>
 #include <QDebug>
+#include "schemamigrator.h"
+#include "searchindex.h"
+
+DatabaseConfig Connexion::databaseConfig;
 
 Connexion::Connexion() {}
 
-bool Connexion::createConnection()
+const DatabaseConfig &Connexion::config()
 {
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName("D:/VenteMaterielInfo.db");
+    return databaseConfig;
+}
+
+bool Connexion::openDatabase(QSqlDatabase &db)
+{
+    databaseConfig.configure(db);
 
     if (!db.open()) {
         qDebug() << "Erreur de connexion à la base de données:" << db.lastError().text();
         return false;
     }
 
-    qDebug() << "Connexion à la base de données réussie ôô";
+    // Une base réseau peut refuser le WAL : on continue, l'écart est journalisé
+    if (!databaseConfig.applyPragmas(db)) {
+        qDebug() << "Attention : la configuration de la base n'a pas pu être entièrement appliquée.";
+    }
+    return true;
+}
 
-    // Créer la table USERS si elle n'existe pas
-    QSqlQuery query;
-    QString createTable = "CREATE TABLE IF NOT EXISTS USERS ("
-                          "id_user INTEGER PRIMARY KEY AUTOINCREMENT,"
-                          "nom TEXT NOT NULL,"
-                          "email TEXT NOT NULL UNIQUE,"
-                          "mot_de_passe TEXT NOT NULL,"
-                          "role TEXT NOT NULL CHECK (role IN ('ADMIN','VENDEUR','CAISSIER')),"
-                          "actif INTEGER DEFAULT 1,"
-                          "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP"
-                          ");";
-    if (!query.exec(createTable)) {
-        qDebug() << "Erreur lors de la création de la table USERS:" << query.lastError().text();
+bool Connexion::createConnection()
+{
+    databaseConfig = DatabaseConfig::load();
+    QueryProfiler::configure(databaseConfig.slowQueryMs, databaseConfig.slowQueryLog);
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    if (!openDatabase(db)) {
         return false;
     }
 
-    qDebug() << "Table USERS créée ou déjà existante.";
+    qDebug() << "Connexion à la base de données réussie ôô";
+
+    // Tables, index et triggers : migrations manquantes seulement
+    if (!SchemaMigrator::migrate(db)) {
+        return false;
+    }
 
     // Insérer un utilisateur par défaut si la table est vide
-    query.exec("SELECT COUNT(*) FROM USERS");
+    QSqlQuery query;
+    QueryProfiler::exec(query, "SELECT COUNT(*) FROM USERS");
     if (query.next() && query.value(0).toInt() == 0) {
         QString hashedPassword = QCryptographicHash::hash(QString("admin123").toUtf8(), QCryptographicHash::Sha256).toHex();
         query.prepare("INSERT INTO USERS (nom, email, mot_de_passe, role) VALUES (?, ?, ?, ?)");
@@ -47,12 +61,14 @@ bool Connexion::createConnection()
         query.addBindValue("admin@example.com");
         query.addBindValue(hashedPassword);
         query.addBindValue("ADMIN");
-        if (!query.exec()) {
+        if (!QueryProfiler::exec(query)) {
             qDebug() << "Erreur lors de l'insertion de l'utilisateur par défaut:" << query.lastError().text();
             return false;
         }
         qDebug() << "Utilisateur par défaut inséré.";
     }
 
+    SearchIndex::detect();
+
     return true;
 }
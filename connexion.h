@@ -2,12 +2,20 @@
 #define CONNEXION_H
 
 #include <QSqlDatabase>
+#include "databaseconfig.h"
 
 class Connexion
 {
 public:
     Connexion();
     static bool createConnection();
+
+    // Ouvre une connexion avec la configuration courante (fichier et pragmas)
+    static bool openDatabase(QSqlDatabase &db);
+    static const DatabaseConfig &config();
+
+private:
+    static DatabaseConfig databaseConfig;
 };
 
 #endif // CONNEXION_H
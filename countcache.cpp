@@ -0,0 +1,151 @@
+#include "countcache.h"
+#include "queryprofiler.h"
+#include "databaseservice.h"
+#include "statementcache.h"
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QDebug>
+
+namespace {
+struct Entry {
+    qint64 version = -1;
+    int count = -1;
+};
+
+// Quelques dizaines de filtres suffisent : au-delà, les moins récemment
+// utilisés sont oubliés
+const int MaxEntries = 256;
+
+QMutex memoMutex;
+QCache<QString, Entry> memo(MaxEntries);
+
+QString keyFor(const QString &table, const QString &filterKey)
+{
+    return table + QLatin1Char('\n') + filterKey;
+}
+}
+
+CountCache::CountCache() {}
+
+QStringList CountCache::createStatements()
+{
+    QStringList statements = {
+        "CREATE TABLE IF NOT EXISTS COUNTERS ("
+        "table_name TEXT PRIMARY KEY, "
+        "row_count INTEGER NOT NULL DEFAULT 0, "
+        "version INTEGER NOT NULL DEFAULT 0)"
+    };
+
+    const QStringList tables = {"CLIENTS", "USERS", "COMMANDES"};
+    for (const QString &table : tables) {
+        // INSERT OR IGNORE : le comptage initial n'a lieu qu'une fois, les
+        // triggers prennent ensuite le relais
+        statements << QString("INSERT OR IGNORE INTO COUNTERS (table_name, row_count) "
+                              "SELECT '%1', COUNT(*) FROM %1").arg(table)
+                   << QString("CREATE TRIGGER COUNTERS_%1_AI AFTER INSERT ON %1 BEGIN "
+                              "UPDATE COUNTERS SET row_count = row_count + 1, version = version + 1 "
+                              "WHERE table_name = '%1'; END").arg(table)
+                   << QString("CREATE TRIGGER COUNTERS_%1_AD AFTER DELETE ON %1 BEGIN "
+                              "UPDATE COUNTERS SET row_count = row_count - 1, version = version + 1 "
+                              "WHERE table_name = '%1'; END").arg(table)
+                   << QString("CREATE TRIGGER COUNTERS_%1_AU AFTER UPDATE ON %1 BEGIN "
+                              "UPDATE COUNTERS SET version = version + 1 "
+                              "WHERE table_name = '%1'; END").arg(table);
+    }
+
+    // La recherche des commandes porte aussi sur le client et les produits
+    statements << "CREATE TRIGGER COUNTERS_COMMANDES_CLIENT_AU AFTER UPDATE OF nom, prenom ON CLIENTS BEGIN "
+                  "UPDATE COUNTERS SET version = version + 1 WHERE table_name = 'COMMANDES'; END"
+               << "CREATE TRIGGER COUNTERS_COMMANDES_PRODUIT_AU AFTER UPDATE OF nom_produit ON PRODUITS BEGIN "
+                  "UPDATE COUNTERS SET version = version + 1 WHERE table_name = 'COMMANDES'; END";
+    return statements;
+}
+
+bool CountCache::readCounter(QSqlDatabase &db, const QString &table, int *rowCount, qint64 *version)
+{
+    QSqlQuery *query = StatementCache::prepared(db,
+        "SELECT row_count, version FROM COUNTERS WHERE table_name = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, table);
+    if (!QueryProfiler::exec(*query) || !query->next()) {
+        query->finish();
+        return false;
+    }
+    *rowCount = query->value(0).toInt();
+    *version = query->value(1).toLongLong();
+    query->finish();
+    return true;
+}
+
+int CountCache::cached(QSqlDatabase &db, const CountQuery &query, qint64 *version)
+{
+    int rowCount = -1;
+    qint64 currentVersion = -1;
+    if (!readCounter(db, query.table, &rowCount, &currentVersion)) {
+        currentVersion = -1;
+        rowCount = -1;
+    }
+    if (version) {
+        *version = currentVersion;
+    }
+
+    if (query.filterKey.isEmpty() || currentVersion < 0) {
+        return rowCount;
+    }
+
+    QMutexLocker locker(&memoMutex);
+    const Entry *entry = memo.object(keyFor(query.table, query.filterKey));
+    return entry && entry->version == currentVersion ? entry->count : -1;
+}
+
+int CountCache::count(QSqlDatabase &db, const CountQuery &query)
+{
+    // Version lue avant le comptage : une écriture concurrente rend
+    // l'entrée périmée au lieu de mémoriser un total faux
+    qint64 version = -1;
+    int total = cached(db, query, &version);
+    if (total >= 0) {
+        return total;
+    }
+
+    QVariant value = DatabaseService::scalar(db, query.sql, query.bindValues);
+    if (!value.isValid()) {
+        return -1;
+    }
+    total = value.toInt();
+    remember(query, version, total);
+    return total;
+}
+
+void CountCache::resolveTotal(QSqlDatabase &db, const CountQuery &query, int page, int pageSize,
+                              bool reversed, QueryResult &result)
+{
+    qint64 version = -1;
+    result.totalRows = cached(db, query, &version);
+    result.dataVersion = version;
+
+    // Pas de ligne en plus en avançant : c'est la dernière page, le total est
+    // connu (la première page quand toute la liste y tient)
+    if (result.totalRows < 0 && (page == 0 || !reversed) && result.rows.size() <= pageSize) {
+        result.totalRows = page * pageSize + result.rows.size();
+        remember(query, version, result.totalRows);
+    }
+}
+
+void CountCache::remember(const CountQuery &query, qint64 version, int count)
+{
+    if (query.filterKey.isEmpty() || version < 0) {
+        return;
+    }
+
+    Entry *entry = new Entry;
+    entry->version = version;
+    entry->count = count;
+    QMutexLocker locker(&memoMutex);
+    memo.insert(keyFor(query.table, query.filterKey), entry);
+}
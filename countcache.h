@@ -0,0 +1,55 @@
+#ifndef COUNTCACHE_H
+#define COUNTCACHE_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+struct QueryResult;
+
+// Comptage d'une liste filtrée ; filterKey vide = table entière
+struct CountQuery
+{
+    QString table;
+    QString filterKey;
+    QString sql;
+    QVariantList bindValues;
+};
+
+// Nombre de lignes des listes paginées sans COUNT(*) à chaque page :
+//  - le total d'une table est tenu par triggers dans COUNTERS ;
+//  - un total filtré est mémorisé par (table, filtre) avec la version de la
+//    table, que chaque écriture incrémente : il est recalculé seulement
+//    après une modification, et seulement quand on le demande.
+// Les lectures s'exécutent sur le thread base de données.
+class CountCache
+{
+public:
+    // Table et triggers (migration du schéma). Tables suivies : CLIENTS,
+    // USERS, COMMANDES
+    static QStringList createStatements();
+
+    // Total déjà connu, -1 sinon. version reçoit la version courante de la
+    // table (-1 si inconnue).
+    static int cached(QSqlDatabase &db, const CountQuery &query, qint64 *version = nullptr);
+
+    // Total connu ou calculé par query.sql, puis mémorisé
+    static int count(QSqlDatabase &db, const CountQuery &query);
+
+    // Renseigne totalRows / dataVersion d'une page lue avec une ligne en
+    // plus, sans lancer de COUNT : le total reste à -1 s'il n'est pas connu.
+    // Une page lue en avançant (reversed faux) et incomplète est la dernière :
+    // le total s'en déduit et il est mémorisé.
+    static void resolveTotal(QSqlDatabase &db, const CountQuery &query, int page, int pageSize,
+                             bool reversed, QueryResult &result);
+
+    static void remember(const CountQuery &query, qint64 version, int count);
+
+private:
+    CountCache();
+
+    static bool readCounter(QSqlDatabase &db, const QString &table, int *rowCount, qint64 *version);
+};
+
+#endif // COUNTCACHE_H
@@ -1,5 +1,8 @@
 #include "dashboardpage.h"
 #include "thememanager.h"
+#include "databaseservice.h"
+#include "saleschart.h"
+#include "uiprofiler.h"
 #include <QFont>
 #include <QGraphicsDropShadowEffect>
 #include <QVBoxLayout>
@@ -10,6 +13,8 @@
 #include <QPixmap>
 #include <QGraphicsBlurEffect>
 #include <QGridLayout>
+#include <QLocale>
+#include <QDebug>
 
 GlassmorphismEffect::GlassmorphismEffect(QObject *parent)
     : QGraphicsEffect(parent)
@@ -39,7 +44,6 @@ DashboardCard::DashboardCard(const DashboardStats &stats, QWidget *parent)
     setObjectName("dashboardCard");
     setProperty("colorClass", stats.colorClass);
     
-    ThemeManager& theme = ThemeManager::instance();
     
     QGraphicsDropShadowEffect *shadow = new QGraphicsDropShadowEffect(this);
     shadow->setBlurRadius(32);
@@ -52,10 +56,9 @@ DashboardCard::DashboardCard(const DashboardStats &stats, QWidget *parent)
     layout->setSpacing(14);
     layout->setContentsMargins(28, 28, 28, 28);
 
-    QLabel *iconLabel = new QLabel(stats.icon, this);
+    iconLabel = new QLabel(stats.icon, this);
     iconLabel->setObjectName("dashboardIcon");
     iconLabel->setAlignment(Qt::AlignCenter);
-    iconLabel->setStyleSheet(QString("color: %1;").arg(theme.textColor().name()));
     QFont iconFont = iconLabel->font();
     iconFont.setPointSize(40);
     iconLabel->setFont(iconFont);
@@ -63,33 +66,61 @@ DashboardCard::DashboardCard(const DashboardStats &stats, QWidget *parent)
 
     layout->addWidget(iconLabel, 0, Qt::AlignCenter);
 
-    QLabel *titleLabel = new QLabel(stats.title, this);
+    titleLabel = new QLabel(stats.title, this);
     titleLabel->setObjectName("dashboardCardTitle");
-    titleLabel->setStyleSheet(QString("color: %1; font-weight: 600; letter-spacing: 0.5px;").arg(theme.textSecondaryColor().name()));
+    ThemeManager::setTone(titleLabel, "secondary");
     QFont titleFont = titleLabel->font();
     titleFont.setPointSize(11);
     titleFont.setWeight(QFont::DemiBold);
     titleLabel->setFont(titleFont);
     titleLabel->setAlignment(Qt::AlignCenter);
 
-    QLabel *valueLabel = new QLabel(stats.value, this);
+    valueLabel = new QLabel(stats.value, this);
     valueLabel->setObjectName("dashboardCardValue");
-    valueLabel->setStyleSheet(QString("color: %1; font-weight: 700;").arg(theme.textColor().name()));
     QFont valueFont = valueLabel->font();
     valueFont.setPointSize(38);
     valueFont.setBold(true);
     valueLabel->setFont(valueFont);
     valueLabel->setAlignment(Qt::AlignCenter);
 
+    trendLabel = new QLabel(this);
+    trendLabel->setObjectName("dashboardCardTrend");
+    QFont trendFont = trendLabel->font();
+    trendFont.setPointSize(11);
+    trendFont.setWeight(QFont::DemiBold);
+    trendLabel->setFont(trendFont);
+    trendLabel->setAlignment(Qt::AlignCenter);
+
     layout->addWidget(titleLabel, 0, Qt::AlignCenter);
     layout->addWidget(valueLabel, 0, Qt::AlignCenter);
+    layout->addWidget(trendLabel, 0, Qt::AlignCenter);
     layout->addStretch();
+
+    setStats(stats);
 }
 
-DashboardPage::DashboardPage(QWidget *parent) : QFrame(parent)
+void DashboardCard::setStats(const DashboardStats &stats)
+{
+    iconLabel->setText(stats.icon);
+    titleLabel->setText(stats.title);
+    valueLabel->setText(stats.value);
+    trendLabel->setText(stats.trend);
+
+    // Teinte résolue par la feuille globale : rien à refaire au changement de thème
+    QString tone = "secondary";
+    if (stats.trendColor == "green") {
+        tone = "success";
+    } else if (stats.trendColor == "red") {
+        tone = "danger";
+    }
+    ThemeManager::setTone(trendLabel, tone);
+}
+
+DashboardPage::DashboardPage(QWidget *parent) : QFrame(parent), salesChart(nullptr), metricsGeneration(0)
 {
     setObjectName("dashboardPage");
     setupUI();
+    refreshMetrics();
 }
 
 void DashboardPage::setupUI()
@@ -111,8 +142,7 @@ void DashboardPage::setupUI()
     
     QLabel *subtitle = new QLabel("Aperçu en temps réel de vos métriques clés", this);
     subtitle->setObjectName("subtitle");
-    ThemeManager& theme = ThemeManager::instance();
-    subtitle->setStyleSheet(QString("color: %1;").arg(theme.textSecondaryColor().name()));
+    ThemeManager::setTone(subtitle, "secondary");
     QFont subtitleFont = subtitle->font();
     subtitleFont.setPointSize(13);
     subtitleFont.setWeight(QFont::Normal);
@@ -127,12 +157,14 @@ void DashboardPage::setupUI()
     cardsLayout->setRowStretch(0, 0);
     cardsLayout->setRowStretch(1, 0);
 
-    QList<DashboardStats> stats = getStaticData();
+    // Cartes affichées tout de suite, valeurs remplies au retour du calcul
+    QList<DashboardStats> stats = statsFor(DashboardMetrics());
     for (int i = 0; i < stats.size(); ++i) {
         DashboardCard *card = new DashboardCard(stats[i], this);
         card->setMinimumHeight(240);
         card->setMaximumHeight(280);
         cardsLayout->addWidget(card, i / 2, i % 2);
+        cards.append(card);
     }
 
     QWidget *cardsWidget = new QWidget(this);
@@ -160,102 +192,115 @@ void DashboardPage::setupUI()
     analyticsTitleFont.setBold(true);
     analyticsTitleFont.setLetterSpacing(QFont::AbsoluteSpacing, 0.3);
     analyticsTitle->setFont(analyticsTitleFont);
-    analyticsTitle->setStyleSheet(QString("color: %1;").arg(theme.textColor().name()));
     analyticsLayout->addWidget(analyticsTitle);
     
-    QWidget *chartWidget = createChartPlaceholder();
-    analyticsLayout->addWidget(chartWidget, 1);
+    salesChart = new SalesChart(analyticsFrame);
+    analyticsLayout->addWidget(salesChart, 1);
 
     mainLayout->addWidget(analyticsFrame, 1);
 }
 
-QList<DashboardStats> DashboardPage::getStaticData()
+QString DashboardPage::styleRules()
+{
+    return QString(
+        "#dashboardPage QLabel#dashboardIcon {"
+        "   color: palette(window-text);"
+        "}"
+        "#dashboardPage QLabel#dashboardCardTitle {"
+        "   font-weight: 600;"
+        "   letter-spacing: 0.5px;"
+        "}"
+        "#dashboardPage QLabel#dashboardCardValue {"
+        "   color: palette(window-text);"
+        "   font-weight: 700;"
+        "}"
+        "#dashboardPage QLabel#titleH2 {"
+        "   color: palette(window-text);"
+        "}"
+    );
+}
+
+void DashboardPage::refreshMetrics()
 {
-    return QList<DashboardStats>{
-        {
-            "Utilisateurs",
-            "12",
-            "👥",
-            "purple",
-            "+2",
-            "green"
-        },
-        {
-            "Clients",
-            "45",
-            "🤝",
-            "orange",
-            "+8",
-            "green"
-        },
-        {
-            "Produits",
-            "128",
-            "📦",
-            "pink",
-            "+15",
-            "green"
-        },
-        {
-            "Commandes",
-            "23",
-            "📋",
-            "cyan",
-            "+5",
-            "green"
+    UiProfiler::Scope scope("DashboardPage::refreshMetrics");
+    int generation = ++metricsGeneration;
+    pendingMetrics.cancel();
+
+    const QDate today = QDate::currentDate();
+    pendingMetrics = DatabaseService::instance().run<DashboardMetrics>(
+        [today](QSqlDatabase &db) {
+            return MetricsEngine::compute(db, today);
+        });
+
+    salesChart->refresh();
+
+    pendingMetrics.then(this, [this, generation](const DashboardMetrics &metrics) {
+        if (generation != metricsGeneration) {
+            return;
         }
+        if (!metrics.ok) {
+            qDebug() << "Statistiques du tableau de bord indisponibles:" << metrics.error;
+        }
+        const QList<DashboardStats> stats = statsFor(metrics);
+        for (int i = 0; i < stats.size() && i < cards.size(); ++i) {
+            cards[i]->setStats(stats[i]);
+        }
+    });
+}
+
+QList<DashboardStats> DashboardPage::statsFor(const DashboardMetrics &metrics) const
+{
+    QList<DashboardStats> stats{
+        {"CA du jour", "—", "💶", "purple", "", ""},
+        {"CA 7 derniers jours", "—", "📈", "orange", "", ""},
+        {"CA 30 derniers jours", "—", "🗓", "pink", "", ""},
+        {"Commandes (30 jours)", "—", "📋", "cyan", "", ""},
+        {"Panier moyen (30 jours)", "—", "🛒", "purple", "", ""},
+        {"Produits en stock bas", "—", "📦", "orange", "", ""}
     };
+    if (!metrics.ok) {
+        return stats;
+    }
+
+    stats[0].value = formatAmount(metrics.today.revenue);
+    stats[0] = withTrend(stats[0], metrics.today.revenue, metrics.yesterday.revenue);
+
+    stats[1].value = formatAmount(metrics.week.revenue);
+    stats[1] = withTrend(stats[1], metrics.week.revenue, metrics.previousWeek.revenue);
+
+    stats[2].value = formatAmount(metrics.month.revenue);
+    stats[2] = withTrend(stats[2], metrics.month.revenue, metrics.previousMonth.revenue);
+
+    stats[3].value = QString::number(metrics.month.orders);
+    stats[3] = withTrend(stats[3], metrics.month.orders, metrics.previousMonth.orders);
+
+    stats[4].value = formatAmount(metrics.month.averageBasket());
+    stats[4] = withTrend(stats[4], metrics.month.averageBasket(), metrics.previousMonth.averageBasket());
+
+    stats[5].value = QString::number(metrics.lowStockProducts);
+    stats[5].trend = metrics.lowStockProducts > 0 ? "à réapprovisionner" : "stock suffisant";
+    stats[5].trendColor = metrics.lowStockProducts > 0 ? "red" : "green";
+
+    return stats;
 }
 
-QWidget* DashboardPage::createChartPlaceholder()
+QString DashboardPage::formatAmount(double amount)
 {
-    ThemeManager& theme = ThemeManager::instance();
-    
-    QFrame *chartFrame = new QFrame(this);
-    chartFrame->setObjectName("chartFrame");
-    
-    QString bgColor = (theme.currentTheme() == ThemeManager::LightMode) 
-        ? theme.surfaceColor().name()
-        : theme.surfaceAltColor().name();
-    QString borderColor = theme.borderColor().name();
-    QString textColor = theme.textColor().name();
-    QString secondaryText = theme.textSecondaryColor().name();
-    
-    chartFrame->setStyleSheet(
-        QString("#chartFrame { "
-        "background: %1; "
-        "border: 1px solid %2; "
-        "border-radius: 16px; "
-        "padding: 0px; "
-        "}").arg(bgColor, borderColor)
-    );
-    
-    QVBoxLayout *layout = new QVBoxLayout(chartFrame);
-    layout->setSpacing(24);
-    layout->setContentsMargins(48, 48, 48, 48);
-    
-    QLabel *label = new QLabel("📊 Graphique Analytique", chartFrame);
-    label->setAlignment(Qt::AlignCenter);
-    QFont labelFont = label->font();
-    labelFont.setPointSize(18);
-    labelFont.setBold(true);
-    labelFont.setLetterSpacing(QFont::AbsoluteSpacing, 0.4);
-    label->setFont(labelFont);
-    label->setStyleSheet(QString("color: %1;").arg(textColor));
-    
-    QLabel *descLabel = new QLabel("Graphiques détaillés à venir avec Qt Charts", chartFrame);
-    descLabel->setAlignment(Qt::AlignCenter);
-    QFont descFont = descLabel->font();
-    descFont.setPointSize(12);
-    descLabel->setFont(descFont);
-    descLabel->setStyleSheet(QString("color: %1; line-height: 1.6;").arg(secondaryText));
-    
-    layout->addStretch();
-    layout->addWidget(label);
-    layout->addWidget(descLabel);
-    layout->addStretch();
-    
-    chartFrame->setMinimumHeight(520);
-    
-    return chartFrame;
+    return QLocale(QLocale::French).toString(amount, 'f', 2) + " €";
+}
+
+DashboardStats DashboardPage::withTrend(DashboardStats stats, double current, double previous)
+{
+    // Tendance par rapport à la période précédente de même durée
+    if (previous <= 0.0) {
+        stats.trend = current > 0.0 ? "nouveau" : "";
+        stats.trendColor = current > 0.0 ? "green" : "";
+        return stats;
+    }
+    const double change = (current - previous) * 100.0 / previous;
+    stats.trend = QString("%1%2% vs période précédente")
+                      .arg(change >= 0.0 ? "+" : "")
+                      .arg(QString::number(change, 'f', 0));
+    stats.trendColor = change >= 0.0 ? "green" : "red";
+    return stats;
 }
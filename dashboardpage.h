@@ -7,6 +7,10 @@
 #include <QHBoxLayout>
 #include <QGraphicsEffect>
 #include <QMap>
+#include <QFuture>
+#include "metricsengine.h"
+
+class SalesChart;
 
 struct DashboardStats {
     QString title;
@@ -40,6 +44,14 @@ class DashboardCard : public QFrame
 
 public:
     explicit DashboardCard(const DashboardStats &stats, QWidget *parent = nullptr);
+
+    void setStats(const DashboardStats &stats);
+
+private:
+    QLabel *iconLabel;
+    QLabel *titleLabel;
+    QLabel *valueLabel;
+    QLabel *trendLabel;
 };
 
 class DashboardPage : public QFrame
@@ -49,10 +61,23 @@ class DashboardPage : public QFrame
 public:
     explicit DashboardPage(QWidget *parent = nullptr);
 
+    static QString styleRules();
+
+public slots:
+    // Relit les indicateurs sur le thread base de données
+    void refreshMetrics();
+
 private:
     void setupUI();
-    QList<DashboardStats> getStaticData();
-    QWidget* createChartPlaceholder();
+    QList<DashboardStats> statsFor(const DashboardMetrics &metrics) const;
+
+    static QString formatAmount(double amount);
+    static DashboardStats withTrend(DashboardStats stats, double current, double previous);
+
+    QList<DashboardCard*> cards;
+    SalesChart *salesChart;
+    QFuture<DashboardMetrics> pendingMetrics;
+    int metricsGeneration;
 };
 
 #endif // DASHBOARDPAGE_H
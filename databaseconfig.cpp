@@ -0,0 +1,185 @@
+#include "databaseconfig.h"
+#include "queryprofiler.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QSettings>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <QDebug>
+
+namespace {
+const char *LegacyWindowsPath = "D:/VenteMaterielInfo.db";
+
+QString envValue(const char *name)
+{
+    return qEnvironmentVariable(name).trimmed();
+}
+
+// Les valeurs texte sont insérées telles quelles dans un PRAGMA : seules les
+// valeurs connues de SQLite sont acceptées, sinon la valeur par défaut
+QString allowedValue(const char *pragma, const QString &value, const QStringList &allowed,
+                     const QString &fallback)
+{
+    const QString upper = value.toUpper();
+    if (allowed.contains(upper)) {
+        return upper;
+    }
+    qDebug() << "Valeur" << value << "refusée pour PRAGMA" << pragma << ", utilisation de" << fallback;
+    return fallback;
+}
+}
+
+DatabaseConfig DatabaseConfig::load()
+{
+    DatabaseConfig config;
+    config.path = defaultPath();
+
+    QString iniPath = envValue("VENTE_DB_CONFIG");
+    if (iniPath.isEmpty()) {
+        iniPath = QDir(QCoreApplication::applicationDirPath()).filePath("gestionVenteMateriel.ini");
+    }
+
+    if (QFileInfo::exists(iniPath)) {
+        QSettings settings(iniPath, QSettings::IniFormat);
+        settings.beginGroup("database");
+        config.path = settings.value("path", config.path).toString();
+        config.journalMode = settings.value("journal_mode", config.journalMode).toString();
+        config.synchronous = settings.value("synchronous", config.synchronous).toString();
+        config.cacheSize = settings.value("cache_size", config.cacheSize).toInt();
+        config.mmapSize = settings.value("mmap_size", config.mmapSize).toLongLong();
+        config.tempStore = settings.value("temp_store", config.tempStore).toString();
+        config.busyTimeout = settings.value("busy_timeout", config.busyTimeout).toInt();
+        config.slowQueryMs = settings.value("slow_query_ms", config.slowQueryMs).toInt();
+        config.slowQueryLog = settings.value("slow_query_log", config.slowQueryLog).toString();
+        settings.endGroup();
+        qDebug() << "Configuration de la base lue depuis" << iniPath;
+    }
+
+    if (!envValue("VENTE_DB_PATH").isEmpty()) {
+        config.path = envValue("VENTE_DB_PATH");
+    }
+    if (!envValue("VENTE_DB_JOURNAL_MODE").isEmpty()) {
+        config.journalMode = envValue("VENTE_DB_JOURNAL_MODE");
+    }
+    if (!envValue("VENTE_DB_SYNCHRONOUS").isEmpty()) {
+        config.synchronous = envValue("VENTE_DB_SYNCHRONOUS");
+    }
+    if (!envValue("VENTE_DB_CACHE_SIZE").isEmpty()) {
+        config.cacheSize = envValue("VENTE_DB_CACHE_SIZE").toInt();
+    }
+    if (!envValue("VENTE_DB_MMAP_SIZE").isEmpty()) {
+        config.mmapSize = envValue("VENTE_DB_MMAP_SIZE").toLongLong();
+    }
+    if (!envValue("VENTE_DB_TEMP_STORE").isEmpty()) {
+        config.tempStore = envValue("VENTE_DB_TEMP_STORE");
+    }
+    if (!envValue("VENTE_DB_BUSY_TIMEOUT").isEmpty()) {
+        config.busyTimeout = envValue("VENTE_DB_BUSY_TIMEOUT").toInt();
+    }
+    if (!envValue("VENTE_DB_SLOW_QUERY_MS").isEmpty()) {
+        config.slowQueryMs = envValue("VENTE_DB_SLOW_QUERY_MS").toInt();
+    }
+    if (!envValue("VENTE_DB_SLOW_QUERY_LOG").isEmpty()) {
+        config.slowQueryLog = envValue("VENTE_DB_SLOW_QUERY_LOG");
+    }
+    if (config.slowQueryLog.isEmpty()) {
+        config.slowQueryLog = QFileInfo(config.path).absoluteDir().filePath("slow_queries.log");
+    }
+
+    const DatabaseConfig defaults;
+    config.journalMode = allowedValue("journal_mode", config.journalMode,
+                                      {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"},
+                                      defaults.journalMode);
+    config.synchronous = allowedValue("synchronous", config.synchronous,
+                                      {"OFF", "NORMAL", "FULL", "EXTRA", "0", "1", "2", "3"},
+                                      defaults.synchronous);
+    config.tempStore = allowedValue("temp_store", config.tempStore,
+                                    {"DEFAULT", "FILE", "MEMORY", "0", "1", "2"},
+                                    defaults.tempStore);
+    return config;
+}
+
+QString DatabaseConfig::defaultPath()
+{
+    // Les postes Windows existants gardent leur base à l'ancien emplacement
+    if (QFileInfo::exists(LegacyWindowsPath)) {
+        return LegacyWindowsPath;
+    }
+
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    return QDir(dataDir).filePath("VenteMaterielInfo.db");
+}
+
+void DatabaseConfig::configure(QSqlDatabase &db) const
+{
+    db.setDatabaseName(path);
+    db.setConnectOptions(QString("QSQLITE_BUSY_TIMEOUT=%1").arg(busyTimeout));
+}
+
+bool DatabaseConfig::applyPragmas(QSqlDatabase &db) const
+{
+    const QStringList pragmas = {
+        QString("PRAGMA journal_mode = %1").arg(journalMode),
+        QString("PRAGMA synchronous = %1").arg(synchronous),
+        QString("PRAGMA cache_size = %1").arg(cacheSize),
+        QString("PRAGMA mmap_size = %1").arg(mmapSize),
+        QString("PRAGMA temp_store = %1").arg(tempStore),
+        QString("PRAGMA busy_timeout = %1").arg(busyTimeout)
+    };
+
+    // Un pragma refusé (WAL sur un partage réseau...) n'empêche pas les
+    // suivants : tous sont appliqués, chaque échec est signalé
+    bool ok = true;
+    QSqlQuery query(db);
+    for (const QString &pragma : pragmas) {
+        if (!QueryProfiler::exec(query, pragma)) {
+            qDebug() << "Erreur lors de l'application de" << pragma << ":" << query.lastError().text();
+            ok = false;
+        }
+    }
+    return verify(db) && ok;
+}
+
+bool DatabaseConfig::verify(QSqlDatabase &db) const
+{
+    // SQLite renvoie les valeurs numériques : synchronous NORMAL = 1, temp_store MEMORY = 2
+    const QHash<QString, QString> synchronousValues = {{"OFF", "0"}, {"NORMAL", "1"}, {"FULL", "2"}, {"EXTRA", "3"}};
+    const QHash<QString, QString> tempStoreValues = {{"DEFAULT", "0"}, {"FILE", "1"}, {"MEMORY", "2"}};
+
+    const QList<QPair<QString, QString>> expected = {
+        {"journal_mode", journalMode.toLower()},
+        {"synchronous", synchronousValues.value(synchronous, synchronous)},
+        {"cache_size", QString::number(cacheSize)},
+        {"temp_store", tempStoreValues.value(tempStore, tempStore)},
+        {"busy_timeout", QString::number(busyTimeout)}
+    };
+
+    bool ok = true;
+    QSqlQuery query(db);
+    for (const auto &pragma : expected) {
+        if (!QueryProfiler::exec(query, "PRAGMA " + pragma.first) || !query.next()) {
+            qDebug() << "Impossible de relire PRAGMA" << pragma.first << ":" << query.lastError().text();
+            ok = false;
+            continue;
+        }
+        QString actual = query.value(0).toString().toLower();
+        if (actual != pragma.second.toLower()) {
+            qDebug() << "PRAGMA" << pragma.first << "vaut" << actual << "au lieu de" << pragma.second;
+            ok = false;
+        }
+    }
+
+    // mmap_size peut être plafonné par la compilation de SQLite : simple information
+    if (QueryProfiler::exec(query, "PRAGMA mmap_size") && query.next() && query.value(0).toLongLong() != mmapSize) {
+        qDebug() << "PRAGMA mmap_size plafonné à" << query.value(0).toLongLong();
+    }
+
+    qDebug() << "Base" << db.databaseName() << ": journal" << journalMode << ", synchronous" << synchronous
+             << (ok ? "(vérifié)" : "(écarts détectés)");
+    return ok;
+}
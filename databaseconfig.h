@@ -0,0 +1,39 @@
+#ifndef DATABASECONFIG_H
+#define DATABASECONFIG_H
+
+#include <QString>
+
+class QSqlDatabase;
+
+// Paramètres de la connexion SQLite : emplacement du fichier et pragmas.
+// Valeurs par défaut, puis fichier INI, puis variables d'environnement :
+//   VENTE_DB_CONFIG        chemin du fichier INI (groupe [database])
+//   VENTE_DB_PATH          chemin de la base
+//   VENTE_DB_JOURNAL_MODE, VENTE_DB_SYNCHRONOUS, VENTE_DB_CACHE_SIZE,
+//   VENTE_DB_MMAP_SIZE, VENTE_DB_TEMP_STORE, VENTE_DB_BUSY_TIMEOUT
+//   VENTE_DB_SLOW_QUERY_MS, VENTE_DB_SLOW_QUERY_LOG
+struct DatabaseConfig
+{
+    QString path;
+    QString journalMode = "WAL";
+    QString synchronous = "NORMAL";
+    int cacheSize = -20000;              // en Kio si négatif (convention SQLite)
+    qint64 mmapSize = 256 * 1024 * 1024;
+    QString tempStore = "MEMORY";
+    int busyTimeout = 5000;              // en millisecondes
+    int slowQueryMs = 100;               // journal des requêtes lentes, 0 pour le couper
+    QString slowQueryLog;                // à côté de la base par défaut
+
+    static DatabaseConfig load();
+
+    // Nom du fichier et options du pilote, à appeler avant open()
+    void configure(QSqlDatabase &db) const;
+    // Pragmas appliqués juste après open(), puis relus pour vérification
+    bool applyPragmas(QSqlDatabase &db) const;
+    bool verify(QSqlDatabase &db) const;
+
+private:
+    static QString defaultPath();
+};
+
+#endif // DATABASECONFIG_H
@@ -0,0 +1,178 @@
+#include "databaseservice.h"
+#include "queryprofiler.h"
+#include "connexion.h"
+#include "statementcache.h"
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QDebug>
+#ifdef HAVE_SQLITE3_API
+#include <sqlite3.h>
+#endif
+
+namespace {
+const char *WorkerConnectionName = "db-worker";
+
+#ifdef HAVE_SQLITE3_API
+// sqlite3_interrupt() n'agit sans risque sur la connexion du pilote QSQLITE
+// que si le pilote utilise la même bibliothèque SQLite que l'application
+// (Qt compilé avec -system-sqlite) : vérifié une fois, sur le worker.
+bool sameSqliteLibrary(QSqlDatabase &db)
+{
+    static int same = -1;
+    if (same < 0) {
+        QSqlQuery query(db);
+        same = QueryProfiler::exec(query, "SELECT sqlite_version()") && query.next()
+               && query.value(0).toString() == QLatin1String(sqlite3_libversion());
+        if (!same) {
+            qDebug() << "SQLite du pilote différent de" << sqlite3_libversion()
+                     << ": les requêtes annulées ne sont pas interrompues";
+        }
+    }
+    return same;
+}
+#endif
+}
+
+DatabaseService& DatabaseService::instance()
+{
+    static DatabaseService _instance;
+    return _instance;
+}
+
+DatabaseService::DatabaseService()
+    : QObject(), m_worker(new QObject), m_lastJobId(0), m_runningJobId(0), m_runningHandle(nullptr)
+{
+    m_thread.setObjectName("DatabaseService");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_thread.start();
+}
+
+DatabaseService::~DatabaseService()
+{
+    shutdown();
+}
+
+void DatabaseService::shutdown()
+{
+    if (!m_thread.isRunning()) {
+        return;
+    }
+
+    // La connexion doit être fermée par le thread qui l'a ouverte
+    QMetaObject::invokeMethod(m_worker, []() {
+        if (QSqlDatabase::contains(WorkerConnectionName)) {
+            StatementCache::clear(WorkerConnectionName);
+            {
+                QSqlDatabase db = QSqlDatabase::database(WorkerConnectionName, false);
+                db.close();
+            }
+            QSqlDatabase::removeDatabase(WorkerConnectionName);
+        }
+    }, Qt::BlockingQueuedConnection);
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+QSqlDatabase DatabaseService::workerDatabase()
+{
+    if (QSqlDatabase::contains(WorkerConnectionName)) {
+        return QSqlDatabase::database(WorkerConnectionName);
+    }
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", WorkerConnectionName);
+    if (!Connexion::openDatabase(db)) {
+        qDebug() << "Connexion du thread base de données impossible:" << db.lastError().text();
+    }
+    return db;
+}
+
+quint64 DatabaseService::nextJobId()
+{
+    QMutexLocker locker(&m_jobLock);
+    return ++m_lastJobId;
+}
+
+void DatabaseService::beginJob(quint64 jobId, QSqlDatabase &db)
+{
+    void *handle = nullptr;
+#ifdef HAVE_SQLITE3_API
+    const QVariant driverHandle = db.driver()->handle();
+    if (driverHandle.isValid() && qstrcmp(driverHandle.typeName(), "sqlite3*") == 0 && sameSqliteLibrary(db)) {
+        handle = *static_cast<void *const *>(driverHandle.constData());
+    }
+#else
+    Q_UNUSED(db);
+#endif
+
+    QMutexLocker locker(&m_jobLock);
+    m_runningJobId = jobId;
+    m_runningHandle = handle;
+}
+
+void DatabaseService::endJob()
+{
+    QMutexLocker locker(&m_jobLock);
+    m_runningJobId = 0;
+    m_runningHandle = nullptr;
+}
+
+void DatabaseService::interrupt(quint64 jobId)
+{
+    // Sous le verrou : la connexion reste ouverte tant que le job n'est pas terminé
+    QMutexLocker locker(&m_jobLock);
+    if (jobId != m_runningJobId || !m_runningHandle) {
+        return;
+    }
+#ifdef HAVE_SQLITE3_API
+    sqlite3_interrupt(static_cast<sqlite3 *>(m_runningHandle));
+#endif
+}
+
+QueryResult DatabaseService::select(QSqlDatabase &db, const QString &sql, const QVariantList &bindValues)
+{
+    QueryResult result;
+
+    QSqlQuery *query = StatementCache::prepared(db, sql, &result.error);
+    if (!query) {
+        return result;
+    }
+    for (int i = 0; i < bindValues.size(); ++i) {
+        query->bindValue(i, bindValues.at(i));
+    }
+
+    if (!QueryProfiler::exec(*query)) {
+        result.error = query->lastError().text();
+        qDebug() << "Erreur de requête:" << result.error;
+        return result;
+    }
+
+    while (query->next()) {
+        result.rows.append(query->record());
+    }
+    QueryProfiler::addRows(*query, result.rows.size());
+    query->finish();
+    result.ok = true;
+    return result;
+}
+
+QVariant DatabaseService::scalar(QSqlDatabase &db, const QString &sql, const QVariantList &bindValues)
+{
+    QSqlQuery *query = StatementCache::prepared(db, sql);
+    if (!query) {
+        return QVariant();
+    }
+    for (int i = 0; i < bindValues.size(); ++i) {
+        query->bindValue(i, bindValues.at(i));
+    }
+
+    if (!QueryProfiler::exec(*query) || !query->next()) {
+        qDebug() << "Erreur de requête:" << query->lastError().text();
+        return QVariant();
+    }
+    QVariant value = query->value(0);
+    query->finish();
+    return value;
+}
@@ -0,0 +1,104 @@
+#ifndef DATABASESERVICE_H
+#define DATABASESERVICE_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QMutex>
+#include <QPromise>
+#include <QSqlDatabase>
+#include <QSqlRecord>
+#include <QVariant>
+#include <QVector>
+#include <functional>
+#include <memory>
+
+// Résultat d'une lecture exécutée sur le thread base de données : copie
+// autonome des lignes, utilisable sans connexion depuis le thread GUI.
+struct QueryResult
+{
+    bool ok = false;
+    QString error;
+    int totalRows = -1;          // renseigné quand la requête inclut un comptage
+    qint64 dataVersion = -1;     // version des données comptées (CountCache)
+    QVector<QSqlRecord> rows;
+};
+
+// Service d'accès à la base sur un thread dédié, avec sa propre connexion.
+// Les pages y envoient leurs lectures et reçoivent un QFuture :
+//   DatabaseService::instance().run<QueryResult>([sql](QSqlDatabase &db) { ... })
+//       .then(this, [this](const QueryResult &result) { ... });
+// Annuler le QFuture d'une recherche périmée évite de l'exécuter s'il attend
+// encore, et interrompt la requête (sqlite3_interrupt) s'il est en cours.
+class DatabaseService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DatabaseService& instance();
+
+    template <typename T>
+    QFuture<T> run(std::function<T(QSqlDatabase &)> job);
+
+    // Ferme la connexion du worker et arrête le thread (avant la fin de main)
+    void shutdown();
+
+    // Aides pour les jobs, exécutées sur le thread du worker
+    static QueryResult select(QSqlDatabase &db, const QString &sql, const QVariantList &bindValues = {});
+    static QVariant scalar(QSqlDatabase &db, const QString &sql, const QVariantList &bindValues = {});
+
+private:
+    DatabaseService();
+    ~DatabaseService();
+    DatabaseService(const DatabaseService&) = delete;
+    DatabaseService& operator=(const DatabaseService&) = delete;
+
+    static QSqlDatabase workerDatabase();
+
+    // Job en cours sur le worker, pour interrupt()
+    quint64 nextJobId();
+    void beginJob(quint64 jobId, QSqlDatabase &db);
+    void endJob();
+    void interrupt(quint64 jobId);
+
+    QThread m_thread;
+    QObject *m_worker;
+
+    QMutex m_jobLock;
+    quint64 m_lastJobId;
+    quint64 m_runningJobId;
+    void *m_runningHandle;       // sqlite3* de la connexion du worker pendant un job
+};
+
+template <typename T>
+QFuture<T> DatabaseService::run(std::function<T(QSqlDatabase &)> job)
+{
+    auto promise = std::make_shared<QPromise<T>>();
+    QFuture<T> future = promise->future();
+    const quint64 jobId = nextJobId();
+
+    // Une annulation pendant l'exécution interrompt la requête en cours
+    auto *watcher = new QFutureWatcher<T>();
+    QObject::connect(watcher, &QFutureWatcherBase::canceled, watcher, [this, jobId]() {
+        interrupt(jobId);
+    });
+    QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, &QObject::deleteLater);
+    watcher->setFuture(future);
+
+    QMetaObject::invokeMethod(m_worker, [this, promise, job, jobId]() {
+        promise->start();
+        if (!promise->isCanceled()) {
+            QSqlDatabase db = workerDatabase();
+            beginJob(jobId, db);
+            T result = job(db);
+            endJob();
+            promise->addResult(std::move(result));
+        }
+        promise->finish();
+    }, Qt::QueuedConnection);
+
+    return future;
+}
+
+#endif // DATABASESERVICE_H
@@ -4,48 +4,118 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+# sqlite3_interrupt() pour interrompre une requête annulée (DatabaseService).
+# Sans les en-têtes SQLite, une requête annulée va jusqu'au bout.
+packagesExist(sqlite3) {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += sqlite3
+    DEFINES += HAVE_SQLITE3_API
+}
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
     cashpage.cpp \
+    cashrepository.cpp \
     clientdialog.cpp \
+    clientrepository.cpp \
     clientspage.cpp \
+    clienttablemodel.cpp \
     connexion.cpp \
+    countcache.cpp \
     dashboardpage.cpp \
+    databaseconfig.cpp \
+    databaseservice.cpp \
+    keysetpager.cpp \
+    lazypagestack.cpp \
     logindialog.cpp \
     main.cpp \
     mainwindow.cpp \
+    metricsengine.cpp \
     orderdialog_new.cpp \
+    orderrepository.cpp \
     orderspage.cpp \
+    ordersummary.cpp \
+    paymentrepository.cpp \
     paymentspage.cpp \
+    paymenttablemodel.cpp \
+    productcarddelegate.cpp \
     productdialog.cpp \
+    productlistmodel.cpp \
+    productrepository.cpp \
     productspage.cpp \
+    profiledapplication.cpp \
+    queryplancheck.cpp \
+    queryprofiler.cpp \
+    querystatsdialog.cpp \
+    repositoryerror.cpp \
+    rowactiondelegate.cpp \
+    saleschart.cpp \
+    salesrollup.cpp \
+    schemamigrator.cpp \
+    searchcontroller.cpp \
+    searchindex.cpp \
     sidebar.cpp \
+    statementcache.cpp \
     stylesheet.cpp \
     thememanager.cpp \
+    uiprofiler.cpp \
+    thumbnailcache.cpp \
     userdialog.cpp \
-    userspage.cpp
+    userspage.cpp \
+    usertablemodel.cpp
 
 HEADERS += \
     cashpage.h \
+    cashrepository.h \
     clientdialog.h \
+    clientrepository.h \
     clientspage.h \
+    clienttablemodel.h \
     connexion.h \
+    countcache.h \
     dashboardpage.h \
+    databaseconfig.h \
+    databaseservice.h \
+    keysetpager.h \
+    lazypagestack.h \
     logindialog.h \
     mainwindow.h \
+    metricsengine.h \
     orderdialog.h \
+    orderrepository.h \
     orderspage.h \
+    ordersummary.h \
+    paymentrepository.h \
     paymentspage.h \
+    paymenttablemodel.h \
+    productcarddelegate.h \
     productdialog.h \
+    productlistmodel.h \
+    productrepository.h \
     productspage.h \
+    profiledapplication.h \
+    queryplancheck.h \
+    queryprofiler.h \
+    querystatsdialog.h \
+    repositoryerror.h \
+    rowactiondelegate.h \
+    saleschart.h \
+    salesrollup.h \
+    schemamigrator.h \
+    searchcontroller.h \
+    searchindex.h \
     sidebar.h \
+    statementcache.h \
     stylesheet.h \
     thememanager.h \
+    uiprofiler.h \
+    thumbnailcache.h \
     userdialog.h \
-    userspage.h
+    userspage.h \
+    usertablemodel.h
 
 FORMS += \
     mainwindow.ui
@@ -0,0 +1,193 @@
+#include "keysetpager.h"
+#include <QSqlQuery>
+
+KeysetPager::KeysetPager(const QString &dateColumn, const QString &idColumn, int pageSize)
+    : m_dateColumn(dateColumn), m_idColumn(idColumn), m_pageSize(qMax(1, pageSize)),
+      m_totalRows(-1), m_dataVersion(-1), m_collectPage(-1), m_collectReversed(false), m_hasFirst(false),
+      m_hasNextPage(false)
+{
+}
+
+void KeysetPager::setFilterKey(const QString &filterKey)
+{
+    if (filterKey != m_filterKey) {
+        m_bounds.clear();
+    }
+    m_filterKey = filterKey;
+}
+
+void KeysetPager::setDataVersion(qint64 version)
+{
+    if (version != m_dataVersion) {
+        m_bounds.clear();
+    }
+    m_dataVersion = version;
+}
+
+void KeysetPager::setTotalRows(int totalRows)
+{
+    if (totalRows >= 0 && m_totalRows >= 0 && totalRows != m_totalRows) {
+        m_bounds.clear();
+    }
+    m_totalRows = totalRows;
+}
+
+void KeysetPager::reset()
+{
+    m_bounds.clear();
+}
+
+void KeysetPager::setCustomOrder(const QString &orderBy)
+{
+    if (orderBy != m_customOrder) {
+        m_bounds.clear();
+    }
+    m_customOrder = orderBy;
+}
+
+int KeysetPager::pageCount() const
+{
+    if (m_totalRows < 0) {
+        return -1;
+    }
+    return qMax(1, (m_totalRows + m_pageSize - 1) / m_pageSize);
+}
+
+KeysetPager::Strategy KeysetPager::strategyFor(int page) const
+{
+    if (!m_customOrder.isEmpty()) {
+        return page == 0 ? FirstPage : Offset;
+    }
+    if (page <= 0) {
+        return FirstPage;
+    }
+    if (m_bounds.contains(page - 1)) {
+        return SeekAfterPrevious;
+    }
+    if (m_bounds.contains(page + 1)) {
+        return SeekBeforeNext;
+    }
+    if (hasTotalRows() && page == pageCount() - 1) {
+        return LastPage;
+    }
+    return Offset;
+}
+
+QString KeysetPager::seekCondition(int page) const
+{
+    switch (strategyFor(page)) {
+    case SeekAfterPrevious:
+        return QString("(%1, %2) < (?, ?)").arg(m_dateColumn, m_idColumn);
+    case SeekBeforeNext:
+        return QString("(%1, %2) > (?, ?)").arg(m_dateColumn, m_idColumn);
+    default:
+        return "1=1";
+    }
+}
+
+QString KeysetPager::orderClause(int page) const
+{
+    if (!m_customOrder.isEmpty()) {
+        return "ORDER BY " + m_customOrder;
+    }
+    QString direction = isReversed(page) ? "ASC" : "DESC";
+    return QString("ORDER BY %1 %3, %2 %3").arg(m_dateColumn, m_idColumn, direction);
+}
+
+QString KeysetPager::limitClause(int page) const
+{
+    return strategyFor(page) == Offset ? "LIMIT ? OFFSET ?" : "LIMIT ?";
+}
+
+QVariantList KeysetPager::pageBindValues(int page) const
+{
+    QVariantList values;
+    Strategy strategy = strategyFor(page);
+    switch (strategy) {
+    case SeekAfterPrevious: {
+        const Key key = m_bounds.value(page - 1).last;
+        values << key.date << key.id;
+        break;
+    }
+    case SeekBeforeNext: {
+        const Key key = m_bounds.value(page + 1).first;
+        values << key.date << key.id;
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (strategy == LastPage) {
+        // Lue à l'envers depuis la fin : seule la taille de la dernière page compte
+        int remaining = m_totalRows - page * m_pageSize;
+        values << (remaining > 0 ? remaining : m_pageSize);
+    } else {
+        values << m_pageSize + 1;
+    }
+
+    if (strategy == Offset) {
+        values << qMax(0, page) * m_pageSize;
+    }
+    return values;
+}
+
+void KeysetPager::bindPage(QSqlQuery &query, int page) const
+{
+    const QVariantList values = pageBindValues(page);
+    for (const QVariant &value : values) {
+        query.addBindValue(value);
+    }
+}
+
+bool KeysetPager::isReversed(int page) const
+{
+    Strategy strategy = strategyFor(page);
+    return strategy == SeekBeforeNext || strategy == LastPage;
+}
+
+void KeysetPager::beginPage(int page, bool reversed, int fetchedRows)
+{
+    m_collectPage = page;
+    m_collectReversed = reversed;
+    m_hasFirst = false;
+
+    // Lue à l'envers, la page vient soit de la suivante (qui existe), soit de
+    // la fin de la liste ; sinon la ligne en trop annonce une page suivante.
+    if (reversed) {
+        m_hasNextPage = m_bounds.contains(page + 1);
+    } else {
+        m_hasNextPage = fetchedRows > m_pageSize;
+    }
+}
+
+void KeysetPager::collect(const QVariant &date, qint64 id)
+{
+    Key key;
+    key.date = date;
+    key.id = id;
+    if (!m_hasFirst) {
+        m_firstFetched = key;
+        m_hasFirst = true;
+    }
+    m_lastFetched = key;
+}
+
+void KeysetPager::endPage()
+{
+    if (m_collectPage < 0 || !m_hasFirst || !m_customOrder.isEmpty()) {
+        m_collectPage = -1;
+        return;
+    }
+
+    Bounds bounds;
+    if (m_collectReversed) {
+        bounds.first = m_lastFetched;
+        bounds.last = m_firstFetched;
+    } else {
+        bounds.first = m_firstFetched;
+        bounds.last = m_lastFetched;
+    }
+    m_bounds.insert(m_collectPage, bounds);
+    m_collectPage = -1;
+}
@@ -0,0 +1,100 @@
+#ifndef KEYSETPAGER_H
+#define KEYSETPAGER_H
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+
+class QSqlQuery;
+
+// Pagination par clé (date, id) pour les listes triées du plus récent au plus
+// ancien. Les clés de début et de fin des pages déjà affichées sont gardées :
+// première, précédente, suivante et dernière page se lisent sans OFFSET.
+//
+// Utilisation dans une page :
+//   pager.setFilterKey(cléDuFiltre);
+//   sql += pager.seekCondition(page) ... pager.orderClause(page) ... pager.limitClause(page);
+//   valeurs liées : celles des filtres, puis pager.pageBindValues(page);
+//   au retour : pager.setTotalRows(total); pager.beginPage(page, reversed, lignesLues);
+//   pour chaque ligne affichée : pager.collect(date, id); puis pager.endPage();
+//
+// Une ligne de plus que la page est lue : elle indique s'il existe une page
+// suivante sans avoir besoin du nombre total de lignes. Seules les
+// pageSize() premières lignes reçues sont affichées.
+class KeysetPager
+{
+public:
+    KeysetPager(const QString &dateColumn, const QString &idColumn, int pageSize);
+
+    // Oublie les bornes connues si le filtre, les données ou le nombre de
+    // lignes a changé. totalRows = -1 : nombre inconnu (pas encore compté).
+    void setFilterKey(const QString &filterKey);
+    void setDataVersion(qint64 version);
+    void setTotalRows(int totalRows);
+    void reset();
+
+    // Tri imposé (ex. pertinence d'une recherche) : retombe sur LIMIT/OFFSET
+    void setCustomOrder(const QString &orderBy);
+
+    int pageSize() const { return m_pageSize; }
+    int totalRows() const { return m_totalRows; }
+    bool hasTotalRows() const { return m_totalRows >= 0; }
+    int pageCount() const;
+
+    // Fragments SQL de la page demandée (index à partir de 0)
+    QString seekCondition(int page) const;
+    QString orderClause(int page) const;
+    QString limitClause(int page) const;
+    QVariantList pageBindValues(int page) const;
+    void bindPage(QSqlQuery &query, int page) const;
+
+    // Vrai si la page est lue en ordre croissant : les lignes arrivent à
+    // l'envers et doivent être insérées en tête du tableau.
+    bool isReversed(int page) const;
+
+    // reversed : valeur de isReversed() au moment où la requête a été construite
+    void beginPage(int page, bool reversed, int fetchedRows);
+    void collect(const QVariant &date, qint64 id);
+    void endPage();
+    int visibleRows(int fetchedRows) const { return qMin(fetchedRows, m_pageSize); }
+    bool hasNextPage() const { return m_hasNextPage; }
+
+private:
+    enum Strategy {
+        FirstPage,
+        SeekAfterPrevious,
+        SeekBeforeNext,
+        LastPage,
+        Offset
+    };
+
+    struct Key {
+        QVariant date;
+        qint64 id = 0;
+    };
+
+    struct Bounds {
+        Key first;
+        Key last;
+    };
+
+    Strategy strategyFor(int page) const;
+
+    QString m_dateColumn;
+    QString m_idColumn;
+    int m_pageSize;
+    int m_totalRows;
+    qint64 m_dataVersion;
+    QString m_filterKey;
+    QString m_customOrder;
+    QHash<int, Bounds> m_bounds;
+
+    int m_collectPage;
+    bool m_collectReversed;
+    bool m_hasFirst;
+    bool m_hasNextPage;
+    Key m_firstFetched;
+    Key m_lastFetched;
+};
+
+#endif // KEYSETPAGER_H
@@ -0,0 +1,81 @@
+#include "lazypagestack.h"
+#include "uiprofiler.h"
+
+LazyPageStack::LazyPageStack(QWidget *parent)
+    : QStackedWidget(parent)
+{
+}
+
+int LazyPageStack::addLazyPage(Factory create, Refresh refresh, RefreshPolicy policy)
+{
+    Entry entry;
+    entry.create = std::move(create);
+    entry.refresh = std::move(refresh);
+    entry.policy = policy;
+    m_entries.append(entry);
+
+    // Place réservée : l'index de la page ne change pas à sa construction
+    return addWidget(new QWidget(this));
+}
+
+QWidget *LazyPageStack::builtPage(int index) const
+{
+    if (index < 0 || index >= m_entries.size()) {
+        return nullptr;
+    }
+    return m_entries.at(index).page;
+}
+
+void LazyPageStack::markStale(int index)
+{
+    if (index < 0 || index >= m_entries.size()) {
+        return;
+    }
+    Entry &entry = m_entries[index];
+    if (!entry.page || !entry.refresh) {
+        return; // Sera lue à jour à sa construction
+    }
+    if (index == currentIndex()) {
+        entry.stale = false;
+        entry.refresh(entry.page);
+    } else {
+        entry.stale = true;
+    }
+}
+
+void LazyPageStack::showPage(int index)
+{
+    if (index < 0 || index >= m_entries.size()) {
+        return;
+    }
+
+    Entry &entry = m_entries[index];
+    bool created = !entry.page;
+    ensurePage(index);
+    setCurrentIndex(index);
+
+    // Une page qui vient d'être construite a déjà lancé sa première lecture
+    if (!created && entry.refresh && (entry.stale || entry.policy == RefreshOnShow)) {
+        entry.stale = false;
+        entry.refresh(entry.page);
+    }
+}
+
+QWidget *LazyPageStack::ensurePage(int index)
+{
+    Entry &entry = m_entries[index];
+    if (entry.page) {
+        return entry.page;
+    }
+
+    UiProfiler::Scope scope("LazyPageStack::ensurePage");
+
+    QWidget *placeholder = widget(index);
+    entry.page = entry.create();
+    insertWidget(index, entry.page);
+    removeWidget(placeholder);
+    placeholder->deleteLater();
+
+    emit pageCreated(index, entry.page);
+    return entry.page;
+}
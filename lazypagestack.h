@@ -0,0 +1,65 @@
+#ifndef LAZYPAGESTACK_H
+#define LAZYPAGESTACK_H
+
+#include <QStackedWidget>
+#include <QVector>
+#include <functional>
+
+// Pile de pages construites à la première sélection. Tant qu'une page n'a
+// pas été affichée, un widget vide occupe sa place : ni son interface ni
+// ses lectures en base ne coûtent quoi que ce soit au démarrage.
+//
+// Une page déjà construite n'est rechargée que lorsqu'elle est visible :
+// markStale() la recharge tout de suite si elle est affichée, sinon à son
+// prochain affichage (RefreshWhenStale). RefreshOnShow recharge à chaque
+// affichage.
+class LazyPageStack : public QStackedWidget
+{
+    Q_OBJECT
+
+public:
+    enum RefreshPolicy {
+        RefreshWhenStale,
+        RefreshOnShow
+    };
+
+    using Factory = std::function<QWidget *()>;
+    using Refresh = std::function<void(QWidget *)>;
+
+    explicit LazyPageStack(QWidget *parent = nullptr);
+
+    // Retourne l'index de la page, celui qu'utilise la sidebar. Sans refresh,
+    // la page ne se relit qu'elle-même (après ses propres modifications).
+    int addLazyPage(Factory create, Refresh refresh, RefreshPolicy policy = RefreshWhenStale);
+
+    // Page construite, ou nullptr tant qu'elle n'a jamais été affichée
+    QWidget *builtPage(int index) const;
+
+    template <typename T>
+    T *builtPageAs(int index) const { return qobject_cast<T *>(builtPage(index)); }
+
+    void markStale(int index);
+
+public slots:
+    void showPage(int index);
+
+signals:
+    // Émis une fois par page, juste après sa construction : l'appelant y
+    // branche les signaux de la page
+    void pageCreated(int index, QWidget *page);
+
+private:
+    struct Entry {
+        Factory create;
+        Refresh refresh;
+        RefreshPolicy policy = RefreshWhenStale;
+        QWidget *page = nullptr;
+        bool stale = false;
+    };
+
+    QWidget *ensurePage(int index);
+
+    QVector<Entry> m_entries;
+};
+
+#endif // LAZYPAGESTACK_H
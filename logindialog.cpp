@@ -1,4 +1,5 @@
 #include "logindialog.h"
+#include "queryprofiler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QSqlQuery>
@@ -11,6 +12,7 @@ LoginDialog::LoginDialog(QWidget *parent) :
     QDialog(parent),
     userId(-1)
 {
+    setObjectName("loginDialog");
     setWindowTitle("Connexion");
     setModal(true);
 
@@ -18,7 +20,7 @@ LoginDialog::LoginDialog(QWidget *parent) :
 
     QLabel *titleLabel = new QLabel("Connexion à l'application");
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("font-size: 18px; font-weight: bold;");
+    titleLabel->setObjectName("loginTitle");
     layout->addWidget(titleLabel);
 
     QHBoxLayout *emailLayout = new QHBoxLayout();
@@ -47,7 +49,7 @@ LoginDialog::LoginDialog(QWidget *parent) :
     layout->addWidget(loginButton);
 
     errorLabel = new QLabel("");
-    errorLabel->setStyleSheet("color: red;");
+    errorLabel->setObjectName("loginError");
     layout->addWidget(errorLabel);
 
     setLayout(layout);
@@ -57,6 +59,19 @@ LoginDialog::~LoginDialog()
 {
 }
 
+QString LoginDialog::styleRules()
+{
+    return QString(
+        "#loginDialog QLabel#loginTitle {"
+        "   font-size: 18px;"
+        "   font-weight: bold;"
+        "}"
+        "#loginDialog QLabel#loginError {"
+        "   color: red;"
+        "}"
+    );
+}
+
 void LoginDialog::onLoginClicked()
 {
     QString email = emailEdit->text().trimmed();
@@ -74,17 +89,22 @@ void LoginDialog::onLoginClicked()
     }
 }
 
+QString LoginDialog::credentialsSql()
+{
+    return "SELECT id_user, role FROM USERS WHERE email = ? AND mot_de_passe = ? AND actif = 1";
+}
+
 bool LoginDialog::authenticate(const QString &email, const QString &password)
 {
     // Hacher le mot de passe
     QByteArray hashedPassword = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex();
 
     QSqlQuery query;
-    query.prepare("SELECT id_user, role FROM USERS WHERE email = ? AND mot_de_passe = ? AND actif = 1");
+    query.prepare(credentialsSql());
     query.addBindValue(email);
     query.addBindValue(QString(hashedPassword));
 
-    if (!query.exec()) {
+    if (!QueryProfiler::exec(query)) {
         qDebug() << "Erreur lors de l'authentification:" << query.lastError().text();
         return false;
     }
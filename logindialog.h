@@ -14,6 +14,10 @@ public:
     explicit LoginDialog(QWidget *parent = nullptr);
     ~LoginDialog();
 
+    static QString styleRules();
+    // Requête de connexion, vérifiée par QueryPlanCheck
+    static QString credentialsSql();
+
     QString getUserRole() const { return userRole; }
     int getUserId() const { return userId; }
 
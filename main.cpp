@@ -1,23 +1,59 @@
 #include "mainwindow.h"
 #include "connexion.h"
-#include "stylesheet.h"
+#include "thememanager.h"
 #include "logindialog.h"
+#include "databaseservice.h"
+#include "statementcache.h"
+#include "salesrollup.h"
+#include "queryplancheck.h"
+#include "queryprofiler.h"
+#include "profiledapplication.h"
+#include "uiprofiler.h"
 
-#include <QApplication>
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
 
 int main(int argc, char *argv[])
 {
-    QApplication a(argc, argv);
+    ProfiledApplication a(argc, argv);
 
-    // Appliquer le style global
-    a.setStyleSheet(StyleSheet::getStyleSheet());
-    qDebug() << "QSS appliqué, longueur:" << StyleSheet::getStyleSheet().length();
+    // gestionVenteMateriel --profile-ui : blocages, images et portions
+    // mesurées, écrits à la fermeture dans ui_trace.json à côté de la base
+    if (a.arguments().contains("--profile-ui")) {
+        UiProfiler::instance().start();
+    }
+
+    // Appliquer le style global : palette du thème et feuille compilée une
+    // fois pour toute l'application, fenêtre de connexion comprise
+    ThemeManager::instance().applyToApplication();
 
     if (!Connexion::createConnection()) {
         return -1;
     }
 
+    // gestionVenteMateriel --rebuild-rollups : recalcule les agrégats de
+    // ventes depuis l'historique des commandes, puis quitte
+    if (a.arguments().contains("--rebuild-rollups")) {
+        bool rebuilt = SalesRollup::rebuild();
+        if (rebuilt) {
+            qDebug() << "Agrégats de ventes reconstruits.";
+        } else {
+            qDebug() << "Erreur lors de la reconstruction des agrégats:" << SalesRollup::lastError();
+        }
+        StatementCache::clear(QSqlDatabase::defaultConnection);
+        return rebuilt ? 0 : 1;
+    }
+
+    // gestionVenteMateriel --check-query-plans : vérifie que les requêtes
+    // fréquentes passent par un index, puis quitte
+    if (a.arguments().contains("--check-query-plans")) {
+        bool indexed = QueryPlanCheck::run();
+        qDebug() << (indexed ? "Toutes les requêtes fréquentes utilisent un index."
+                             : "Des requêtes fréquentes parcourent une table entière.");
+        return indexed ? 0 : 1;
+    }
+
     while (true) {
         LoginDialog loginDialog;
         if (loginDialog.exec() != QDialog::Accepted) {
@@ -43,5 +79,17 @@ int main(int argc, char *argv[])
         }
     }
 
+    // gestionVenteMateriel --query-stats : requêtes les plus coûteuses de
+    // la session, affichées à la fermeture
+    if (a.arguments().contains("--query-stats")) {
+        qDebug().noquote() << QueryProfiler::report(20);
+    }
+
+    if (UiProfiler::instance().isRunning()) {
+        UiProfiler::instance().stop(QFileInfo(Connexion::config().path).absoluteDir().filePath("ui_trace.json"));
+    }
+
+    DatabaseService::instance().shutdown();
+    StatementCache::clear(QSqlDatabase::defaultConnection);
     return 0;
 }
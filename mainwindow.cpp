@@ -6,6 +6,7 @@
 #include <QDebug>
 #include <QApplication>
 #include <QPalette>
+#include <QShortcut>
 #include "dashboardpage.h"
 #include "userspage.h"
 #include "clientspage.h"
@@ -13,6 +14,8 @@
 #include "orderspage.h"
 #include "paymentspage.h"
 #include "cashpage.h"
+#include "lazypagestack.h"
+#include "querystatsdialog.h"
 
 MainWindow::MainWindow(const QString &userRole, int userId, QWidget *parent)
     : QMainWindow(parent)
@@ -35,50 +38,65 @@ MainWindow::MainWindow(const QString &userRole, int userId, QWidget *parent)
     sidebar = new Sidebar(userRole, this);
     mainLayout->addWidget(sidebar);
 
-    // Créer le stacked widget pour les pages
-    stackedWidget = new QStackedWidget(this);
-    mainLayout->addWidget(stackedWidget, 1);
+    // Les pages sont construites à leur première sélection : l'ouverture de
+    // la fenêtre ne dépend plus du volume de produits ou de commandes
+    pageStack = new LazyPageStack(this);
+    mainLayout->addWidget(pageStack, 1);
 
-    // Ajouter le Dashboard en premier
-    DashboardPage *dashboardPage = new DashboardPage(this);
-    stackedWidget->addWidget(dashboardPage);
+    // Même ordre que les boutons de la sidebar
+    dashboardPageIndex = pageStack->addLazyPage(
+        [this]() { return new DashboardPage(this); },
+        [](QWidget *page) { static_cast<DashboardPage *>(page)->refreshMetrics(); },
+        LazyPageStack::RefreshOnShow);
 
-    // Ajouter les pages modulaires selon le rôle
     if (userRole != "VENDEUR") {
-        UsersPage *usersPage = new UsersPage(this);
-        stackedWidget->addWidget(usersPage);
+        pageStack->addLazyPage([this]() { return new UsersPage(this); }, nullptr);
     }
 
-    ClientsPage *clientsPage = new ClientsPage(this);
-    this->clientsPage = clientsPage;
-    stackedWidget->addWidget(clientsPage);
+    pageStack->addLazyPage([this]() { return new ClientsPage(this); }, nullptr);
 
-    productsPage = new ProductsPage(userRole, currentUserId, this);
-    stackedWidget->addWidget(productsPage);
+    productsPageIndex = pageStack->addLazyPage(
+        [this, userRole]() { return new ProductsPage(userRole, currentUserId, this); },
+        [](QWidget *page) { static_cast<ProductsPage *>(page)->loadProducts(); });
 
-    ordersPage = new OrdersPage(userRole, currentUserId, this);
-    stackedWidget->addWidget(ordersPage);
-    ordersPageIndex = stackedWidget->indexOf(ordersPage);
+    ordersPageIndex = pageStack->addLazyPage(
+        [this, userRole]() { return new OrdersPage(userRole, currentUserId, this); },
+        [](QWidget *page) { static_cast<OrdersPage *>(page)->loadOrders(); },
+        LazyPageStack::RefreshOnShow);
 
-    PaymentsPage *paymentsPage = new PaymentsPage(this);
-    stackedWidget->addWidget(paymentsPage);
+    paymentsPageIndex = pageStack->addLazyPage(
+        [this]() { return new PaymentsPage(this); },
+        [](QWidget *page) { static_cast<PaymentsPage *>(page)->loadPayments(); });
 
+    cashPageIndex = -1;
     if (userRole != "VENDEUR") {
-        CashPage *cashPage = new CashPage(this);
-        stackedWidget->addWidget(cashPage);
+        cashPageIndex = pageStack->addLazyPage(
+            [this]() { return new CashPage(currentUserId, this); },
+            [](QWidget *page) { static_cast<CashPage *>(page)->loadSession(); });
     }
 
-    connect(sidebar, &Sidebar::pageChanged, stackedWidget, &QStackedWidget::setCurrentIndex);
+    connect(pageStack, &LazyPageStack::pageCreated, this, &MainWindow::onPageCreated);
+    connect(sidebar, &Sidebar::pageChanged, pageStack, &LazyPageStack::showPage);
+    connect(sidebar, &Sidebar::themeToggled, this, &MainWindow::onThemeToggled);
     connect(sidebar, &Sidebar::logoutRequested, this, &MainWindow::onLogoutRequested);
-    connect(stackedWidget, &QStackedWidget::currentChanged, this, &MainWindow::onPageChanged);
-    connect(productsPage, &ProductsPage::orderValidated, ordersPage, &OrdersPage::loadOrders);
-    connect(productsPage, &ProductsPage::orderValidated, productsPage, &ProductsPage::loadProducts);
 
-    ThemeManager& themeManager = ThemeManager::instance();
-    connect(&themeManager, &ThemeManager::themeChanged, this, &MainWindow::onThemeChanged);
+    // Diagnostic des requêtes SQL, sans entrée dans la sidebar
+    if (userRole == "ADMIN") {
+        QShortcut *diagnostics = new QShortcut(QKeySequence("Ctrl+Shift+D"), this);
+        connect(diagnostics, &QShortcut::activated, this, [this]() {
+            QueryStatsDialog dialog(this);
+            dialog.exec();
+        });
+    }
 
-    // Appliquer le thème initial
+    // Feuille et palette sont déjà installées (main.cpp) : ne reste qu'à
+    // marquer la fenêtre du thème courant. Les changements suivants passent
+    // par ThemeManager, qui change la palette et repolit : aucune page n'est
+    // reconstruite ni relue.
     applyTheme();
+
+    // Seule page construite à l'ouverture
+    pageStack->showPage(dashboardPageIndex);
 }
 
 void MainWindow::onLogoutRequested()
@@ -87,60 +105,37 @@ void MainWindow::onLogoutRequested()
     close();
 }
 
-void MainWindow::onPageChanged(int index)
+void MainWindow::onPageCreated(int index, QWidget *page)
 {
-    if (index == ordersPageIndex) {
-        ordersPage->loadOrders();
+    // Une vente ou une annulation touche le stock, les commandes, les
+    // indicateurs, les paiements et la caisse : seules les pages visibles
+    // sont relues tout de suite, les autres à leur prochain affichage
+    if (index == productsPageIndex) {
+        connect(static_cast<ProductsPage *>(page), &ProductsPage::orderValidated, this, [this]() {
+            pageStack->markStale(productsPageIndex);
+            pageStack->markStale(ordersPageIndex);
+            pageStack->markStale(dashboardPageIndex);
+            pageStack->markStale(paymentsPageIndex);
+            pageStack->markStale(cashPageIndex);
+        });
+    } else if (index == ordersPageIndex) {
+        connect(static_cast<OrdersPage *>(page), &OrdersPage::orderCancelled, this, [this]() {
+            pageStack->markStale(productsPageIndex);
+            pageStack->markStale(dashboardPageIndex);
+            pageStack->markStale(paymentsPageIndex);
+            pageStack->markStale(cashPageIndex);
+        });
     }
 }
 
 void MainWindow::onThemeToggled()
 {
-    applyThemeToAllPages();
-}
-
-void MainWindow::onThemeChanged(ThemeManager::Theme theme)
-{
-    applyThemeToAllPages();
+    ThemeManager::instance().toggleTheme();
 }
 
 void MainWindow::applyTheme()
 {
-    ThemeManager& themeManager = ThemeManager::instance();
-    
-    QString completeStyle = themeManager.getCompleteStylesheet();
-    qApp->setStyleSheet(completeStyle);
-    
-    setStyleSheet(QString(
-        "QMainWindow, QDialog, QWidget, QFrame {"
-        "   background: %1;"
-        "   color: %2;"
-        "   font-family: 'Segoe UI', system-ui, -apple-system, sans-serif;"
-        "}"
-    ).arg(themeManager.backgroundColor().name(), 
-          themeManager.textColor().name()));
-    
-    update();
-    qApp->processEvents();
-}
-
-void MainWindow::applyThemeToAllPages()
-{
-    applyTheme();
-    
-    if (sidebar) {
-        sidebar->updateTheme();
-    }
-    
-    if (clientsPage) {
-        clientsPage->onThemeChanged();
-    }
-    if (productsPage) {
-        productsPage->loadProducts();
-    }
-    if (ordersPage) {
-        ordersPage->loadOrders();
-    }
+    ThemeManager::instance().applyToApplication();
 }
 
 MainWindow::~MainWindow()
@@ -2,7 +2,6 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QStackedWidget>
 #include "sidebar.h"
 #include "thememanager.h"
 
@@ -17,6 +16,7 @@ class ProductsPage;
 class OrdersPage;
 class PaymentsPage;
 class CashPage;
+class LazyPageStack;
 
 class MainWindow : public QMainWindow
 {
@@ -28,22 +28,21 @@ public:
 
 private slots:
     void onLogoutRequested();
-    void onPageChanged(int index);
+    void onPageCreated(int index, QWidget *page);
     void onThemeToggled();
-    void onThemeChanged(ThemeManager::Theme theme);
 
 private:
     void applyTheme();
-    void applyThemeToAllPages();
 
     Ui::MainWindow *ui;
     Sidebar *sidebar;
-    QStackedWidget *stackedWidget;
+    LazyPageStack *pageStack;
     int currentUserId;
+    int dashboardPageIndex;
+    int productsPageIndex;
     int ordersPageIndex;
-    ProductsPage *productsPage;
-    OrdersPage *ordersPage;
-    ClientsPage *clientsPage;
+    int paymentsPageIndex;
+    int cashPageIndex;          // -1 pour un vendeur
 
 signals:
     void logoutRequested();
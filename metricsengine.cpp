@@ -0,0 +1,217 @@
+#include "metricsengine.h"
+#include "queryprofiler.h"
+#include "schemamigrator.h"
+#include "statementcache.h"
+#include <QHash>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+const QString DayOf = "date(%1.date_commande, 'localtime')";
+const QString HourOf = "strftime('%Y-%m-%d %H:00:00', %1.date_commande, 'localtime')";
+
+// Ajoute / retire une commande de la table de ventes table, clé bucketOf
+QString addSale(const QString &table, const QString &key, const QString &bucketOf, const QString &row)
+{
+    return QString("INSERT INTO %1 (%2, nb_commandes, chiffre_affaires) "
+                   "VALUES (%3, 1, COALESCE(%4.total, 0)) "
+                   "ON CONFLICT(%2) DO UPDATE SET nb_commandes = nb_commandes + 1, "
+                   "chiffre_affaires = chiffre_affaires + excluded.chiffre_affaires; ")
+        .arg(table, key, bucketOf.arg(row), row);
+}
+
+QString removeSale(const QString &table, const QString &key, const QString &bucketOf, const QString &row)
+{
+    return QString("UPDATE %1 SET nb_commandes = nb_commandes - 1, "
+                   "chiffre_affaires = chiffre_affaires - COALESCE(%4.total, 0) "
+                   "WHERE %2 = %3; ")
+        .arg(table, key, bucketOf.arg(row), row);
+}
+
+QString addSales(const QString &row)
+{
+    return addSale("DAILY_SALES", "jour", DayOf, row) + addSale("HOURLY_SALES", "heure", HourOf, row);
+}
+
+QString removeSales(const QString &row)
+{
+    return removeSale("DAILY_SALES", "jour", DayOf, row) + removeSale("HOURLY_SALES", "heure", HourOf, row);
+}
+
+void addTo(PeriodSales &period, int orders, double revenue)
+{
+    period.orders += orders;
+    period.revenue += revenue;
+}
+}
+
+MetricsEngine::MetricsEngine() {}
+
+QStringList MetricsEngine::createStatements()
+{
+    bool backfillDays = !SchemaMigrator::tableExists("DAILY_SALES");
+    bool backfillHours = !SchemaMigrator::tableExists("HOURLY_SALES");
+
+    QStringList statements = {
+        "CREATE TABLE IF NOT EXISTS DAILY_SALES ("
+        "jour TEXT PRIMARY KEY, "
+        "nb_commandes INTEGER NOT NULL DEFAULT 0, "
+        "chiffre_affaires REAL NOT NULL DEFAULT 0)",
+
+        "CREATE TABLE IF NOT EXISTS HOURLY_SALES ("
+        "heure TEXT PRIMARY KEY, "
+        "nb_commandes INTEGER NOT NULL DEFAULT 0, "
+        "chiffre_affaires REAL NOT NULL DEFAULT 0)",
+
+        // Index partiel : ne contient que les produits à réapprovisionner
+        "CREATE INDEX IF NOT EXISTS idx_produits_alerte ON PRODUITS(id_produit) WHERE stock <= seuil_alerte",
+
+        // Les triggers DAILY_SALES_* alimentent aussi HOURLY_SALES
+        "CREATE TRIGGER DAILY_SALES_AI AFTER INSERT ON COMMANDES "
+        "WHEN NEW.statut = 'PAYEE' BEGIN " + addSales("NEW") + "END",
+
+        // Une modification retire l'ancienne vente puis ajoute la nouvelle
+        "CREATE TRIGGER DAILY_SALES_AU_OLD AFTER UPDATE OF date_commande, statut, total ON COMMANDES "
+        "WHEN OLD.statut = 'PAYEE' BEGIN " + removeSales("OLD") + "END",
+
+        "CREATE TRIGGER DAILY_SALES_AU_NEW AFTER UPDATE OF date_commande, statut, total ON COMMANDES "
+        "WHEN NEW.statut = 'PAYEE' BEGIN " + addSales("NEW") + "END",
+
+        "CREATE TRIGGER DAILY_SALES_AD AFTER DELETE ON COMMANDES "
+        "WHEN OLD.statut = 'PAYEE' BEGIN " + removeSales("OLD") + "END"
+    };
+    if (backfillDays || backfillHours) {
+        statements << rebuildStatements();
+    }
+    return statements;
+}
+
+QStringList MetricsEngine::rebuildStatements()
+{
+    return {
+        "DELETE FROM DAILY_SALES",
+        "INSERT INTO DAILY_SALES (jour, nb_commandes, chiffre_affaires) "
+        "SELECT date(date_commande, 'localtime'), COUNT(*), COALESCE(SUM(total), 0) "
+        "FROM COMMANDES WHERE statut = 'PAYEE' GROUP BY 1",
+
+        "DELETE FROM HOURLY_SALES",
+        "INSERT INTO HOURLY_SALES (heure, nb_commandes, chiffre_affaires) "
+        "SELECT strftime('%Y-%m-%d %H:00:00', date_commande, 'localtime'), COUNT(*), "
+        "COALESCE(SUM(total), 0) FROM COMMANDES WHERE statut = 'PAYEE' GROUP BY 1"
+    };
+}
+
+QString MetricsEngine::dailySalesSql()
+{
+    return "SELECT jour, nb_commandes, chiffre_affaires FROM DAILY_SALES WHERE jour BETWEEN ? AND ?";
+}
+
+QString MetricsEngine::lowStockSql()
+{
+    return "SELECT COUNT(*) FROM PRODUITS WHERE stock <= seuil_alerte";
+}
+
+DashboardMetrics MetricsEngine::compute(QSqlDatabase &db, const QDate &today)
+{
+    DashboardMetrics metrics;
+    const QDate first = today.addDays(-59);
+
+    QSqlQuery *sales = StatementCache::prepared(db, dailySalesSql(), &metrics.error);
+    if (!sales) {
+        return metrics;
+    }
+    sales->bindValue(0, first.toString(Qt::ISODate));
+    sales->bindValue(1, today.toString(Qt::ISODate));
+    if (!QueryProfiler::exec(*sales)) {
+        metrics.error = sales->lastError().text();
+        qDebug() << "Erreur lors du calcul des statistiques:" << metrics.error;
+        return metrics;
+    }
+
+    while (sales->next()) {
+        const qint64 age = QDate::fromString(sales->value(0).toString(), Qt::ISODate).daysTo(today);
+        const int orders = sales->value(1).toInt();
+        const double revenue = sales->value(2).toDouble();
+
+        if (age == 0) {
+            addTo(metrics.today, orders, revenue);
+        } else if (age == 1) {
+            addTo(metrics.yesterday, orders, revenue);
+        }
+        if (age < 7) {
+            addTo(metrics.week, orders, revenue);
+        } else if (age < 14) {
+            addTo(metrics.previousWeek, orders, revenue);
+        }
+        if (age < 30) {
+            addTo(metrics.month, orders, revenue);
+        } else {
+            addTo(metrics.previousMonth, orders, revenue);
+        }
+    }
+    sales->finish();
+
+    QSqlQuery *lowStock = StatementCache::prepared(db, lowStockSql(), &metrics.error);
+    if (!lowStock) {
+        return metrics;
+    }
+    if (!QueryProfiler::exec(*lowStock) || !lowStock->next()) {
+        metrics.error = lowStock->lastError().text();
+        qDebug() << "Erreur lors du comptage des stocks bas:" << metrics.error;
+        lowStock->finish();
+        return metrics;
+    }
+    metrics.lowStockProducts = lowStock->value(0).toInt();
+    lowStock->finish();
+
+    metrics.ok = true;
+    return metrics;
+}
+
+QVector<SalesBucket> MetricsEngine::salesSeries(QSqlDatabase &db, const QDateTime &from, const QDateTime &to,
+                                                Granularity granularity, QString *error)
+{
+    QVector<SalesBucket> buckets;
+    const bool hourly = granularity == Hourly;
+
+    // Bornes alignées sur le début du créneau qui les contient
+    QDateTime start = hourly ? QDateTime(from.date(), QTime(from.time().hour(), 0))
+                             : QDateTime(from.date(), QTime(0, 0));
+    const QString keyFormat = hourly ? "yyyy-MM-dd HH:00:00" : "yyyy-MM-dd";
+
+    QSqlQuery *query = StatementCache::prepared(db, hourly
+        ? "SELECT heure, nb_commandes, chiffre_affaires FROM HOURLY_SALES WHERE heure BETWEEN ? AND ? ORDER BY heure"
+        : "SELECT jour, nb_commandes, chiffre_affaires FROM DAILY_SALES WHERE jour BETWEEN ? AND ? ORDER BY jour",
+        error);
+    if (!query) {
+        return buckets;
+    }
+    query->bindValue(0, start.toString(keyFormat));
+    query->bindValue(1, to.toString(keyFormat));
+    if (!QueryProfiler::exec(*query)) {
+        if (error) {
+            *error = query->lastError().text();
+        }
+        qDebug() << "Erreur lors de la lecture des ventes:" << query->lastError().text();
+        return buckets;
+    }
+
+    QHash<QString, SalesBucket> stored;
+    while (query->next()) {
+        SalesBucket bucket;
+        bucket.orders = query->value(1).toInt();
+        bucket.revenue = query->value(2).toDouble();
+        stored.insert(query->value(0).toString(), bucket);
+    }
+    query->finish();
+
+    // Créneaux sans vente à zéro : la courbe ne relie pas deux ventes éloignées
+    for (QDateTime bucketStart = start; bucketStart <= to;
+         bucketStart = hourly ? bucketStart.addSecs(3600) : bucketStart.addDays(1)) {
+        SalesBucket bucket = stored.value(bucketStart.toString(keyFormat));
+        bucket.start = bucketStart;
+        buckets.append(bucket);
+    }
+    return buckets;
+}
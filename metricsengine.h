@@ -0,0 +1,76 @@
+#ifndef METRICSENGINE_H
+#define METRICSENGINE_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Ventes payées sur une période (bornes incluses)
+struct PeriodSales
+{
+    int orders = 0;
+    double revenue = 0.0;
+
+    double averageBasket() const { return orders > 0 ? revenue / orders : 0.0; }
+};
+
+// Indicateurs du tableau de bord : jour, 7 derniers jours et 30 derniers
+// jours, chacun avec la période précédente de même durée pour la tendance.
+struct DashboardMetrics
+{
+    bool ok = false;
+    QString error;
+    PeriodSales today;
+    PeriodSales yesterday;
+    PeriodSales week;
+    PeriodSales previousWeek;
+    PeriodSales month;
+    PeriodSales previousMonth;
+    int lowStockProducts = 0;
+};
+
+// Ventes payées d'un créneau (heure ou jour) commençant à start
+struct SalesBucket
+{
+    QDateTime start;
+    int orders = 0;
+    double revenue = 0.0;
+};
+
+// Tables DAILY_SALES (une ligne par jour) et HOURLY_SALES (une ligne par
+// heure), en heure locale, avec le nombre et le montant des commandes payées.
+// Les mêmes triggers sur COMMANDES tiennent les deux tables à jour ; les
+// indicateurs lisent au plus 60 lignes au lieu de parcourir l'historique.
+// Les produits sous le seuil d'alerte sont comptés par un index partiel.
+class MetricsEngine
+{
+public:
+    enum Granularity {
+        Hourly,
+        Daily
+    };
+
+    MetricsEngine();
+
+    // Tables, index et triggers (migration du schéma)
+    static QStringList createStatements();
+
+    // Vide DAILY_SALES / HOURLY_SALES et les recalcule depuis COMMANDES,
+    // dans la transaction de l'appelant
+    static QStringList rebuildStatements();
+
+    // À exécuter sur le thread base de données (DatabaseService::run)
+    static DashboardMetrics compute(QSqlDatabase &db, const QDate &today);
+    // Requêtes de compute(), vérifiées par QueryPlanCheck
+    static QString dailySalesSql();
+    static QString lowStockSql();
+
+    // Un créneau par heure ou par jour entre from et to, créneaux vides compris
+    static QVector<SalesBucket> salesSeries(QSqlDatabase &db, const QDateTime &from, const QDateTime &to,
+                                            Granularity granularity, QString *error = nullptr);
+};
+
+#endif // METRICSENGINE_H
@@ -11,15 +11,9 @@
 #include <QLineEdit>
 #include <QTextEdit>
 #include <QMap>
+#include <QHash>
 #include <QSqlQuery>
-
-struct OrderItem {
-    int productId;
-    QString productName;
-    double unitPrice;
-    int quantity;
-    double total;
-};
+#include "orderrepository.h"
 
 class OrderDialog : public QDialog
 {
@@ -30,10 +24,15 @@ public:
     explicit OrderDialog(int userId, const QString &commandeId, QWidget *parent = nullptr);
     ~OrderDialog();
 
+    static QString styleRules();
+
     void addProduct(int productId, const QString &productName, double unitPrice, int quantity = 1);
     void removeProduct(int productId, int quantity = 1);
     double getTotal() const;
-    bool checkStocks();
+    // false si un produit manque de stock (voir stockShortageSummary) ou si
+    // la vérification a échoué : *queryError est alors vrai
+    bool checkStocks(bool *queryError);
+    QString stockShortageSummary() const;
     void reset();
     void resetUI();
 
@@ -57,7 +56,6 @@ private:
     void setupPaymentForm();
     void updateTotal();
     void updateTable();
-    void createTablesIfNotExist();
     bool saveClientAndOrder();
     void loadOrderForEdit(const QString &commandeId);
 
@@ -87,6 +85,7 @@ private:
     QPushButton *previousPaymentBtn;
 
     QMap<int, OrderItem> orderItems; // productId -> OrderItem
+    QHash<int, int> stockShortages;  // productId -> stock disponible
     double totalAmount;
     int currentUserId;
     bool isEditMode;
@@ -1,4 +1,7 @@
 #include "orderdialog.h"
+#include "productrepository.h"
+#include "thememanager.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -6,17 +9,20 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QMessageBox>
+#include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QDebug>
 
 OrderDialog::OrderDialog(int userId, QWidget *parent) :
     QDialog(parent), totalAmount(0.0), currentUserId(userId)
 {
+    UiProfiler::Scope scope("OrderDialog::OrderDialog");
     setWindowTitle("Nouvelle commande");
     setModal(true);
     setMinimumWidth(700);
     setMinimumHeight(500);
-    setStyleSheet("background: #0f172a; color: #f1f5f9;");
+    setObjectName("orderDialog");
 
     // Positionner le modal à droite de la fenêtre parente
     if (parent) {
@@ -25,7 +31,6 @@ OrderDialog::OrderDialog(int userId, QWidget *parent) :
         move(parentPos.x() + parentSize.width() + 10, parentPos.y());
     }
 
-    createTablesIfNotExist();
     setupUI();
 }
 
@@ -36,11 +41,12 @@ OrderDialog::~OrderDialog()
 OrderDialog::OrderDialog(int userId, const QString &commandeId, QWidget *parent) :
     QDialog(parent), totalAmount(0.0), currentUserId(userId), isEditMode(true), editCommandeId(commandeId)
 {
+    UiProfiler::Scope scope("OrderDialog::OrderDialog");
     setWindowTitle("Modifier commande");
     setModal(true);
     setMinimumWidth(700);
     setMinimumHeight(500);
-    setStyleSheet("background: #0f172a; color: #f1f5f9;");
+    setObjectName("orderDialog");
 
     // Positionner le modal à droite de la fenêtre parente
     if (parent) {
@@ -48,57 +54,10 @@ OrderDialog::OrderDialog(int userId, const QString &commandeId, QWidget *parent)
         move(pos);
     }
 
-    createTablesIfNotExist();
     setupUI();
     loadOrderForEdit(commandeId);
 }
 
-void OrderDialog::createTablesIfNotExist()
-{
-    QSqlQuery query;
-
-    // Table CLIENTS
-    query.exec("CREATE TABLE IF NOT EXISTS CLIENTS ("
-               "id_client INTEGER PRIMARY KEY AUTOINCREMENT, "
-               "nom TEXT NOT NULL, "
-               "prenom TEXT, "
-               "telephone TEXT, "
-               "email TEXT, "
-               "adresse TEXT, "
-               "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP)");
-
-    // Table COMMANDES
-    query.exec("CREATE TABLE IF NOT EXISTS COMMANDES ("
-               "id_commande INTEGER PRIMARY KEY AUTOINCREMENT, "
-               "id_client INTEGER NOT NULL, "
-               "id_user INTEGER NOT NULL, "
-               "date_commande DATETIME DEFAULT CURRENT_TIMESTAMP, "
-               "statut TEXT DEFAULT 'EN_COURS' CHECK(statut IN ('EN_COURS', 'PAYEE', 'ANNULEE')), "
-               "total REAL DEFAULT 0, "
-               "FOREIGN KEY(id_client) REFERENCES CLIENTS(id_client), "
-               "FOREIGN KEY(id_user) REFERENCES USERS(id_user))");
-
-    // Table DETAILS_COMMANDE
-    query.exec("CREATE TABLE IF NOT EXISTS DETAILS_COMMANDE ("
-               "id_detail INTEGER PRIMARY KEY AUTOINCREMENT, "
-               "id_commande INTEGER NOT NULL, "
-               "id_produit INTEGER NOT NULL, "
-               "quantite INTEGER NOT NULL, "
-               "prix_unitaire REAL NOT NULL, "
-               "total REAL NOT NULL, "
-               "FOREIGN KEY(id_commande) REFERENCES COMMANDES(id_commande), "
-               "FOREIGN KEY(id_produit) REFERENCES PRODUITS(id_produit))");
-
-    // Table PAIEMENTS
-    query.exec("CREATE TABLE IF NOT EXISTS PAIEMENTS ("
-               "id_paiement INTEGER PRIMARY KEY AUTOINCREMENT, "
-               "id_commande INTEGER NOT NULL, "
-               "montant REAL NOT NULL, "
-               "date_paiement DATETIME DEFAULT CURRENT_TIMESTAMP, "
-               "statut TEXT DEFAULT 'VALIDE' CHECK(statut IN ('VALIDE', 'ANNULE')), "
-               "FOREIGN KEY(id_commande) REFERENCES COMMANDES(id_commande))");
-}
-
 void OrderDialog::setupUI()
 {
     stackedWidget = new QStackedWidget(this);
@@ -113,13 +72,146 @@ void OrderDialog::setupUI()
     stackedWidget->setCurrentIndex(0);
 }
 
+QString OrderDialog::styleRules()
+{
+    return QString(
+        "#orderDialog, #orderDialog * {"
+        "   background: palette(window);"
+        "   color: palette(text);"
+        "}"
+        "#orderDialog QLabel#stepTitle {"
+        "   font-size: 18px;"
+        "   font-weight: bold;"
+        "   margin-bottom: 20px;"
+        "}"
+        "#orderDialog QLabel#paymentTitle {"
+        "   font-size: 20px;"
+        "   font-weight: bold;"
+        "   margin-bottom: 40px;"
+        "}"
+        "#orderDialog QLabel#totalLabel {"
+        "   font-weight: bold;"
+        "   font-size: 16px;"
+        "   margin: 10px 0;"
+        "}"
+        "#orderDialog QLabel#paymentTotal {"
+        "   font-size: 32px;"
+        "   font-weight: bold;"
+        "   color: #10b981;"
+        "   padding: 20px;"
+        "   background: palette(button);"
+        "   border-radius: 10px;"
+        "   border: 2px solid palette(mid);"
+        "}"
+        "#orderDialog QLabel#paymentHint {"
+        "   font-size: 16px;"
+        "   color: palette(placeholder-text);"
+        "}"
+        "#orderDialog QTableWidget#orderTable {"
+        "   background: palette(window);"
+        "   color: palette(text);"
+        "   gridline-color: palette(mid);"
+        "   border: none;"
+        "}"
+        "#orderDialog QTableWidget#orderTable::item {"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "   border: none;"
+        "}"
+        "#orderDialog QTableWidget#orderTable QHeaderView::section {"
+        "   background: palette(button);"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "   border: none;"
+        "   border-right: 1px solid palette(mid);"
+        "   font-weight: bold;"
+        "}"
+        "#orderDialog QWidget#removeCell {"
+        "   background: transparent;"
+        "}"
+        "#orderDialog QPushButton#nextButton {"
+        "   background-color: #2196F3;"
+        "   color: white;"
+        "   padding: 8px 16px;"
+        "   border: none;"
+        "   border-radius: 4px;"
+        "}"
+        "#orderDialog QPushButton#previousButton {"
+        "   background: transparent;"
+        "   color: #667eea;"
+        "   border: 2px solid #667eea;"
+        "   border-radius: 10px;"
+        "   font-weight: 700;"
+        "   font-size: 14px;"
+        "   padding: 8px 20px;"
+        "}"
+        "#orderDialog QPushButton#previousButton:hover {"
+        "   background: #667eea;"
+        "   color: white;"
+        "}"
+        "#orderDialog QPushButton#previousButton:pressed {"
+        "   background: #5568d3;"
+        "}"
+        "#orderDialog QPushButton#cancelButton {"
+        "   background: transparent;"
+        "   color: #e53e3e;"
+        "   border: 2px solid #e53e3e;"
+        "   border-radius: 10px;"
+        "   font-weight: 700;"
+        "   font-size: 14px;"
+        "   padding: 8px 20px;"
+        "}"
+        "#orderDialog QPushButton#cancelButton:hover {"
+        "   background: #e53e3e;"
+        "   color: white;"
+        "}"
+        "#orderDialog QPushButton#cancelButton:pressed {"
+        "   background: #c53030;"
+        "}"
+        "#orderDialog QPushButton#validateButton, #orderDialog QPushButton#confirmButton {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #10b981, stop:1 #059669);"
+        "   color: white;"
+        "   border: none;"
+        "   border-radius: 10px;"
+        "   font-weight: 700;"
+        "   font-size: 14px;"
+        "   padding: 8px 24px;"
+        "}"
+        "#orderDialog QPushButton#confirmButton {"
+        "   font-size: 15px;"
+        "   padding: 8px 30px;"
+        "}"
+        "#orderDialog QPushButton#validateButton:hover, #orderDialog QPushButton#confirmButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #059669, stop:1 #047857);"
+        "}"
+        "#orderDialog QPushButton#validateButton:pressed, #orderDialog QPushButton#confirmButton:pressed {"
+        "   background: #047857;"
+        "}"
+        "#orderDialog QPushButton#removeItemButton {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #f56565, stop:1 #e53e3e);"
+        "   color: white;"
+        "   border: none;"
+        "   font-size: 14px;"
+        "   font-weight: 700;"
+        "   outline: none;"
+        "   padding: 0px;"
+        "}"
+        "#orderDialog QPushButton#removeItemButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #e53e3e, stop:1 #c53030);"
+        "}"
+        "#orderDialog QPushButton#removeItemButton:pressed {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #c53030, stop:1 #742a2a);"
+        "}"
+    );
+}
+
 void OrderDialog::setupClientForm()
 {
     clientWidget = new QWidget();
     QVBoxLayout *layout = new QVBoxLayout(clientWidget);
 
     QLabel *title = new QLabel("Informations client", clientWidget);
-    title->setStyleSheet("font-size: 18px; font-weight: bold; margin-bottom: 20px;");
+    title->setObjectName("stepTitle");
     layout->addWidget(title);
 
     QFormLayout *formLayout = new QFormLayout();
@@ -157,7 +249,7 @@ void OrderDialog::setupClientForm()
     buttonLayout->addWidget(cancelBtn);
 
     nextBtn = new QPushButton("Suivant", clientWidget);
-    nextBtn->setStyleSheet("QPushButton { background-color: #2196F3; color: white; padding: 8px 16px; border: none; border-radius: 4px; }");
+    nextBtn->setObjectName("nextButton");
     connect(nextBtn, &QPushButton::clicked, this, &OrderDialog::onNextStep);
     buttonLayout->addWidget(nextBtn);
 
@@ -172,7 +264,7 @@ void OrderDialog::setupOrderSummary()
     QVBoxLayout *layout = new QVBoxLayout(orderWidget);
 
     QLabel *title = new QLabel("Récapitulatif de la commande", orderWidget);
-    title->setStyleSheet("font-size: 18px; font-weight: bold; margin-bottom: 20px; color: #f1f5f9;");
+    title->setObjectName("stepTitle");
     layout->addWidget(title);
 
     // Table pour afficher les produits
@@ -187,33 +279,13 @@ void OrderDialog::setupOrderSummary()
     orderTable->verticalHeader()->setVisible(false);
     orderTable->verticalHeader()->setDefaultSectionSize(70);
     orderTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-    orderTable->setStyleSheet(
-        "QTableWidget {"
-        "   background: #0f172a;"
-        "   color: #e2e8f0;"
-        "   gridline-color: #334155;"
-        "   border: none;"
-        "}"
-        "QTableWidget::item {"
-        "   color: #f1f5f9;"
-        "   padding: 8px;"
-        "   border: none;"
-        "}"
-        "QHeaderView::section {"
-        "   background: #1e293b;"
-        "   color: #e2e8f0;"
-        "   padding: 8px;"
-        "   border: none;"
-        "   border-right: 1px solid #334155;"
-        "   font-weight: bold;"
-        "}"
-    );
+    orderTable->setObjectName("orderTable");
 
     layout->addWidget(orderTable);
 
     // Total
     totalLabel = new QLabel("Total: 0.00 €", orderWidget);
-    totalLabel->setStyleSheet("font-weight: bold; font-size: 16px; margin: 10px 0; color: #f1f5f9;");
+    totalLabel->setObjectName("totalLabel");
     layout->addWidget(totalLabel);
 
     layout->addStretch();
@@ -226,24 +298,7 @@ void OrderDialog::setupOrderSummary()
     previousBtn->setMinimumHeight(48);
     previousBtn->setMinimumWidth(120);
     previousBtn->setCursor(Qt::PointingHandCursor);
-    previousBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: transparent;"
-        "   color: #667eea;"
-        "   border: 2px solid #667eea;"
-        "   border-radius: 10px;"
-        "   font-weight: 700;"
-        "   font-size: 14px;"
-        "   padding: 8px 20px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #667eea;"
-        "   color: white;"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #5568d3;"
-        "}"
-    );
+    previousBtn->setObjectName("previousButton");
     connect(previousBtn, &QPushButton::clicked, this, &OrderDialog::onPreviousStep);
     buttonLayout->addWidget(previousBtn);
 
@@ -251,24 +306,7 @@ void OrderDialog::setupOrderSummary()
     cancelBtn2->setMinimumHeight(48);
     cancelBtn2->setMinimumWidth(120);
     cancelBtn2->setCursor(Qt::PointingHandCursor);
-    cancelBtn2->setStyleSheet(
-        "QPushButton {"
-        "   background: transparent;"
-        "   color: #e53e3e;"
-        "   border: 2px solid #e53e3e;"
-        "   border-radius: 10px;"
-        "   font-weight: 700;"
-        "   font-size: 14px;"
-        "   padding: 8px 20px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #e53e3e;"
-        "   color: white;"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #c53030;"
-        "}"
-    );
+    cancelBtn2->setObjectName("cancelButton");
     connect(cancelBtn2, &QPushButton::clicked, this, &OrderDialog::onCancelOrder);
     buttonLayout->addWidget(cancelBtn2);
 
@@ -276,23 +314,7 @@ void OrderDialog::setupOrderSummary()
     validateBtn->setMinimumHeight(48);
     validateBtn->setMinimumWidth(140);
     validateBtn->setCursor(Qt::PointingHandCursor);
-    validateBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #10b981, stop:1 #059669);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 10px;"
-        "   font-weight: 700;"
-        "   font-size: 14px;"
-        "   padding: 8px 24px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #059669, stop:1 #047857);"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #047857;"
-        "}"
-    );
+    validateBtn->setObjectName("validateButton");
     connect(validateBtn, &QPushButton::clicked, this, &OrderDialog::onContinueToPayment);
     buttonLayout->addWidget(validateBtn);
 
@@ -307,23 +329,12 @@ void OrderDialog::setupPaymentForm()
     QVBoxLayout *layout = new QVBoxLayout(paymentWidget);
 
     QLabel *title = new QLabel("💳 Paiement de la commande", paymentWidget);
-    title->setStyleSheet("font-size: 20px; font-weight: bold; margin-bottom: 40px; color: #f1f5f9;");
+    title->setObjectName("paymentTitle");
     layout->addWidget(title);
 
     // Afficher le montant total
     paymentTotalLabel = new QLabel(paymentWidget);
-    paymentTotalLabel->setStyleSheet(
-        "QLabel {"
-        "   font-size: 32px;"
-        "   font-weight: bold;"
-        "   color: #10b981;"
-        "   text-align: center;"
-        "   padding: 20px;"
-        "   background: #1e293b;"
-        "   border-radius: 10px;"
-        "   border: 2px solid #334155;"
-        "}"
-    );
+    paymentTotalLabel->setObjectName("paymentTotal");
     layout->addWidget(paymentTotalLabel);
 
     // Espacer
@@ -331,13 +342,7 @@ void OrderDialog::setupPaymentForm()
 
     // Label de confirmation
     QLabel *confirmLabel = new QLabel("Le montant sera payé en espèces", paymentWidget);
-    confirmLabel->setStyleSheet(
-        "QLabel {"
-        "   font-size: 16px;"
-        "   color: #94a3b8;"
-        "   text-align: center;"
-        "}"
-    );
+    confirmLabel->setObjectName("paymentHint");
     layout->addWidget(confirmLabel);
 
     layout->addStretch();
@@ -350,24 +355,7 @@ void OrderDialog::setupPaymentForm()
     previousPaymentBtn->setMinimumHeight(48);
     previousPaymentBtn->setMinimumWidth(120);
     previousPaymentBtn->setCursor(Qt::PointingHandCursor);
-    previousPaymentBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: transparent;"
-        "   color: #667eea;"
-        "   border: 2px solid #667eea;"
-        "   border-radius: 10px;"
-        "   font-weight: 700;"
-        "   font-size: 14px;"
-        "   padding: 8px 20px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #667eea;"
-        "   color: white;"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #5568d3;"
-        "}"
-    );
+    previousPaymentBtn->setObjectName("previousButton");
     connect(previousPaymentBtn, &QPushButton::clicked, this, &OrderDialog::onPreviousFromPayment);
     buttonLayout->addWidget(previousPaymentBtn);
 
@@ -375,24 +363,7 @@ void OrderDialog::setupPaymentForm()
     cancelPaymentBtn->setMinimumHeight(48);
     cancelPaymentBtn->setMinimumWidth(120);
     cancelPaymentBtn->setCursor(Qt::PointingHandCursor);
-    cancelPaymentBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: transparent;"
-        "   color: #e53e3e;"
-        "   border: 2px solid #e53e3e;"
-        "   border-radius: 10px;"
-        "   font-weight: 700;"
-        "   font-size: 14px;"
-        "   padding: 8px 20px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #e53e3e;"
-        "   color: white;"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #c53030;"
-        "}"
-    );
+    cancelPaymentBtn->setObjectName("cancelButton");
     connect(cancelPaymentBtn, &QPushButton::clicked, this, &OrderDialog::onCancelOrder);
     buttonLayout->addWidget(cancelPaymentBtn);
 
@@ -400,23 +371,7 @@ void OrderDialog::setupPaymentForm()
     confirmPaymentBtn->setMinimumHeight(48);
     confirmPaymentBtn->setMinimumWidth(180);
     confirmPaymentBtn->setCursor(Qt::PointingHandCursor);
-    confirmPaymentBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #10b981, stop:1 #059669);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 10px;"
-        "   font-weight: 700;"
-        "   font-size: 15px;"
-        "   padding: 8px 30px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #059669, stop:1 #047857);"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #047857;"
-        "}"
-    );
+    confirmPaymentBtn->setObjectName("confirmButton");
     connect(confirmPaymentBtn, &QPushButton::clicked, this, &OrderDialog::onConfirmPayment);
     buttonLayout->addWidget(confirmPaymentBtn);
 
@@ -439,6 +394,7 @@ void OrderDialog::addProduct(int productId, const QString &productName, double u
         item.total = unitPrice * quantity;
         orderItems[productId] = item;
     }
+    stockShortages.remove(productId);
 
     updateTotal();
     updateTable();
@@ -453,6 +409,7 @@ void OrderDialog::removeProduct(int productId, int quantity)
         } else {
             orderItems[productId].total = orderItems[productId].unitPrice * orderItems[productId].quantity;
         }
+        stockShortages.remove(productId);
         updateTotal();
         updateTable();
     }
@@ -514,6 +471,7 @@ void OrderDialog::onRemoveItem(int row)
 
     if (productId != -1) {
         orderItems.remove(productId);
+        stockShortages.remove(productId);
         updateTotal();
         updateTable();
     }
@@ -552,9 +510,24 @@ void OrderDialog::updateTable()
         // Total pour cet article
         orderTable->setItem(row, 3, new QTableWidgetItem(QString::number(item.total, 'f', 2) + " €"));
 
+        // Ligne en rupture lors de la dernière vérification des stocks, dans
+        // la teinte danger du thème (fond translucide, texte plein)
+        if (stockShortages.contains(item.productId)) {
+            QString tooltip = QString("Stock disponible : %1").arg(stockShortages.value(item.productId));
+            const QColor danger = ThemeManager::instance().dangerColor();
+            QColor shortageBackground = danger;
+            shortageBackground.setAlpha(48);
+            for (int column = 0; column < 4; ++column) {
+                QTableWidgetItem *cell = orderTable->item(row, column);
+                cell->setBackground(shortageBackground);
+                cell->setForeground(danger);
+                cell->setToolTip(tooltip);
+            }
+        }
+
         // Bouton de suppression
         QWidget *actionWidget = new QWidget();
-        actionWidget->setStyleSheet("background: transparent;");
+        actionWidget->setObjectName("removeCell");
         QHBoxLayout *actionLayout = new QHBoxLayout(actionWidget);
         actionLayout->setContentsMargins(0, 0, 0, 0);
         actionLayout->setSpacing(0);
@@ -563,26 +536,7 @@ void OrderDialog::updateTable()
         QPushButton *removeBtn = new QPushButton("🗑️");
         removeBtn->setFixedSize(32, 32);
         removeBtn->setCursor(Qt::PointingHandCursor);
-        removeBtn->setStyleSheet(
-            "QPushButton {"
-            "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-            "   stop:0 #f56565, stop:1 #e53e3e);"
-            "   color: white;"
-            "   border: none;"
-            "   font-size: 14px;"
-            "   font-weight: 700;"
-            "   outline: none;"
-            "   padding: 0px;"
-            "}"
-            "QPushButton:hover {"
-            "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-            "   stop:0 #e53e3e, stop:1 #c53030);"
-            "}"
-            "QPushButton:pressed {"
-            "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-            "   stop:0 #c53030, stop:1 #742a2a);"
-            "}"
-        );
+        removeBtn->setObjectName("removeItemButton");
         connect(removeBtn, &QPushButton::clicked, [this, row]() {
             onRemoveItem(row);
         });
@@ -597,156 +551,103 @@ void OrderDialog::updateTable()
 
 bool OrderDialog::saveClientAndOrder()
 {
-    QSqlQuery query;
-
-    // 1. Insérer le client
-    query.prepare("INSERT INTO CLIENTS (nom, prenom, telephone, email, adresse) "
-                  "VALUES (?, ?, ?, ?, ?)");
-    query.addBindValue(nomEdit->text().trimmed());
-    query.addBindValue(prenomEdit->text().trimmed());
-    query.addBindValue(telephoneEdit->text().trimmed());
-    query.addBindValue(emailEdit->text().trimmed());
-    query.addBindValue(adresseEdit->toPlainText().trimmed());
-
-    if (!query.exec()) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors de la création du client: " + query.lastError().text());
-        return false;
+    // Encaissement : stock, commande, lignes et paiement. Seul l'encaissement
+    // est mesuré : les boîtes de message ont leur propre boucle d'événements.
+    OrderRepository::CheckoutResult result;
+    {
+        UiProfiler::Scope scope("OrderDialog::saveClientAndOrder");
+        Client client;
+        client.nom = nomEdit->text().trimmed();
+        client.prenom = prenomEdit->text().trimmed();
+        client.telephone = telephoneEdit->text().trimmed();
+        client.email = emailEdit->text().trimmed();
+        client.adresse = adresseEdit->toPlainText().trimmed();
+        result = OrderRepository::checkout(client, currentUserId, orderItems.values(), totalAmount);
     }
 
-    int clientId = query.lastInsertId().toInt();
-
-    // 2. Insérer la commande
-    query.prepare("INSERT INTO COMMANDES (id_client, id_user, total, statut) "
-                  "VALUES (?, ?, ?, 'EN_COURS')");
-    query.addBindValue(clientId);
-    query.addBindValue(currentUserId);
-    query.addBindValue(totalAmount);
-
-    if (!query.exec()) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors de la création de la commande: " + query.lastError().text());
+    switch (result) {
+    case OrderRepository::CheckoutOk:
+        return true;
+    case OrderRepository::CheckoutStockConflict:
+        QMessageBox::warning(this, "Stock insuffisant", OrderRepository::lastError());
+        return false;
+    default:
+        QMessageBox::critical(this, "Erreur", OrderRepository::lastError());
         return false;
     }
+}
 
-    int commandeId = query.lastInsertId().toInt();
-
-    // 3. Insérer les détails de la commande
-    for (const OrderItem &item : orderItems) {
-        query.prepare("INSERT INTO DETAILS_COMMANDE (id_commande, id_produit, quantite, prix_unitaire, total) "
-                      "VALUES (?, ?, ?, ?, ?)");
-        query.addBindValue(commandeId);
-        query.addBindValue(item.productId);
-        query.addBindValue(item.quantity);
-        query.addBindValue(item.unitPrice);
-        query.addBindValue(item.total);
-
-        if (!query.exec()) {
-            QMessageBox::critical(this, "Erreur", "Erreur lors de l'ajout des détails de commande: " + query.lastError().text());
-            return false;
-        }
+bool OrderDialog::checkStocks(bool *queryError)
+{
+    // Tout le panier est vérifié en une requête : json_each déroule
+    // {"id_produit": quantité, ...} et seules les lignes en défaut reviennent.
+    stockShortages.clear();
+    *queryError = false;
+    if (orderItems.isEmpty()) {
+        updateTable();
+        return true;
     }
 
-    // 4. Mettre à jour le stock des produits
+    QMap<int, int> basket;
     for (const OrderItem &item : orderItems) {
-        query.prepare("UPDATE PRODUITS SET stock = stock - ? WHERE id_produit = ?");
-        query.addBindValue(item.quantity);
-        query.addBindValue(item.productId);
-
-        if (!query.exec()) {
-            QMessageBox::critical(this, "Erreur", "Erreur lors de la mise à jour du stock: " + query.lastError().text());
-            return false;
-        }
-    }
-
-    // 5. Insérer le paiement en espèces
-    query.prepare("INSERT INTO PAIEMENTS (id_commande, montant, statut) "
-                  "VALUES (?, ?, 'VALIDE')");
-    query.addBindValue(commandeId);
-    query.addBindValue(totalAmount);
-
-    if (!query.exec()) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors de l'enregistrement du paiement: " + query.lastError().text());
-        return false;
+        basket.insert(item.productId, item.quantity);
     }
 
-    // 6. Mettre à jour le statut de la commande à PAYEE
-    query.prepare("UPDATE COMMANDES SET statut = 'PAYEE' WHERE id_commande = ?");
-    query.addBindValue(commandeId);
-
-    if (!query.exec()) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors de la mise à jour du statut de commande: " + query.lastError().text());
+    bool ok = false;
+    stockShortages = ProductRepository::stockShortages(basket, &ok);
+    if (!ok) {
+        qDebug() << "Erreur lors de la vérification des stocks:" << ProductRepository::lastError();
+        *queryError = true;
         return false;
     }
 
-    return true;
+    updateTable();
+    return stockShortages.isEmpty();
 }
 
-bool OrderDialog::checkStocks()
+QString OrderDialog::stockShortageSummary() const
 {
-    QSqlQuery query;
-    for (auto it = orderItems.begin(); it != orderItems.end(); ++it) {
-        query.prepare("SELECT stock FROM PRODUITS WHERE id_produit = ?");
-        query.addBindValue(it.key());
-        if (query.exec() && query.next()) {
-            int stock = query.value(0).toInt();
-            if (it.value().quantity > stock) {
-                return false;
-            }
-        } else {
-            return false; // Erreur ou produit non trouvé
-        }
+    QStringList lines;
+    for (auto it = stockShortages.constBegin(); it != stockShortages.constEnd(); ++it) {
+        const OrderItem item = orderItems.value(it.key());
+        lines << QString("%1 : %2 demandé(s), %3 disponible(s)")
+                     .arg(item.productName).arg(item.quantity).arg(it.value());
     }
-    return true;
+    return lines.join("\n");
 }
 
 void OrderDialog::loadOrderForEdit(const QString &commandeId)
 {
     // Charger les informations de la commande
-    QSqlQuery query;
-    query.prepare("SELECT c.date_commande, cl.nom, cl.prenom, cl.telephone, cl.email, cl.adresse, c.total "
-                  "FROM COMMANDES c "
-                  "LEFT JOIN CLIENTS cl ON c.id_client = cl.id_client "
-                  "WHERE c.id_commande = ?");
-    query.addBindValue(commandeId.toInt());
-    
-    if (query.exec() && query.next()) {
-        // Remplir les champs client
-        clientNom = query.value("nom").toString();
-        clientPrenom = query.value("prenom").toString();
-        clientTelephone = query.value("telephone").toString();
-        clientEmail = query.value("email").toString();
-        clientAdresse = query.value("adresse").toString();
-        
-        // Mettre à jour l'interface client
-        nomEdit->setText(clientNom);
-        prenomEdit->setText(clientPrenom);
-        telephoneEdit->setText(clientTelephone);
-        emailEdit->setText(clientEmail);
-        adresseEdit->setText(clientAdresse);
-        
-        // Charger les détails de la commande
-        QSqlQuery detailQuery;
-        detailQuery.prepare("SELECT cd.id_produit, p.nom, p.prix_vente, cd.quantite, cd.total "
-                           "FROM COMMANDE_DETAIL cd "
-                           "LEFT JOIN PRODUITS p ON cd.id_produit = p.id_produit "
-                           "WHERE cd.id_commande = ?");
-        detailQuery.addBindValue(commandeId.toInt());
-        
-        if (detailQuery.exec()) {
-            while (detailQuery.next()) {
-                int productId = detailQuery.value("id_produit").toInt();
-                QString productName = detailQuery.value("nom").toString();
-                double unitPrice = detailQuery.value("prix_vente").toDouble();
-                int quantity = detailQuery.value("quantite").toInt();
-                
-                addProduct(productId, productName, unitPrice, quantity);
-            }
-        }
-        
-        // Passer directement à l'étape de récapitulatif
-        stackedWidget->setCurrentWidget(orderWidget);
-        updateTotal();
-        updateTable();
+    Order order;
+    if (!OrderRepository::find(commandeId.toInt(), order)) {
+        return;
+    }
+
+    // Remplir les champs client
+    clientNom = order.client.nom;
+    clientPrenom = order.client.prenom;
+    clientTelephone = order.client.telephone;
+    clientEmail = order.client.email;
+    clientAdresse = order.client.adresse;
+
+    // Mettre à jour l'interface client
+    nomEdit->setText(clientNom);
+    prenomEdit->setText(clientPrenom);
+    telephoneEdit->setText(clientTelephone);
+    emailEdit->setText(clientEmail);
+    adresseEdit->setText(clientAdresse);
+
+    // Charger les détails de la commande, au prix facturé
+    const QVector<OrderItem> items = OrderRepository::items(order.id);
+    for (const OrderItem &item : items) {
+        addProduct(item.productId, item.productName, item.unitPrice, item.quantity);
     }
+
+    // Passer directement à l'étape de récapitulatif
+    stackedWidget->setCurrentWidget(orderWidget);
+    updateTotal();
+    updateTable();
 }
 
 void OrderDialog::reset()
@@ -759,9 +660,16 @@ void OrderDialog::reset()
 void OrderDialog::onContinueToPayment()
 {
     // Validation des stocks
-    if (!checkStocks()) {
+    bool queryError = false;
+    if (!checkStocks(&queryError)) {
+        if (queryError) {
+            QMessageBox::critical(this, "Erreur",
+                                  "Impossible de vérifier les stocks: " + ProductRepository::lastError());
+            return;
+        }
         QMessageBox::warning(this, "Stock insuffisant", 
-                           "Un ou plusieurs produits dans votre commande n'ont plus assez de stock disponible.");
+                           "Un ou plusieurs produits dans votre commande n'ont plus assez de stock disponible.\n\n"
+                           + stockShortageSummary());
         return;
     }
 
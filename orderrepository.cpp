@@ -0,0 +1,236 @@
+#include "orderrepository.h"
+#include "paymentrepository.h"
+#include "productrepository.h"
+#include "repositoryerror.h"
+#include "searchindex.h"
+#include <QSqlError>
+
+namespace {
+thread_local RepositoryError repositoryError;
+}
+
+OrderRepository::OrderRepository() {}
+
+QString OrderRepository::lastError()
+{
+    return repositoryError.text();
+}
+
+QString OrderRepository::findSql()
+{
+    return "SELECT c.date_commande, c.statut, c.total, cl.id_client, cl.nom, cl.prenom, cl.telephone, cl.email, cl.adresse "
+           "FROM COMMANDES c "
+           "LEFT JOIN CLIENTS cl ON c.id_client = cl.id_client "
+           "WHERE c.id_commande = ?";
+}
+
+QString OrderRepository::itemsSql()
+{
+    return "SELECT d.id_produit, p.nom_produit, d.prix_unitaire, d.quantite, d.total "
+           "FROM DETAILS_COMMANDE d "
+           "LEFT JOIN PRODUITS p ON d.id_produit = p.id_produit "
+           "WHERE d.id_commande = ?";
+}
+
+bool OrderRepository::find(int commandeId, Order &order, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, findSql());
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, commandeId);
+
+    if (!repositoryError.exec(*query) || !query->next()) {
+        query->finish();
+        return false;
+    }
+
+    order.id = commandeId;
+    order.dateCommande = query->value(0).toDateTime();
+    order.statut = query->value(1).toString();
+    order.total = query->value(2).toDouble();
+    order.client.id = query->value(3).isNull() ? -1 : query->value(3).toInt();
+    order.client.nom = query->value(4).toString();
+    order.client.prenom = query->value(5).toString();
+    order.client.telephone = query->value(6).toString();
+    order.client.email = query->value(7).toString();
+    order.client.adresse = query->value(8).toString();
+    query->finish();
+    return true;
+}
+
+QVector<OrderItem> OrderRepository::items(int commandeId, const QSqlDatabase &db)
+{
+    QVector<OrderItem> items;
+    QSqlQuery *query = repositoryError.prepare(db, itemsSql());
+    if (!query) {
+        return items;
+    }
+    query->bindValue(0, commandeId);
+
+    if (!repositoryError.exec(*query)) {
+        return items;
+    }
+
+    while (query->next()) {
+        OrderItem item;
+        item.productId = query->value(0).toInt();
+        item.productName = query->value(1).toString();
+        item.unitPrice = query->value(2).toDouble();
+        item.quantity = query->value(3).toInt();
+        item.total = query->value(4).toDouble();
+        items.append(item);
+    }
+    query->finish();
+    return items;
+}
+
+OrderRepository::CheckoutResult OrderRepository::checkout(const Client &client, int userId,
+                                                          const QVector<OrderItem> &items, double total,
+                                                          int *commandeId, QSqlDatabase db)
+{
+    if (!db.transaction()) {
+        repositoryError.set("Impossible de démarrer la transaction: " + db.lastError().text());
+        return CheckoutError;
+    }
+
+    auto fail = [&db](const QString &message) {
+        db.rollback();
+        repositoryError.set(message);
+        return CheckoutError;
+    };
+
+    // 1. Le client
+    int clientId = ClientRepository::insert(client, db);
+    if (clientId < 0) {
+        return fail("Erreur lors de la création du client: " + ClientRepository::lastError());
+    }
+
+    // 2. La commande, directement payée : le paiement suit dans la même transaction
+    QSqlQuery *orderQuery = repositoryError.prepare(db,
+        "INSERT INTO COMMANDES (id_client, id_user, total, statut) VALUES (?, ?, ?, 'PAYEE')");
+    if (!orderQuery) {
+        return fail("Erreur lors de la création de la commande: " + repositoryError.text());
+    }
+    orderQuery->bindValue(0, clientId);
+    orderQuery->bindValue(1, userId);
+    orderQuery->bindValue(2, total);
+    if (!repositoryError.exec(*orderQuery)) {
+        return fail("Erreur lors de la création de la commande: " + repositoryError.text());
+    }
+    int newCommandeId = orderQuery->lastInsertId().toInt();
+
+    // 3. Les lignes, en un seul lot
+    QVariantList commandeIds, productIds, quantities, unitPrices, totals;
+    for (const OrderItem &item : items) {
+        commandeIds << newCommandeId;
+        productIds << item.productId;
+        quantities << item.quantity;
+        unitPrices << item.unitPrice;
+        totals << item.total;
+    }
+
+    QSqlQuery *detailQuery = repositoryError.prepare(db,
+        "INSERT INTO DETAILS_COMMANDE (id_commande, id_produit, quantite, prix_unitaire, total) "
+        "VALUES (?, ?, ?, ?, ?)");
+    if (!detailQuery) {
+        return fail("Erreur lors de l'ajout des détails de commande: " + repositoryError.text());
+    }
+    detailQuery->bindValue(0, commandeIds);
+    detailQuery->bindValue(1, productIds);
+    detailQuery->bindValue(2, quantities);
+    detailQuery->bindValue(3, unitPrices);
+    detailQuery->bindValue(4, totals);
+    if (!repositoryError.execBatch(*detailQuery)) {
+        return fail("Erreur lors de l'ajout des détails de commande: " + repositoryError.text());
+    }
+
+    // Produits de la commande dans l'index de recherche, une fois pour le lot
+    QString indexError;
+    if (!SearchIndex::indexOrderProducts(newCommandeId, db, &indexError)) {
+        return fail("Erreur lors de l'indexation de la commande: " + indexError);
+    }
+
+    // 4. Le stock, en une requête
+    bool stockConflict = false;
+    if (!ProductRepository::decrementStockForOrder(newCommandeId, items.size(), &stockConflict, db)) {
+        if (stockConflict) {
+            db.rollback();
+            repositoryError.set("Le stock a changé entre-temps : la commande n'a pas été enregistrée.");
+            return CheckoutStockConflict;
+        }
+        return fail("Erreur lors de la mise à jour du stock: " + ProductRepository::lastError());
+    }
+
+    // 5. Le paiement en espèces
+    if (PaymentRepository::insert(newCommandeId, total, "VALIDE", db) < 0) {
+        return fail("Erreur lors de l'enregistrement du paiement: " + PaymentRepository::lastError());
+    }
+
+    if (!db.commit()) {
+        return fail("Erreur lors de la validation de la commande: " + db.lastError().text());
+    }
+
+    if (commandeId) {
+        *commandeId = newCommandeId;
+    }
+    repositoryError.clear();
+    return CheckoutOk;
+}
+
+bool OrderRepository::cancel(int commandeId, QSqlDatabase db)
+{
+    if (!db.transaction()) {
+        repositoryError.set("Impossible de démarrer la transaction: " + db.lastError().text());
+        return false;
+    }
+
+    auto fail = [&db](const QString &message) {
+        db.rollback();
+        repositoryError.set(message);
+        return false;
+    };
+
+    QSqlQuery *statusQuery = repositoryError.prepare(db,
+        "SELECT statut FROM COMMANDES WHERE id_commande = ?");
+    if (!statusQuery) {
+        return fail(repositoryError.text());
+    }
+    statusQuery->bindValue(0, commandeId);
+    if (!repositoryError.exec(*statusQuery)) {
+        return fail(repositoryError.text());
+    }
+    if (!statusQuery->next()) {
+        statusQuery->finish();
+        return fail("Commande introuvable.");
+    }
+    const QString statut = statusQuery->value(0).toString();
+    statusQuery->finish();
+    if (statut == "ANNULEE") {
+        return fail("La commande est déjà annulée.");
+    }
+
+    QSqlQuery *cancelQuery = repositoryError.prepare(db,
+        "UPDATE COMMANDES SET statut = 'ANNULEE' WHERE id_commande = ?");
+    if (!cancelQuery) {
+        return fail("Erreur lors de l'annulation de la commande: " + repositoryError.text());
+    }
+    cancelQuery->bindValue(0, commandeId);
+    if (!repositoryError.exec(*cancelQuery)) {
+        return fail("Erreur lors de l'annulation de la commande: " + repositoryError.text());
+    }
+
+    if (!ProductRepository::restockForOrder(commandeId, db)) {
+        return fail("Erreur lors de la remise en stock: " + ProductRepository::lastError());
+    }
+
+    if (!PaymentRepository::cancelForOrder(commandeId, db)) {
+        return fail("Erreur lors de l'annulation du paiement: " + PaymentRepository::lastError());
+    }
+
+    if (!db.commit()) {
+        return fail("Erreur lors de la validation de l'annulation: " + db.lastError().text());
+    }
+    repositoryError.clear();
+    return true;
+}
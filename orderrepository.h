@@ -0,0 +1,59 @@
+#ifndef ORDERREPOSITORY_H
+#define ORDERREPOSITORY_H
+
+#include "clientrepository.h"
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QString>
+#include <QVector>
+
+struct OrderItem {
+    int productId = 0;
+    QString productName;
+    double unitPrice = 0.0;
+    int quantity = 0;
+    double total = 0.0;
+};
+
+struct Order {
+    int id = -1;
+    QDateTime dateCommande;
+    QString statut;
+    double total = 0.0;
+    Client client;
+};
+
+// Accès à COMMANDES / DETAILS_COMMANDE par requêtes préparées une fois par
+// connexion (StatementCache)
+class OrderRepository
+{
+public:
+    enum CheckoutResult {
+        CheckoutOk,
+        CheckoutStockConflict,   // le stock a changé entre la vérification et la validation
+        CheckoutError
+    };
+
+    OrderRepository();
+
+    static bool find(int commandeId, Order &order, const QSqlDatabase &db = QSqlDatabase::database());
+    static QVector<OrderItem> items(int commandeId, const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Requêtes de find() et items(), vérifiées par QueryPlanCheck
+    static QString findSql();
+    static QString itemsSql();
+
+    // Client, commande payée, lignes, stock et paiement en espèces dans une
+    // seule transaction : rien n'est enregistré si une étape échoue
+    static CheckoutResult checkout(const Client &client, int userId, const QVector<OrderItem> &items,
+                                   double total, int *commandeId = nullptr,
+                                   QSqlDatabase db = QSqlDatabase::database());
+
+    // Annulation d'une commande : statut ANNULEE, paiements annulés, stock
+    // rendu et agrégats de ventes corrigés, dans une seule transaction
+    static bool cancel(int commandeId, QSqlDatabase db = QSqlDatabase::database());
+
+    static QString lastError();
+};
+
+#endif // ORDERREPOSITORY_H
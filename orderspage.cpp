@@ -1,15 +1,21 @@
 #include "orderspage.h"
 #include "orderdialog.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QHeaderView>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlRecord>
 #include <QMessageBox>
 #include <QDateTime>
 #include <QDebug>
-#include "thememanager.h"
+#include "searchindex.h"
+#include "databaseservice.h"
+#include "searchcontroller.h"
+#include "countcache.h"
+#include "orderrepository.h"
 
 OrdersPage::OrdersPage(const QString &userRole, int userId, QWidget *parent) : 
     QFrame(parent), 
@@ -18,45 +24,29 @@ OrdersPage::OrdersPage(const QString &userRole, int userId, QWidget *parent) :
     currentPage(1),
     itemsPerPage(5),
     totalItems(0),
-    totalPages(1)
+    totalPages(1),
+    pager(listPager(5)),
+    loadGeneration(0)
 {
     setObjectName("ordersPage");
-    setupDatabase();
     setupUI();
     loadOrders();
 }
 
-void OrdersPage::setupDatabase()
-{
-}
-
 void OrdersPage::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setSpacing(28);
     mainLayout->setContentsMargins(40, 40, 40, 40);
 
-    ThemeManager& theme = ThemeManager::instance();
 
     // Header
     QHBoxLayout *headerLayout = new QHBoxLayout();
     QLabel *icon = new QLabel(this);
-    icon->setStyleSheet(
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "stop:0 #06b6d4, stop:1 #0891b2);"
-        "border-radius: 14px;"
-        "min-width: 52px; max-width: 52px;"
-        "min-height: 52px; max-height: 52px;"
-    );
+    icon->setObjectName("pageIcon");
 
     QLabel *title = new QLabel("Gestion des Commandes", this);
     title->setObjectName("titleH1");
-    title->setStyleSheet(QString(
-        "font-size: 32px;"
-        "font-weight: 700;"
-        "color: %1;"
-        "letter-spacing: -0.5px;").arg(theme.textColor().name())
-    );
 
     headerLayout->addWidget(icon);
     headerLayout->addWidget(title);
@@ -70,31 +60,12 @@ void OrdersPage::setupUI()
     searchInput = new QLineEdit(this);
     searchInput->setPlaceholderText("Rechercher par client, commande...");
     searchInput->setMinimumHeight(48);
-    searchInput->setStyleSheet(QString(
-        "QLineEdit {"
-        "   border: 1px solid %1;"
-        "   border-radius: 12px;"
-        "   padding: 12px 20px;"
-        "   font-size: 15px;"
-        "   background: %2;"
-        "   color: %3;"
-        "}"
-        "QLineEdit:focus {"
-        "   border: 2px solid %4;"
-        "   outline: none;"
-        "   background: %5;"
-        "}"
-        "QLineEdit::placeholder {"
-        "   color: %6;"
-        "}"
-    ).arg(theme.borderColor().name(),
-          theme.inputBackground().name(),
-          theme.textColor().name(),
-          theme.primaryColor().name(),
-          theme.surfaceAltColor().name(),
-          theme.textTertiaryColor().name()));
+    searchInput->setObjectName("searchInput");
     
-    connect(searchInput, &QLineEdit::textChanged, this, &OrdersPage::onSearchTextChanged);
+    // Les commandes trouvées via les produits ne sont pas filtrables en
+    // mémoire : seul le délai de saisie s'applique ici
+    searchController = new SearchController(searchInput, this);
+    connect(searchController, &SearchController::searchRequested, this, &OrdersPage::onSearchTextChanged);
     filterLayout->addWidget(searchInput, 2);
 
     statusFilter = new QComboBox(this);
@@ -103,25 +74,7 @@ void OrdersPage::setupUI()
     statusFilter->addItem("En cours", "EN_COURS");
     statusFilter->addItem("Payée", "PAYEE");
     statusFilter->addItem("Annulée", "ANNULEE");
-    statusFilter->setStyleSheet(QString(
-        "QComboBox {"
-        "   border: 1px solid %1;"
-        "   border-radius: 12px;"
-        "   padding: 12px 20px;"
-        "   font-size: 15px;"
-        "   background: %2;"
-        "   color: %3;"
-        "}"
-        "QComboBox:focus {"
-        "   border: 2px solid %4;"
-        "}"
-        "QComboBox::drop-down {"
-        "   border: none;"
-        "}"
-    ).arg(theme.borderColor().name(),
-          theme.inputBackground().name(),
-          theme.textColor().name(),
-          theme.primaryColor().name()));
+    statusFilter->setObjectName("statusFilter");
     
     connect(statusFilter, QOverload<const QString &>::of(&QComboBox::currentTextChanged),
             this, &OrdersPage::onStatusFilterChanged);
@@ -130,25 +83,7 @@ void OrdersPage::setupUI()
     refreshBtn = new QPushButton("🔄 Actualiser", this);
     refreshBtn->setMinimumHeight(48);
     refreshBtn->setMinimumWidth(140);
-    refreshBtn->setStyleSheet(QString(
-        "QPushButton {"
-        "   background: %1;"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 12px;"
-        "   padding: 12px 24px;"
-        "   font-size: 15px;"
-        "   font-weight: 600;"
-        "}"
-        "QPushButton:hover {"
-        "   background: %2;"
-        "}"
-        "QPushButton:pressed {"
-        "   background: %3;"
-        "}"
-    ).arg(theme.primaryColor().name(),
-          theme.primaryHoverColor().name(),
-          theme.primaryPressedColor().name()));
+    refreshBtn->setObjectName("refreshButton");
     
     connect(refreshBtn, &QPushButton::clicked, this, &OrdersPage::onRefreshClicked);
     filterLayout->addWidget(refreshBtn);
@@ -158,6 +93,7 @@ void OrdersPage::setupUI()
     // Table des commandes
     int columnCount = (userRole == "ADMIN") ? 8 : 7;
     ordersTable = new QTableWidget(this);
+    ordersTable->setObjectName("ordersTable");
     ordersTable->setColumnCount(columnCount);
     
     QStringList headers;
@@ -173,29 +109,6 @@ void OrdersPage::setupUI()
     ordersTable->verticalHeader()->setVisible(false);
     ordersTable->verticalHeader()->setDefaultSectionSize(50);
     ordersTable->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    
-    // Style du tableau identique à clientspage
-    ordersTable->setStyleSheet(
-        "QTableWidget {"
-        "   background: #0f172a;"
-        "   color: #e2e8f0;"
-        "   gridline-color: #334155;"
-        "   border: none;"
-        "}"
-        "QTableWidget::item {"
-        "   color: #f1f5f9;"
-        "   padding: 8px;"
-        "   border: none;"
-        "}"
-        "QHeaderView::section {"
-        "   background: #1e293b;"
-        "   color: #e2e8f0;"
-        "   padding: 8px;"
-        "   border: none;"
-        "   border-right: 1px solid #334155;"
-        "   font-weight: bold;"
-        "}"
-    );
 
     // Ajuster les largeurs des colonnes
     ordersTable->setColumnWidth(0, 100);
@@ -220,59 +133,29 @@ void OrdersPage::setupUI()
     QHBoxLayout *paginationLayout = new QHBoxLayout(paginationWidget);
     paginationLayout->setSpacing(12);
     
-    QString btnStyle = 
-        "QPushButton {"
-        "   background: white;"
-        "   color: #4a5568;"
-        "   border: 2px solid #e2e8f0;"
-        "   border-radius: 10px;"
-        "   font-size: 16px;"
-        "   font-weight: bold;"
-        "   padding: 0px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
-        "   color: white;"
-        "   border-color: transparent;"
-        "}"
-        "QPushButton:disabled {"
-        "   background: #f7fafc;"
-        "   color: #cbd5e0;"
-        "   border-color: #e2e8f0;"
-        "}";
-    
     btnFirstPage = new QPushButton("|<", paginationWidget);
     btnFirstPage->setFixedSize(45, 45);
-    btnFirstPage->setStyleSheet(btnStyle);
+    btnFirstPage->setObjectName("paginationButton");
     connect(btnFirstPage, &QPushButton::clicked, this, &OrdersPage::onFirstPageClicked);
     
     btnPreviousPage = new QPushButton("<", paginationWidget);
     btnPreviousPage->setFixedSize(45, 45);
-    btnPreviousPage->setStyleSheet(btnStyle);
+    btnPreviousPage->setObjectName("paginationButton");
     connect(btnPreviousPage, &QPushButton::clicked, this, &OrdersPage::onPreviousPageClicked);
 
     pageInfoLabel = new QLabel("Page 1 / 1", paginationWidget);
-    pageInfoLabel->setStyleSheet(QString(
-        "font-size: 14px;"
-        "font-weight: 600;"
-        "color: #4a5568;"
-        "background: white;"
-        "border: 2px solid #e2e8f0;"
-        "border-radius: 10px;"
-        "padding: 10px 20px;"
-    ));
+    pageInfoLabel->setObjectName("pageInfo");
     pageInfoLabel->setAlignment(Qt::AlignCenter);
     pageInfoLabel->setMinimumWidth(150);
 
     btnNextPage = new QPushButton(">", paginationWidget);
     btnNextPage->setFixedSize(45, 45);
-    btnNextPage->setStyleSheet(btnStyle);
+    btnNextPage->setObjectName("paginationButton");
     connect(btnNextPage, &QPushButton::clicked, this, &OrdersPage::onNextPageClicked);
 
     btnLastPage = new QPushButton(">|", paginationWidget);
     btnLastPage->setFixedSize(45, 45);
-    btnLastPage->setStyleSheet(btnStyle);
+    btnLastPage->setObjectName("paginationButton");
     connect(btnLastPage, &QPushButton::clicked, this, &OrdersPage::onLastPageClicked);
 
     paginationLayout->addStretch();
@@ -286,94 +169,246 @@ void OrdersPage::setupUI()
     mainLayout->addWidget(paginationWidget);
 }
 
-void OrdersPage::loadOrders()
+QString OrdersPage::styleRules()
 {
-    ordersTable->setRowCount(0);
-
-    QString countQueryStr = R"(
-        SELECT COUNT(DISTINCT c.id_commande) as total
-        FROM COMMANDES c
-        LEFT JOIN CLIENTS cl ON c.id_client = cl.id_client
-        LEFT JOIN USERS u ON c.id_user = u.id_user
-        LEFT JOIN COMMANDE_DETAIL cd ON c.id_commande = cd.id_commande
-        LEFT JOIN PRODUITS p ON cd.id_produit = p.id_produit
-        WHERE 1=1
-    )";
+    return QString(
+        "#ordersPage QLabel#pageIcon {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #06b6d4, stop:1 #0891b2);"
+        "   border-radius: 14px;"
+        "   min-width: 52px;"
+        "   max-width: 52px;"
+        "   min-height: 52px;"
+        "   max-height: 52px;"
+        "}"
+        "#ordersPage QLabel#titleH1 {"
+        "   font-size: 32px;"
+        "   font-weight: 700;"
+        "   color: palette(window-text);"
+        "   letter-spacing: -0.5px;"
+        "}"
+        "#ordersPage QLineEdit#searchInput {"
+        "   border: 1px solid palette(mid);"
+        "   border-radius: 12px;"
+        "   padding: 12px 20px;"
+        "   font-size: 15px;"
+        "   background: palette(base);"
+        "   color: palette(window-text);"
+        "}"
+        "#ordersPage QLineEdit#searchInput:focus {"
+        "   border: 2px solid palette(highlight);"
+        "   outline: none;"
+        "   background: palette(alternate-base);"
+        "}"
+        "#ordersPage QLineEdit#searchInput::placeholder {"
+        "   color: palette(placeholder-text);"
+        "}"
+        "#ordersPage QComboBox#statusFilter {"
+        "   border: 1px solid palette(mid);"
+        "   border-radius: 12px;"
+        "   padding: 12px 20px;"
+        "   font-size: 15px;"
+        "   background: palette(base);"
+        "   color: palette(window-text);"
+        "}"
+        "#ordersPage QComboBox#statusFilter:focus {"
+        "   border: 2px solid palette(highlight);"
+        "}"
+        "#ordersPage QComboBox#statusFilter::drop-down {"
+        "   border: none;"
+        "}"
+        "#ordersPage QPushButton#refreshButton {"
+        "   border: none;"
+        "   border-radius: 12px;"
+        "   padding: 12px 24px;"
+        "   font-size: 15px;"
+        "   font-weight: 600;"
+        "}"
+        "#ordersPage QTableWidget#ordersTable {"
+        "   background: palette(window);"
+        "   color: palette(text);"
+        "   gridline-color: palette(mid);"
+        "   border: none;"
+        "}"
+        "#ordersPage QTableWidget#ordersTable::item {"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "   border: none;"
+        "}"
+        "#ordersPage #ordersTable QHeaderView::section {"
+        "   background: palette(button);"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "   border: none;"
+        "   border-right: 1px solid palette(mid);"
+        "   font-weight: bold;"
+        "}"
+        "#ordersPage QPushButton#paginationButton {"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   font-size: 16px;"
+        "   font-weight: bold;"
+        "   padding: 0px;"
+        "}"
+        "#ordersPage QPushButton#paginationButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
+        "   color: white;"
+        "   border-color: transparent;"
+        "}"
+        "#ordersPage QPushButton#paginationButton:disabled {"
+        "   background: palette(alternate-base);"
+        "   color: palette(placeholder-text);"
+        "   border-color: palette(mid);"
+        "}"
+        "#ordersPage QLabel#pageInfo {"
+        "   font-size: 14px;"
+        "   font-weight: 600;"
+        "   color: palette(text);"
+        "   background: palette(base);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   padding: 10px 20px;"
+        "}"
+    );
+}
 
-    QStringList conditions;
+KeysetPager OrdersPage::listPager(int pageSize)
+{
+    return KeysetPager("c.date_commande", "c.id_commande", pageSize);
+}
 
-    if (!currentSearchText.isEmpty()) {
-        conditions << "(cl.nom LIKE '%" + currentSearchText + "%' OR "
-                   "cl.prenom LIKE '%" + currentSearchText + "%' OR "
-                   "CAST(c.id_commande AS TEXT) LIKE '%" + currentSearchText + "%' OR "
-                   "p.nom_produit LIKE '%" + currentSearchText + "%')";
+QString OrdersPage::listSource(const QString &match)
+{
+    if (match.isEmpty()) {
+        return "ORDER_SUMMARY c";
     }
+    return "ORDER_SUMMARY c JOIN (SELECT rowid AS id, rank AS score FROM COMMANDES_FTS "
+           "WHERE COMMANDES_FTS MATCH ?) s ON s.id = c.id_commande";
+}
 
-    if (!currentStatusFilter.isEmpty()) {
-        conditions << "c.statut = '" + currentStatusFilter + "'";
+QString OrdersPage::listFilter(const QString &likePattern, const QString &status, QVariantList &values)
+{
+    QStringList conditions;
+    if (!likePattern.isEmpty()) {
+        conditions << "(c.client_nom LIKE ? OR CAST(c.id_commande AS TEXT) LIKE ? OR c.produits LIKE ?)";
+        values << likePattern << likePattern << likePattern;
     }
-
-    if (!conditions.isEmpty()) {
-        countQueryStr += " AND " + conditions.join(" AND ");
+    if (!status.isEmpty()) {
+        conditions << "c.statut = ?";
+        values << status;
     }
+    return conditions.isEmpty() ? "1=1" : conditions.join(" AND ");
+}
+
+QString OrdersPage::listSql(const QString &source, const QString &filter, const KeysetPager &pager, int page)
+{
+    return QString("SELECT c.id_commande, c.date_commande, c.client_nom, c.vendeur_nom, "
+                   "c.statut, c.total, c.produits "
+                   "FROM %1 WHERE %2 AND %3 %4 %5")
+        .arg(source, filter, pager.seekCondition(page), pager.orderClause(page), pager.limitClause(page));
+}
 
-    QSqlQuery countQuery;
-    if (countQuery.exec(countQueryStr) && countQuery.next()) {
-        totalItems = countQuery.value("total").toInt();
-        totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-        if (totalPages == 0) totalPages = 1;
+QString OrdersPage::countSql(const QString &source, const QString &filter)
+{
+    return QString("SELECT COUNT(*) as total FROM %1 WHERE %2").arg(source, filter);
+}
+
+void OrdersPage::loadOrders()
+{
+    UiProfiler::Scope scope("OrdersPage::loadOrders");
+    // La liste lit ORDER_SUMMARY (client, vendeur et produits déjà calculés
+    // par triggers) : une page = un parcours d'index (date, id), sans jointure.
+    // Recherche plein texte sur COMMANDES_FTS ; sans FTS5, LIKE sur le résumé.
+    QString match = SearchIndex::isAvailable() ? SearchIndex::matchExpression(currentSearchText) : QString();
+    QString likePattern = "%" + currentSearchText.trimmed() + "%";
+    bool likeSearch = match.isEmpty() && !currentSearchText.trimmed().isEmpty();
+
+    QString source = listSource(match);
+    if (!match.isEmpty()) {
+        pager.setCustomOrder("s.score, c.date_commande DESC, c.id_commande DESC");
     } else {
-        totalItems = 0;
-        totalPages = 1;
+        pager.setCustomOrder(QString());
     }
+    pager.setFilterKey(currentSearchText + "|" + currentStatusFilter);
 
-    if (currentPage > totalPages) {
-        currentPage = totalPages;
+    QVariantList filterValues;
+    if (!match.isEmpty()) {
+        filterValues << match;
     }
+    QString filter = listFilter(likeSearch ? likePattern : QString(), currentStatusFilter, filterValues);
+
     if (currentPage < 1) {
         currentPage = 1;
     }
 
-    updatePaginationUI();
+    int pageIndex = currentPage - 1;
+    countQuery.table = "COMMANDES";
+    countQuery.filterKey = filterValues.isEmpty() ? QString() : currentSearchText + "|" + currentStatusFilter;
+    countQuery.sql = countSql(source, filter);
+    countQuery.bindValues = filterValues;
+    QString queryStr = listSql(source, filter, pager, pageIndex);
+    QVariantList pageValues = filterValues + pager.pageBindValues(pageIndex);
+
+    // Exécution sur le thread base de données ; une recherche plus récente
+    // annule celle-ci si elle n'a pas encore démarré.
+    bool reversed = pager.isReversed(pageIndex);
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    const CountQuery count = countQuery;
+    const int pageSize = pager.pageSize();
+    pendingLoad = DatabaseService::instance().run<QueryResult>(
+        [count, queryStr, pageValues, pageIndex, pageSize, reversed](QSqlDatabase &db) {
+            QueryResult result = DatabaseService::select(db, queryStr, pageValues);
+            if (result.ok) {
+                CountCache::resolveTotal(db, count, pageIndex, pageSize, reversed, result);
+            }
+            return result;
+        });
+    pendingLoad.then(this, [this, generation, pageIndex, reversed](const QueryResult &result) {
+        if (generation == loadGeneration) {
+            displayOrders(result, pageIndex, reversed);
+        }
+    });
+}
 
-    QString queryStr = R"(
-        SELECT
-            c.id_commande,
-            c.date_commande,
-            cl.nom || ' ' || COALESCE(cl.prenom, '') as client_nom,
-            u.nom as vendeur_nom,
-            c.statut,
-            c.total,
-            GROUP_CONCAT(p.nom_produit, ', ') as produits
-        FROM COMMANDES c
-        LEFT JOIN CLIENTS cl ON c.id_client = cl.id_client
-        LEFT JOIN USERS u ON c.id_user = u.id_user
-        LEFT JOIN COMMANDE_DETAIL cd ON c.id_commande = cd.id_commande
-        LEFT JOIN PRODUITS p ON cd.id_produit = p.id_produit
-        WHERE 1=1
-    )";
-
-    if (!conditions.isEmpty()) {
-        queryStr += " AND " + conditions.join(" AND ");
+void OrdersPage::displayOrders(const QueryResult &result, int pageIndex, bool reversed)
+{
+    if (!result.ok) {
+        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement des commandes: " + result.error);
+        return;
     }
+    UiProfiler::Scope scope("OrdersPage::displayOrders");
 
-    queryStr += " GROUP BY c.id_commande, c.date_commande, cl.nom, cl.prenom, u.nom, c.statut, c.total "
-                "ORDER BY c.date_commande DESC "
-                "LIMIT " + QString::number(itemsPerPage) + " OFFSET " + QString::number((currentPage - 1) * itemsPerPage);
+    if (result.dataVersion >= 0) {
+        pager.setDataVersion(result.dataVersion);
+    }
+    totalItems = result.totalRows;
+    pager.setTotalRows(totalItems);
+    totalPages = pager.pageCount();
 
-    QSqlQuery query;
-    if (!query.exec(queryStr)) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement des commandes: " + query.lastError().text());
+    // Des commandes ont disparu depuis : on recharge la dernière page existante
+    if (totalPages > 0 && currentPage > totalPages) {
+        currentPage = totalPages;
+        loadOrders();
         return;
     }
 
-    int row = 0;
-    while (query.next()) {
+    ordersTable->setRowCount(0);
+
+    // Une page lue depuis la fin arrive en ordre croissant : on insère en tête.
+    // La ligne lue en plus n'est pas affichée.
+    pager.beginPage(pageIndex, reversed, result.rows.size());
+    const int visibleRows = pager.visibleRows(result.rows.size());
+    for (int i = 0; i < visibleRows; ++i) {
+        const QSqlRecord &record = result.rows.at(i);
+        int row = reversed ? 0 : ordersTable->rowCount();
         ordersTable->insertRow(row);
 
-        ordersTable->setItem(row, 0, new QTableWidgetItem(QString::number(query.value("id_commande").toInt())));
+        pager.collect(record.value("date_commande"), record.value("id_commande").toLongLong());
+        ordersTable->setItem(row, 0, new QTableWidgetItem(QString::number(record.value("id_commande").toInt())));
 
-        QString dateStr = query.value("date_commande").toString();
+        QString dateStr = record.value("date_commande").toString();
         QDateTime dateTime = QDateTime::fromString(dateStr, "yyyy-MM-ddTHH:mm:ss");
         if (!dateTime.isValid()) {
             dateTime = QDateTime::fromString(dateStr, "yyyy-MM-dd HH:mm:ss");
@@ -381,10 +416,10 @@ void OrdersPage::loadOrders()
         QString formattedDate = dateTime.isValid() ? dateTime.toString("dd/MM/yyyy HH:mm") : dateStr;
         ordersTable->setItem(row, 1, new QTableWidgetItem(formattedDate));
 
-        ordersTable->setItem(row, 2, new QTableWidgetItem(query.value("client_nom").toString().trimmed()));
-        ordersTable->setItem(row, 3, new QTableWidgetItem(query.value("vendeur_nom").toString()));
+        ordersTable->setItem(row, 2, new QTableWidgetItem(record.value("client_nom").toString().trimmed()));
+        ordersTable->setItem(row, 3, new QTableWidgetItem(record.value("vendeur_nom").toString()));
 
-        QString statut = query.value("statut").toString();
+        QString statut = record.value("statut").toString();
         QTableWidgetItem *statusItem = new QTableWidgetItem(statut);
 
         if (statut == "EN_COURS") {
@@ -400,10 +435,10 @@ void OrdersPage::loadOrders()
 
         ordersTable->setItem(row, 4, statusItem);
 
-        double total = query.value("total").toDouble();
+        double total = record.value("total").toDouble();
         ordersTable->setItem(row, 5, new QTableWidgetItem(QString("€%1").arg(QString::number(total, 'f', 2))));
 
-        QString produits = query.value("produits").toString();
+        QString produits = record.value("produits").toString();
         if (produits.isEmpty()) {
             produits = "Aucun produit";
         }
@@ -419,52 +454,14 @@ void OrdersPage::loadOrders()
             QPushButton *editBtn = new QPushButton("✏️");
             editBtn->setFixedSize(22, 22);
             editBtn->setCursor(Qt::PointingHandCursor);
-            editBtn->setStyleSheet(
-                "QPushButton {"
-                "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                "   stop:0 #667eea, stop:1 #764ba2);"
-                "   color: white;"
-                "   border: none;"
-                "   border-radius: 4px;"
-                "   font-size: 11px;"
-                "   font-weight: bold;"
-                "   padding: 0px;"
-                "}"
-                "QPushButton:hover {"
-                "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                "   stop:0 #5568d3, stop:1 #6a3a8a);"
-                "}"
-                "QPushButton:pressed {"
-                "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                "   stop:0 #4556b8, stop:1 #5a2a7a);"
-                "}"
-            );
+            editBtn->setProperty("rowAction", "edit");
 
             QPushButton *deleteBtn = new QPushButton("🗑️");
             deleteBtn->setFixedSize(22, 22);
             deleteBtn->setCursor(Qt::PointingHandCursor);
-            deleteBtn->setStyleSheet(
-                "QPushButton {"
-                "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                "   stop:0 #f56565, stop:1 #e53e3e);"
-                "   color: white;"
-                "   border: none;"
-                "   border-radius: 4px;"
-                "   font-size: 11px;"
-                "   font-weight: bold;"
-                "   padding: 0px;"
-                "}"
-                "QPushButton:hover {"
-                "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                "   stop:0 #e53e3e, stop:1 #c53030);"
-                "}"
-                "QPushButton:pressed {"
-                "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                "   stop:0 #c53030, stop:1 #742a2a);"
-                "}"
-            );
-
-            int idCommande = query.value("id_commande").toInt();
+            deleteBtn->setProperty("rowAction", "delete");
+
+            int idCommande = record.value("id_commande").toInt();
             connect(editBtn, &QPushButton::clicked, this, [this, idCommande]() {
                 onEditOrder(QString::number(idCommande));
             });
@@ -477,18 +474,29 @@ void OrdersPage::loadOrders()
 
             ordersTable->setCellWidget(row, 7, actionWidget);
         }
+    }
+    pager.endPage();
 
-        row++;
+    // Dernière page atteinte en avançant : le total s'en déduit
+    if (!pager.hasTotalRows() && !pager.hasNextPage()) {
+        totalItems = pageIndex * pager.pageSize() + visibleRows;
+        pager.setTotalRows(totalItems);
+        totalPages = pager.pageCount();
     }
+    updatePaginationUI();
 }
 
 void OrdersPage::updatePaginationUI()
 {
-    pageInfoLabel->setText(QString("Page %1 / %2").arg(currentPage).arg(totalPages));
+    if (totalPages > 0) {
+        pageInfoLabel->setText(QString("Page %1 / %2").arg(currentPage).arg(totalPages));
+    } else {
+        pageInfoLabel->setText(QString("Page %1").arg(currentPage));
+    }
     btnFirstPage->setEnabled(currentPage > 1);
     btnPreviousPage->setEnabled(currentPage > 1);
-    btnNextPage->setEnabled(currentPage < totalPages);
-    btnLastPage->setEnabled(currentPage < totalPages);
+    btnNextPage->setEnabled(pager.hasNextPage());
+    btnLastPage->setEnabled(pager.hasNextPage());
 }
 
 void OrdersPage::onSearchTextChanged(const QString &text)
@@ -521,7 +529,7 @@ void OrdersPage::onPreviousPageClicked()
 
 void OrdersPage::onNextPageClicked()
 {
-    if (currentPage < totalPages) {
+    if (pager.hasNextPage()) {
         currentPage++;
         loadOrders();
     }
@@ -529,8 +537,28 @@ void OrdersPage::onNextPageClicked()
 
 void OrdersPage::onLastPageClicked()
 {
-    currentPage = totalPages;
-    loadOrders();
+    if (pager.hasTotalRows()) {
+        currentPage = totalPages;
+        loadOrders();
+        return;
+    }
+
+    // Seul cas où le total filtré est compté (puis mémorisé)
+    const CountQuery count = countQuery;
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    DatabaseService::instance().run<int>([count](QSqlDatabase &db) {
+        return CountCache::count(db, count);
+    }).then(this, [this, generation](int total) {
+        if (generation != loadGeneration || total < 0) {
+            return;
+        }
+        totalItems = total;
+        pager.setTotalRows(total);
+        totalPages = pager.pageCount();
+        currentPage = totalPages;
+        loadOrders();
+    });
 }
 
 void OrdersPage::onRefreshClicked()
@@ -549,4 +577,21 @@ void OrdersPage::onEditOrder(const QString &orderId)
 
 void OrdersPage::onDeleteOrder(const QString &orderId)
 {
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this,
+        "Confirmation",
+        QString("Voulez-vous vraiment annuler la commande #%1 ?\n"
+                "Les produits seront remis en stock et le paiement annulé.").arg(orderId),
+        QMessageBox::Yes | QMessageBox::No
+    );
+
+    if (reply == QMessageBox::Yes) {
+        if (OrderRepository::cancel(orderId.toInt())) {
+            QMessageBox::information(this, "Succès", "Commande annulée avec succès.");
+            loadOrders();
+            emit orderCancelled();
+        } else {
+            QMessageBox::critical(this, "Erreur", "Erreur lors de l'annulation: " + OrderRepository::lastError());
+        }
+    }
 }
@@ -9,6 +9,11 @@
 #include <QPushButton>
 #include <QComboBox>
 #include <QLabel>
+#include <QFuture>
+#include "keysetpager.h"
+#include "databaseservice.h"
+#include "searchcontroller.h"
+#include "countcache.h"
 
 class OrdersPage : public QFrame
 {
@@ -16,8 +21,24 @@ class OrdersPage : public QFrame
 
 public:
     explicit OrdersPage(const QString &userRole, int userId, QWidget *parent = nullptr);
+
+    static QString styleRules();
+
+    // Requêtes de la liste, construites ici et vérifiées par QueryPlanCheck.
+    // listSource joint l'index plein texte quand match n'est pas vide ;
+    // listFilter ajoute à values les valeurs de ses paramètres.
+    static KeysetPager listPager(int pageSize);
+    static QString listSource(const QString &match);
+    static QString listFilter(const QString &likePattern, const QString &status, QVariantList &values);
+    static QString listSql(const QString &source, const QString &filter, const KeysetPager &pager, int page);
+    static QString countSql(const QString &source, const QString &filter);
+
     void loadOrders();
 
+signals:
+    // Commande annulée : stock et statistiques de ventes ont changé
+    void orderCancelled();
+
 private slots:
     void onSearchTextChanged(const QString &text);
     void onStatusFilterChanged(const QString &status);
@@ -32,12 +53,13 @@ private slots:
 
 private:
     void setupUI();
-    void setupDatabase();
     void applyFilters();
     void updatePaginationUI();
+    void displayOrders(const QueryResult &result, int pageIndex, bool reversed);
 
     QTableWidget *ordersTable;
     QLineEdit *searchInput;
+    SearchController *searchController;
     QComboBox *statusFilter;
     QPushButton *refreshBtn;
     
@@ -60,6 +82,10 @@ private:
     int itemsPerPage;
     int totalItems;
     int totalPages;
+    KeysetPager pager;
+    CountQuery countQuery;
+    QFuture<QueryResult> pendingLoad;
+    int loadGeneration;
 };
 
 #endif // ORDERSPAGE_H
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "ordersummary.h"
+#include "schemamigrator.h"
+
+namespace {
+const QString ClientOf = "(SELECT nom || ' ' || COALESCE(prenom, '') FROM CLIENTS WHERE id_client = %1)";
+const QString SellerOf = "(SELECT nom FROM USERS WHERE id_user = %1)";
+const QString LineCountOf = "(SELECT COUNT(*) FROM DETAILS_COMMANDE WHERE id_commande = %1)";
+const QString ProductsOf = "(SELECT COALESCE(GROUP_CONCAT(p.nom_produit, ', '), '') "
+                           "FROM DETAILS_COMMANDE d JOIN PRODUITS p ON p.id_produit = d.id_produit "
+                           "WHERE d.id_commande = %1)";
+
+// Recalcul des lignes d'une seule commande : coût proportionnel à sa taille.
+// Réservé aux suppressions et modifications de lignes, rares.
+QString refreshLines(const QString &commandeId)
+{
+    return QString("UPDATE ORDER_SUMMARY SET nb_lignes = %1, produits = %2 WHERE id_commande = %3; ")
+        .arg(LineCountOf.arg(commandeId), ProductsOf.arg(commandeId), commandeId);
+}
+
+// Ajout d'une ligne : compteur incrémenté et nom du produit ajouté en fin
+// de liste, sans relire les autres lignes. Le lot de lignes d'un encaissement
+// reste linéaire au lieu de recalculer la commande entière à chaque ligne.
+QString appendLine(const QString &row)
+{
+    const QString name = QString("(SELECT nom_produit FROM PRODUITS WHERE id_produit = %1.id_produit)").arg(row);
+    return QString("UPDATE ORDER_SUMMARY SET nb_lignes = nb_lignes + 1, "
+                   "produits = CASE WHEN %1 IS NULL THEN produits "
+                   "WHEN COALESCE(produits, '') = '' THEN %1 "
+                   "ELSE produits || ', ' || %1 END "
+                   "WHERE id_commande = %2.id_commande; ").arg(name, row);
+}
+}
+
+OrderSummary::OrderSummary() {}
+
+QStringList OrderSummary::createStatements()
+{
+    bool backfill = !SchemaMigrator::tableExists("ORDER_SUMMARY");
+
+    QStringList statements = {
+        "CREATE TABLE IF NOT EXISTS ORDER_SUMMARY ("
+        "id_commande INTEGER PRIMARY KEY, "
+        "date_commande DATETIME, "
+        "statut TEXT, "
+        "total REAL DEFAULT 0, "
+        "client_nom TEXT, "
+        "vendeur_nom TEXT, "
+        "nb_lignes INTEGER DEFAULT 0, "
+        "produits TEXT DEFAULT '')",
+
+        "CREATE INDEX IF NOT EXISTS idx_order_summary_date ON ORDER_SUMMARY(date_commande, id_commande)",
+        "CREATE INDEX IF NOT EXISTS idx_order_summary_statut_date ON ORDER_SUMMARY(statut, date_commande, id_commande)",
+
+        QString("CREATE TRIGGER ORDER_SUMMARY_AI AFTER INSERT ON COMMANDES BEGIN "
+                "INSERT OR REPLACE INTO ORDER_SUMMARY "
+                "(id_commande, date_commande, statut, total, client_nom, vendeur_nom, nb_lignes, produits) "
+                "VALUES (NEW.id_commande, NEW.date_commande, NEW.statut, NEW.total, %1, %2, %3, %4); "
+                "END").arg(ClientOf.arg("NEW.id_client"), SellerOf.arg("NEW.id_user"),
+                           LineCountOf.arg("NEW.id_commande"), ProductsOf.arg("NEW.id_commande")),
+
+        QString("CREATE TRIGGER ORDER_SUMMARY_AU "
+                "AFTER UPDATE OF date_commande, statut, total, id_client, id_user ON COMMANDES BEGIN "
+                "UPDATE ORDER_SUMMARY SET date_commande = NEW.date_commande, statut = NEW.statut, "
+                "total = NEW.total, client_nom = %1, vendeur_nom = %2 "
+                "WHERE id_commande = NEW.id_commande; "
+                "END").arg(ClientOf.arg("NEW.id_client"), SellerOf.arg("NEW.id_user")),
+
+        "CREATE TRIGGER ORDER_SUMMARY_AD AFTER DELETE ON COMMANDES BEGIN "
+        "DELETE FROM ORDER_SUMMARY WHERE id_commande = OLD.id_commande; "
+        "END",
+
+        "CREATE TRIGGER ORDER_SUMMARY_DETAIL_AI AFTER INSERT ON DETAILS_COMMANDE BEGIN "
+        + appendLine("NEW") + "END",
+
+        "CREATE TRIGGER ORDER_SUMMARY_DETAIL_AD AFTER DELETE ON DETAILS_COMMANDE BEGIN "
+        + refreshLines("OLD.id_commande") + "END",
+
+        "CREATE TRIGGER ORDER_SUMMARY_DETAIL_AU "
+        "AFTER UPDATE OF id_commande, id_produit ON DETAILS_COMMANDE BEGIN "
+        + refreshLines("OLD.id_commande") + refreshLines("NEW.id_commande") + "END",
+
+        QString("CREATE TRIGGER ORDER_SUMMARY_CLIENT_AU AFTER UPDATE OF nom, prenom ON CLIENTS BEGIN "
+                "UPDATE ORDER_SUMMARY SET client_nom = %1 "
+                "WHERE id_commande IN (SELECT id_commande FROM COMMANDES WHERE id_client = NEW.id_client); "
+                "END").arg(ClientOf.arg("NEW.id_client")),
+
+        QString("CREATE TRIGGER ORDER_SUMMARY_USER_AU AFTER UPDATE OF nom ON USERS BEGIN "
+                "UPDATE ORDER_SUMMARY SET vendeur_nom = %1 "
+                "WHERE id_commande IN (SELECT id_commande FROM COMMANDES WHERE id_user = NEW.id_user); "
+                "END").arg(SellerOf.arg("NEW.id_user")),
+
+        QString("CREATE TRIGGER ORDER_SUMMARY_PRODUIT_AU AFTER UPDATE OF nom_produit ON PRODUITS BEGIN "
+                "UPDATE ORDER_SUMMARY SET produits = %1 "
+                "WHERE id_commande IN (SELECT id_commande FROM DETAILS_COMMANDE WHERE id_produit = NEW.id_produit); "
+                "END").arg(ProductsOf.arg("ORDER_SUMMARY.id_commande"))
+    };
+    if (backfill) {
+        statements << backfillStatement();
+    }
+    return statements;
+}
+
+QString OrderSummary::backfillStatement()
+{
+    return QString("INSERT INTO ORDER_SUMMARY "
+                   "(id_commande, date_commande, statut, total, client_nom, vendeur_nom, nb_lignes, produits) "
+                   "SELECT c.id_commande, c.date_commande, c.statut, c.total, %1, %2, %3, %4 FROM COMMANDES c")
+        .arg(ClientOf.arg("c.id_client"), SellerOf.arg("c.id_user"),
+             LineCountOf.arg("c.id_commande"), ProductsOf.arg("c.id_commande"));
+}
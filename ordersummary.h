@@ -0,0 +1,24 @@
+#ifndef ORDERSUMMARY_H
+#define ORDERSUMMARY_H
+
+#include <QString>
+#include <QStringList>
+
+// Table ORDER_SUMMARY : une ligne par commande avec le nom du client, du
+// vendeur, le nombre de lignes et la liste des produits déjà calculés.
+// Des triggers la tiennent à jour, la liste des commandes la lit par un
+// simple parcours d'index (date, id) au lieu de joindre cinq tables.
+class OrderSummary
+{
+public:
+    OrderSummary();
+
+    // Table, index et triggers (migration du schéma), avec le remplissage
+    // initial si la table n'existe pas encore
+    static QStringList createStatements();
+
+private:
+    static QString backfillStatement();
+};
+
+#endif // ORDERSUMMARY_H
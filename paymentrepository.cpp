@@ -0,0 +1,45 @@
+#include "paymentrepository.h"
+#include "repositoryerror.h"
+
+namespace {
+thread_local RepositoryError repositoryError;
+}
+
+PaymentRepository::PaymentRepository() {}
+
+QString PaymentRepository::lastError()
+{
+    return repositoryError.text();
+}
+
+int PaymentRepository::insert(int commandeId, double montant, const QString &statut, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "INSERT INTO PAIEMENTS (id_commande, montant, statut) VALUES (?, ?, ?)");
+    if (!query) {
+        return -1;
+    }
+    query->bindValue(0, commandeId);
+    query->bindValue(1, montant);
+    query->bindValue(2, statut);
+
+    if (!repositoryError.exec(*query)) {
+        return -1;
+    }
+    return query->lastInsertId().toInt();
+}
+
+QString PaymentRepository::cancelForOrderSql()
+{
+    return "UPDATE PAIEMENTS SET statut = 'ANNULE' WHERE id_commande = ? AND statut <> 'ANNULE'";
+}
+
+bool PaymentRepository::cancelForOrder(int commandeId, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, cancelForOrderSql());
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, commandeId);
+    return repositoryError.exec(*query);
+}
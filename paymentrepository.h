@@ -0,0 +1,24 @@
+#ifndef PAYMENTREPOSITORY_H
+#define PAYMENTREPOSITORY_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// Accès à PAIEMENTS par requêtes préparées une fois par connexion (StatementCache)
+class PaymentRepository
+{
+public:
+    PaymentRepository();
+
+    static int insert(int commandeId, double montant, const QString &statut,
+                      const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Passe les paiements d'une commande à ANNULE
+    static bool cancelForOrder(int commandeId, const QSqlDatabase &db = QSqlDatabase::database());
+    // Requête de cancelForOrder(), vérifiée par QueryPlanCheck
+    static QString cancelForOrderSql();
+
+    static QString lastError();
+};
+
+#endif // PAYMENTREPOSITORY_H
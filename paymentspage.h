@@ -2,10 +2,12 @@
 #define PAYMENTSPAGE_H
 
 #include <QFrame>
-#include <QTableWidget>
+#include <QTableView>
 #include <QLineEdit>
 #include <QComboBox>
 #include <QPushButton>
+#include "searchcontroller.h"
+#include "paymenttablemodel.h"
 
 class PaymentsPage : public QFrame
 {
@@ -14,17 +16,23 @@ class PaymentsPage : public QFrame
 public:
     explicit PaymentsPage(QWidget *parent = nullptr);
 
+    static QString styleRules();
+
+public slots:
+    void loadPayments();
+
 private:
     void setupUI();
-    void loadPayments();
 
 private slots:
     void onSearchTextChanged(const QString &text);
     void onStatusFilterChanged(const QString &status);
 
 private:
-    QTableWidget *paymentsTable;
+    QTableView *paymentsTable;
+    PaymentTableModel *paymentsModel;
     QLineEdit *searchInput;
+    SearchController *searchController;
     QComboBox *statusFilter;
     QPushButton *refreshBtn;
 };
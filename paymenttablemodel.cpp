@@ -0,0 +1,175 @@
+#include "paymenttablemodel.h"
+#include <QSqlRecord>
+#include <QStringList>
+#include <QDebug>
+
+PaymentTableModel::PaymentTableModel(QObject *parent)
+    : QAbstractTableModel(parent), m_atEnd(false), m_fetching(false), m_generation(0)
+{
+}
+
+int PaymentTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int PaymentTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant PaymentTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size() || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const PaymentRow &payment = m_rows.at(index.row());
+    switch (index.column()) {
+    case IdColumn:
+        return QString::number(payment.id);
+    case CommandeColumn:
+        return QString::number(payment.commandeId);
+    case MontantColumn:
+        return QString::number(payment.montant, 'f', 2) + " €";
+    case DateColumn:
+        return QDateTime::fromString(payment.datePaiement, "yyyy-MM-dd HH:mm:ss").toString("dd/MM/yyyy hh:mm");
+    case StatutColumn:
+        return payment.statut;
+    case ClientColumn:
+        return payment.client;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant PaymentTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case IdColumn: return "N° Paiement";
+    case CommandeColumn: return "N° Commande";
+    case MontantColumn: return "Montant";
+    case DateColumn: return "Date";
+    case StatutColumn: return "Statut";
+    case ClientColumn: return "Client";
+    default: return QVariant();
+    }
+}
+
+bool PaymentTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !m_atEnd && !m_fetching;
+}
+
+void PaymentTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (canFetchMore(parent)) {
+        requestBatch();
+    }
+}
+
+void PaymentTableModel::setFilter(const QString &searchText, const QString &status)
+{
+    m_searchText = searchText.trimmed();
+    m_status = status;
+    reload();
+}
+
+void PaymentTableModel::reload()
+{
+    // Les lots d'un ancien filtre encore en route sont ignorés à l'arrivée
+    beginResetModel();
+    ++m_generation;
+    m_rows.clear();
+    m_atEnd = false;
+    m_fetching = false;
+    endResetModel();
+
+    requestBatch();
+}
+
+QString PaymentTableModel::batchSql(const QString &status, const QString &searchText, bool seek, QVariantList &values)
+{
+    QStringList conditions;
+    if (!status.isEmpty()) {
+        conditions << "p.statut = ?";
+        values << status;
+    }
+    if (!searchText.isEmpty()) {
+        QString pattern = "%" + searchText + "%";
+        conditions << "(CAST(p.id_commande AS TEXT) LIKE ? OR c.nom LIKE ?)";
+        values << pattern << pattern;
+    }
+    if (seek) {
+        conditions << "(p.date_paiement, p.id_paiement) < (?, ?)";
+    }
+
+    QString sql = "SELECT p.id_paiement, p.id_commande, p.montant, p.date_paiement, p.statut, c.nom "
+                  "FROM PAIEMENTS p "
+                  "LEFT JOIN COMMANDES cmd ON p.id_commande = cmd.id_commande "
+                  "LEFT JOIN CLIENTS c ON cmd.id_client = c.id_client ";
+    if (!conditions.isEmpty()) {
+        sql += "WHERE " + conditions.join(" AND ") + " ";
+    }
+    sql += "ORDER BY p.date_paiement DESC, p.id_paiement DESC LIMIT ?";
+    return sql;
+}
+
+void PaymentTableModel::requestBatch()
+{
+    m_fetching = true;
+
+    QVariantList values;
+    QString sql = batchSql(m_status, m_searchText, !m_rows.isEmpty(), values);
+    if (!m_rows.isEmpty()) {
+        values << m_rows.last().datePaiement << m_rows.last().id;
+    }
+    values << BatchSize;
+
+    int generation = m_generation;
+    DatabaseService::instance().run<QueryResult>([sql, values](QSqlDatabase &db) {
+        return DatabaseService::select(db, sql, values);
+    }).then(this, [this, generation](const QueryResult &result) {
+        onBatchLoaded(generation, result);
+    });
+}
+
+void PaymentTableModel::onBatchLoaded(int generation, const QueryResult &result)
+{
+    if (generation != m_generation) {
+        return;
+    }
+    m_fetching = false;
+
+    if (!result.ok) {
+        // Pas de nouvel essai automatique : la vue redemanderait à chaque défilement
+        m_atEnd = true;
+        qDebug() << "Erreur lors du chargement des paiements:" << result.error;
+        emit loadFailed(result.error);
+        return;
+    }
+
+    m_atEnd = result.rows.size() < BatchSize;
+    if (result.rows.isEmpty()) {
+        return;
+    }
+
+    int first = m_rows.size();
+    beginInsertRows(QModelIndex(), first, first + result.rows.size() - 1);
+    m_rows.reserve(first + result.rows.size());
+    for (const QSqlRecord &record : result.rows) {
+        PaymentRow payment;
+        payment.id = record.value(0).toInt();
+        payment.commandeId = record.value(1).toInt();
+        payment.montant = record.value(2).toDouble();
+        payment.datePaiement = record.value(3).toString();
+        payment.statut = record.value(4).toString();
+        payment.client = record.value(5).toString();
+        m_rows.append(payment);
+    }
+    endInsertRows();
+}
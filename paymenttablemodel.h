@@ -0,0 +1,73 @@
+#ifndef PAYMENTTABLEMODEL_H
+#define PAYMENTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QDateTime>
+#include <QVector>
+#include "databaseservice.h"
+
+struct PaymentRow {
+    int id = 0;
+    int commandeId = 0;
+    double montant = 0.0;
+    QString datePaiement;        // valeur brute : clé de pagination
+    QString statut;
+    QString client;
+};
+
+// Modèle de la liste des paiements, du plus récent au plus ancien. Les lignes
+// arrivent par lots à mesure que la vue défile (canFetchMore / fetchMore) ;
+// chaque lot reprend après la dernière ligne reçue (date, id) sans OFFSET.
+// Recherche et statut sont appliqués dans la requête, qui suit l'index
+// (statut, date_paiement). Les lots sont lus sur le thread base de données.
+class PaymentTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        IdColumn,
+        CommandeColumn,
+        MontantColumn,
+        DateColumn,
+        StatutColumn,
+        ClientColumn,
+        ColumnCount
+    };
+
+    explicit PaymentTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // Vide la liste et relit le premier lot avec ce filtre (statut vide = tous)
+    void setFilter(const QString &searchText, const QString &status);
+    void reload();
+
+    // Requête d'un lot, vérifiée par QueryPlanCheck ; ajoute à values celles
+    // du statut et de la recherche. seek : reprise après (date, id) < (?, ?).
+    static QString batchSql(const QString &status, const QString &searchText, bool seek, QVariantList &values);
+
+signals:
+    void loadFailed(const QString &error);
+
+private:
+    void requestBatch();
+    void onBatchLoaded(int generation, const QueryResult &result);
+
+    static const int BatchSize = 100;
+
+    QVector<PaymentRow> m_rows;
+    QString m_searchText;
+    QString m_status;
+    bool m_atEnd;
+    bool m_fetching;
+    int m_generation;
+};
+
+#endif // PAYMENTTABLEMODEL_H
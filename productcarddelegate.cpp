@@ -0,0 +1,335 @@
+#include "productcarddelegate.h"
+#include "productlistmodel.h"
+#include "thememanager.h"
+#include "thumbnailcache.h"
+#include <QAbstractItemView>
+#include <QPainter>
+#include <QPainterPath>
+#include <QMouseEvent>
+#include <QLinearGradient>
+#include <QPixmap>
+
+namespace {
+const int ContentMargin = 16;
+const int ButtonHeight = 36;
+const int QuantityButtonSize = 32;
+const int BottomMargin = 12;
+const qreal CardRadius = 18.0;
+}
+
+ProductCardDelegate::ProductCardDelegate(Mode mode, QObject *parent)
+    : QStyledItemDelegate(parent), m_mode(mode), m_hoverButton(NoButton)
+{
+    connect(&ThumbnailCache::instance(), &ThumbnailCache::thumbnailReady,
+            this, &ProductCardDelegate::onThumbnailReady);
+}
+
+QSize ProductCardDelegate::sizeHint(const QStyleOptionViewItem &, const QModelIndex &) const
+{
+    return QSize(CardWidth, CardHeight);
+}
+
+QRect ProductCardDelegate::buttonRect(const QRect &card, Button button) const
+{
+    int bottom = card.bottom() - BottomMargin;
+    int innerWidth = card.width() - 2 * ContentMargin;
+
+    switch (button) {
+    case EditButton:
+    case DeleteButton: {
+        if (m_mode != AdminMode) {
+            return QRect();
+        }
+        int width = (innerWidth - 8) / 2;
+        int x = card.left() + ContentMargin + (button == DeleteButton ? width + 8 : 0);
+        return QRect(x, bottom - ButtonHeight, width, ButtonHeight);
+    }
+    case MinusButton:
+        if (m_mode != VendorMode) {
+            return QRect();
+        }
+        return QRect(card.left() + ContentMargin, bottom - QuantityButtonSize,
+                     QuantityButtonSize, QuantityButtonSize);
+    case PlusButton:
+        if (m_mode != VendorMode) {
+            return QRect();
+        }
+        return QRect(card.right() - ContentMargin - QuantityButtonSize, bottom - QuantityButtonSize,
+                     QuantityButtonSize, QuantityButtonSize);
+    default:
+        return QRect();
+    }
+}
+
+ProductCardDelegate::Button ProductCardDelegate::buttonAt(const QRect &card, const QPoint &pos) const
+{
+    const Button buttons[] = {EditButton, DeleteButton, MinusButton, PlusButton};
+    for (Button button : buttons) {
+        if (buttonRect(card, button).contains(pos)) {
+            return button;
+        }
+    }
+    return NoButton;
+}
+
+void ProductCardDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    ThemeManager& theme = ThemeManager::instance();
+    bool lightMode = theme.currentTheme() == ThemeManager::LightMode;
+
+    QRect card(option.rect.topLeft(), QSize(CardWidth, CardHeight));
+    card.moveCenter(option.rect.center());
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::TextAntialiasing);
+
+    // Ombre légère, peinte plutôt qu'un QGraphicsDropShadowEffect par carte
+    QPainterPath shadowPath;
+    shadowPath.addRoundedRect(QRectF(card).translated(0, lightMode ? 4 : 6), CardRadius, CardRadius);
+    painter->fillPath(shadowPath, QColor(0, 0, 0, lightMode ? 20 : 40));
+
+    QPainterPath cardPath;
+    cardPath.addRoundedRect(QRectF(card), CardRadius, CardRadius);
+    QLinearGradient cardGradient(card.topLeft(), card.bottomRight());
+    if (lightMode) {
+        cardGradient.setColorAt(0, QColor("#ffffff"));
+        cardGradient.setColorAt(1, QColor("#f9fafb"));
+    } else {
+        cardGradient.setColorAt(0, QColor("#1f2937"));
+        cardGradient.setColorAt(1, QColor("#111827"));
+    }
+    painter->fillPath(cardPath, cardGradient);
+
+    // Bloc pas encore reçu du thread base de données : carte vide
+    if (!index.data(ProductListModel::ProductIdRole).isValid()) {
+        painter->restore();
+        return;
+    }
+
+    // Image
+    painter->save();
+    painter->setClipPath(cardPath);
+    QRect imageRect(card.left(), card.top(), card.width(), ImageHeight);
+    paintImage(painter, imageRect, index);
+
+    QRect contentRect(card.left(), imageRect.bottom() + 1, card.width(), card.height() - ImageHeight);
+    painter->fillRect(contentRect, lightMode ? QColor("#ffffff") : theme.surfaceColor());
+    painter->restore();
+
+    int x = card.left() + ContentMargin;
+    int innerWidth = card.width() - 2 * ContentMargin;
+    int y = contentRect.top() + 14;
+
+    // Nom du produit
+    QFont nameFont = option.font;
+    nameFont.setPixelSize(17);
+    nameFont.setWeight(QFont::ExtraBold);
+    painter->setFont(nameFont);
+    painter->setPen(lightMode ? QColor("#111827") : theme.textColor());
+    QString name = index.data(ProductListModel::NameRole).toString();
+    QRect nameRect(x, y, innerWidth, 24);
+    painter->drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      QFontMetrics(nameFont).elidedText(name, Qt::ElideRight, innerWidth));
+    y = nameRect.bottom() + 4;
+
+    // Prix
+    QFont priceFont = option.font;
+    priceFont.setPixelSize(28);
+    priceFont.setWeight(QFont::Black);
+    painter->setFont(priceFont);
+    painter->setPen(theme.primaryColor());
+    double prixVente = index.data(ProductListModel::PriceRole).toDouble();
+    QRect priceRect(x, y, innerWidth, 38);
+    painter->drawText(priceRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      QString("€%1").arg(QString::number(prixVente, 'f', 2)));
+    y = priceRect.bottom() + 6;
+
+    // Badge de stock
+    int stock = index.data(ProductListModel::StockRole).toInt();
+    int seuilAlerte = index.data(ProductListModel::AlertThresholdRole).toInt();
+    bool lowStock = stock <= seuilAlerte || stock == 0;
+    QString stockText = stock == 0 ? "⚠️ Rupture" : QString("✓ %1 en stock").arg(stock);
+
+    QFont stockFont = option.font;
+    stockFont.setPixelSize(13);
+    stockFont.setWeight(QFont::Bold);
+    stockFont.setLetterSpacing(QFont::AbsoluteSpacing, 0.5);
+    int badgeWidth = qMin(170, QFontMetrics(stockFont).horizontalAdvance(stockText) + 32);
+    QRect badgeRect(x, y, badgeWidth, 28);
+    QLinearGradient badgeGradient(badgeRect.topLeft(), badgeRect.topRight());
+    badgeGradient.setColorAt(0, lowStock ? QColor("#fee2e2") : QColor("#d1fae5"));
+    badgeGradient.setColorAt(1, lowStock ? QColor("#fecaca") : QColor("#a7f3d0"));
+    painter->fillRect(badgeRect, badgeGradient);
+    painter->setFont(stockFont);
+    painter->setPen(lowStock ? QColor("#dc2626") : QColor("#10b981"));
+    painter->drawText(badgeRect, Qt::AlignCenter, stockText);
+    y = badgeRect.bottom() + 8;
+
+    // Description, limitée à l'espace restant au-dessus des boutons
+    int actionsTop = card.bottom() - BottomMargin - ButtonHeight - 6;
+    QFont descFont = option.font;
+    descFont.setPixelSize(13);
+    painter->setFont(descFont);
+    painter->setPen(lightMode ? QColor("#6b7280") : theme.textSecondaryColor());
+    QRect descRect(x, y, innerWidth, qMax(0, actionsTop - y));
+    painter->save();
+    painter->setClipRect(descRect);
+    painter->drawText(descRect, Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap,
+                      index.data(ProductListModel::DescriptionRole).toString());
+    painter->restore();
+
+    bool hoveredCard = m_hoverIndex == index;
+    QFont buttonFont = option.font;
+    buttonFont.setPixelSize(13);
+    buttonFont.setWeight(QFont::Bold);
+    painter->setFont(buttonFont);
+
+    if (m_mode == AdminMode) {
+        paintButton(painter, buttonRect(card, EditButton), "✏️ Éditer",
+                    QColor("#667eea"), QColor("#764ba2"), Qt::white,
+                    hoveredCard && m_hoverButton == EditButton);
+        paintButton(painter, buttonRect(card, DeleteButton), "🗑️ Supprimer",
+                    QColor("#f56565"), QColor("#e53e3e"), Qt::white,
+                    hoveredCard && m_hoverButton == DeleteButton);
+    } else {
+        QFont qtyButtonFont = option.font;
+        qtyButtonFont.setPixelSize(16);
+        qtyButtonFont.setBold(true);
+        painter->setFont(qtyButtonFont);
+        paintButton(painter, buttonRect(card, MinusButton), "−",
+                    QColor("#e5e7eb"), QColor("#e5e7eb"), QColor("#374151"),
+                    hoveredCard && m_hoverButton == MinusButton);
+        paintButton(painter, buttonRect(card, PlusButton), "+",
+                    QColor("#e5e7eb"), QColor("#e5e7eb"), QColor("#374151"),
+                    hoveredCard && m_hoverButton == PlusButton);
+
+        QFont qtyFont = option.font;
+        qtyFont.setPixelSize(14);
+        qtyFont.setWeight(QFont::ExtraBold);
+        painter->setFont(qtyFont);
+        painter->setPen(lightMode ? QColor("#1f2937") : theme.textColor());
+        QRect minusRect = buttonRect(card, MinusButton);
+        QRect plusRect = buttonRect(card, PlusButton);
+        QRect qtyRect(minusRect.right() + 1, minusRect.top(),
+                      plusRect.left() - minusRect.right() - 1, minusRect.height());
+        painter->drawText(qtyRect, Qt::AlignCenter,
+                          QString::number(index.data(ProductListModel::BasketQuantityRole).toInt()));
+    }
+
+    painter->restore();
+}
+
+void ProductCardDelegate::paintButton(QPainter *painter, const QRect &rect, const QString &text,
+                                      const QColor &from, const QColor &to, const QColor &textColor, bool hovered) const
+{
+    QLinearGradient gradient(rect.topLeft(), rect.bottomRight());
+    gradient.setColorAt(0, hovered ? from.darker(112) : from);
+    gradient.setColorAt(1, hovered ? to.darker(112) : to);
+
+    QPainterPath path;
+    path.addRoundedRect(QRectF(rect), 8, 8);
+    painter->fillPath(path, gradient);
+    painter->setPen(textColor);
+    painter->drawText(rect, Qt::AlignCenter, text);
+}
+
+void ProductCardDelegate::paintImage(QPainter *painter, const QRect &rect, const QModelIndex &index) const
+{
+    const QString imagePath = index.data(ProductListModel::ImagePathRole).toString();
+    QLinearGradient placeholder(rect.topLeft(), rect.bottomRight());
+    placeholder.setColorAt(0, QColor("#f0f4ff"));
+    placeholder.setColorAt(0.5, QColor("#e8f2ff"));
+    placeholder.setColorAt(1, QColor("#f3e8ff"));
+    painter->fillRect(rect, placeholder);
+
+    // La miniature arrive de façon asynchrone ; en attendant on peint le substitut
+    QPixmap pixmap = ThumbnailCache::instance().thumbnail(imagePath, rect.size());
+    if (!pixmap.isNull()) {
+        QRect target(QPoint(0, 0), pixmap.size().scaled(rect.size(), Qt::KeepAspectRatio));
+        target.moveCenter(rect.center());
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+        painter->drawPixmap(target, pixmap);
+    } else {
+        if (!imagePath.isEmpty()) {
+            QList<QPersistentModelIndex> &waiting = m_waitingThumbnails[imagePath];
+            waiting.removeIf([](const QPersistentModelIndex &card) { return !card.isValid(); });
+            if (!waiting.contains(index)) {
+                waiting.append(index);
+            }
+        }
+        QFont iconFont = painter->font();
+        iconFont.setPixelSize(56);
+        painter->setFont(iconFont);
+        painter->setPen(QColor("#cbd5e0"));
+        painter->drawText(rect, Qt::AlignCenter, "📦");
+    }
+}
+
+void ProductCardDelegate::onThumbnailReady(const QString &imagePath)
+{
+    // Seules les cartes qui attendaient cette image sont repeintes
+    const QList<QPersistentModelIndex> waiting = m_waitingThumbnails.take(imagePath);
+    for (const QPersistentModelIndex &index : waiting) {
+        if (index.isValid()) {
+            emit thumbnailLoaded(index);
+        }
+    }
+}
+
+bool ProductCardDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                      const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    QRect card(option.rect.topLeft(), QSize(CardWidth, CardHeight));
+    card.moveCenter(option.rect.center());
+
+    switch (event->type()) {
+    case QEvent::MouseMove: {
+        auto *mouseEvent = static_cast<QMouseEvent*>(event);
+        Button hovered = buttonAt(card, mouseEvent->position().toPoint());
+        if (m_hoverIndex != index || m_hoverButton != hovered) {
+            const QPersistentModelIndex previous = m_hoverIndex;
+            m_hoverIndex = index;
+            m_hoverButton = hovered;
+            if (auto *view = qobject_cast<QAbstractItemView*>(const_cast<QWidget*>(option.widget))) {
+                view->viewport()->setCursor(hovered == NoButton ? Qt::ArrowCursor : Qt::PointingHandCursor);
+                // Ancienne et nouvelle carte survolées seulement
+                if (previous.isValid() && previous != index) {
+                    view->update(previous);
+                }
+                view->update(index);
+            }
+        }
+        return false;
+    }
+    case QEvent::MouseButtonRelease: {
+        auto *mouseEvent = static_cast<QMouseEvent*>(event);
+        if (mouseEvent->button() != Qt::LeftButton) {
+            return false;
+        }
+        QVariant productData = index.data(ProductListModel::ProductIdRole);
+        if (!productData.isValid()) {
+            return false;
+        }
+        int productId = productData.toInt();
+        switch (buttonAt(card, mouseEvent->position().toPoint())) {
+        case EditButton:
+            emit editRequested(productId);
+            return true;
+        case DeleteButton:
+            emit deleteRequested(productId);
+            return true;
+        case MinusButton:
+            emit quantityDecrementRequested(index);
+            return true;
+        case PlusButton:
+            emit quantityIncrementRequested(index);
+            return true;
+        default:
+            return false;
+        }
+    }
+    default:
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef PRODUCTCARDDELEGATE_H
+#define PRODUCTCARDDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+#include <QHash>
+#include <QList>
+
+// Peint la carte produit directement, sans arbre de widgets par produit.
+// Les boutons de la carte sont des zones testées au clic dans editorEvent().
+class ProductCardDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    enum Mode {
+        AdminMode,   // Éditer / Supprimer
+        VendorMode   // Quantité − / +
+    };
+
+    enum Button {
+        NoButton,
+        EditButton,
+        DeleteButton,
+        MinusButton,
+        PlusButton
+    };
+
+    static const int CardWidth = 270;
+    static const int CardHeight = 360;
+    static const int ImageHeight = 160;
+
+    explicit ProductCardDelegate(Mode mode, QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+signals:
+    void editRequested(int productId);
+    void deleteRequested(int productId);
+    void quantityDecrementRequested(const QModelIndex &index);
+    void quantityIncrementRequested(const QModelIndex &index);
+    // Miniature arrivée pour une carte peinte avec son substitut
+    void thumbnailLoaded(const QModelIndex &index);
+
+private:
+    QRect buttonRect(const QRect &card, Button button) const;
+    Button buttonAt(const QRect &card, const QPoint &pos) const;
+    void paintButton(QPainter *painter, const QRect &rect, const QString &text,
+                     const QColor &from, const QColor &to, const QColor &textColor, bool hovered) const;
+    void paintImage(QPainter *painter, const QRect &rect, const QModelIndex &index) const;
+    void onThumbnailReady(const QString &imagePath);
+
+    Mode m_mode;
+    QPersistentModelIndex m_hoverIndex;
+    Button m_hoverButton;
+    mutable QHash<QString, QList<QPersistentModelIndex>> m_waitingThumbnails;  // chemin -> cartes en attente
+};
+
+#endif // PRODUCTCARDDELEGATE_H
@@ -1,4 +1,7 @@
 #include "productdialog.h"
+#include "productrepository.h"
+#include "thumbnailcache.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QHBoxLayout>
@@ -6,6 +9,7 @@
 #include <QMessageBox>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QStyle>
 #include <QFileDialog>
 #include <QPixmap>
 #include <QDir>
@@ -16,6 +20,7 @@
 ProductDialog::ProductDialog(QWidget *parent, int productId)
     : QDialog(parent), currentProductId(productId), selectedImagePath("")
 {
+    UiProfiler::Scope scope("ProductDialog::ProductDialog");
     setupUI();
     if (productId != -1) {
         loadProduct(productId);
@@ -27,7 +32,7 @@ void ProductDialog::setupUI()
     setWindowTitle(currentProductId == -1 ? "Ajouter un produit" : "Modifier le produit");
     setMinimumWidth(600);
     setModal(true);
-    setStyleSheet("QDialog { background: #0f172a; }");
+    setObjectName("productDialog");
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setSpacing(20);
@@ -35,7 +40,7 @@ void ProductDialog::setupUI()
 
     // Titre
     QLabel *title = new QLabel(currentProductId == -1 ? "➕ Nouveau Produit" : "✏️ Modifier le Produit", this);
-    title->setStyleSheet("font-size: 20px; font-weight: bold; color: #f1f5f9;");
+    title->setObjectName("dialogTitle");
     mainLayout->addWidget(title);
 
     // Formulaire
@@ -75,79 +80,26 @@ void ProductDialog::setupUI()
     QHBoxLayout *imageLayout = new QHBoxLayout();
     lblImagePreview = new QLabel(this);
     lblImagePreview->setFixedSize(120, 120);
-    lblImagePreview->setStyleSheet(
-        "border: 2px dashed #334155; "
-        "border-radius: 8px; "
-        "background: #1e293b;"
-        "color: #94a3b8;"
-    );
+    lblImagePreview->setObjectName("imagePreview");
     lblImagePreview->setAlignment(Qt::AlignCenter);
     lblImagePreview->setText("📷\nAucune image");
 
     btnSelectImage = new QPushButton("Choisir une image", this);
     btnSelectImage->setMinimumHeight(40);
-    btnSelectImage->setStyleSheet(
-        "QPushButton {"
-        "   background: #667eea;"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 6px;"
-        "   padding: 8px 16px;"
-        "   font-size: 14px;"
-        "   font-weight: bold;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #5568d3;"
-        "}"
-    );
+    btnSelectImage->setObjectName("selectImageButton");
     connect(btnSelectImage, &QPushButton::clicked, this, &ProductDialog::onSelectImage);
 
     imageLayout->addWidget(lblImagePreview);
     imageLayout->addWidget(btnSelectImage);
     imageLayout->addStretch();
 
-    // Style des inputs
-    QString inputStyle =
-        "QLineEdit, QTextEdit {"
-        "   border: 2px solid #334155;"
-        "   border-radius: 6px;"
-        "   padding: 8px 12px;"
-        "   font-size: 14px;"
-        "   background: #1e293b;"
-        "   color: #f1f5f9;"
-        "}"
-        "QLineEdit:focus, QTextEdit:focus {"
-        "   border-color: #667eea;"
-        "   background: #1e293b;"
-        "}"
-        "QLineEdit::placeholder, QTextEdit::placeholder {"
-        "   color: #64748b;"
-        "}";
-
-    txtNom->setStyleSheet(inputStyle);
-    txtDescription->setStyleSheet(inputStyle + " QTextEdit { max-height: 120px; }");
-    txtPrixVente->setStyleSheet(inputStyle);
-    txtPrixAchat->setStyleSheet(inputStyle);
-    txtStock->setStyleSheet(inputStyle);
-    txtSeuilAlerte->setStyleSheet(inputStyle);
-
-    // Style des labels
-    QString labelStyle = "QLabel { color: #f1f5f9; }";
-    
     QLabel *nomLabel = new QLabel("Nom du produit *", this);
-    nomLabel->setStyleSheet(labelStyle);
     QLabel *descLabel = new QLabel("Description", this);
-    descLabel->setStyleSheet(labelStyle);
     QLabel *prixVenteLabel = new QLabel("Prix de vente (€) *", this);
-    prixVenteLabel->setStyleSheet(labelStyle);
     QLabel *prixAchatLabel = new QLabel("Prix d'achat (€)", this);
-    prixAchatLabel->setStyleSheet(labelStyle);
     QLabel *stockLabel = new QLabel("Stock *", this);
-    stockLabel->setStyleSheet(labelStyle);
     QLabel *seuilLabel = new QLabel("Seuil d'alerte", this);
-    seuilLabel->setStyleSheet(labelStyle);
     QLabel *imageLabel = new QLabel("Image du produit", this);
-    imageLabel->setStyleSheet(labelStyle);
 
     formLayout->addRow(nomLabel, txtNom);
     formLayout->addRow(descLabel, txtDescription);
@@ -165,8 +117,68 @@ void ProductDialog::setupUI()
 
     btnSave = new QPushButton("💾 Enregistrer", this);
     btnSave->setMinimumHeight(45);
-    btnSave->setStyleSheet(
-        "QPushButton {"
+    btnSave->setObjectName("saveButton");
+    connect(btnSave, &QPushButton::clicked, this, &ProductDialog::onSave);
+
+    btnCancel = new QPushButton("❌ Annuler", this);
+    btnCancel->setMinimumHeight(45);
+    btnCancel->setObjectName("cancelButton");
+    connect(btnCancel, &QPushButton::clicked, this, &ProductDialog::onCancel);
+
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(btnSave);
+    buttonLayout->addWidget(btnCancel);
+
+    mainLayout->addLayout(buttonLayout);
+}
+
+QString ProductDialog::styleRules()
+{
+    return QString(
+        "QDialog#productDialog {"
+        "   background: palette(window);"
+        "}"
+        "#productDialog QLabel {"
+        "   color: palette(text);"
+        "}"
+        "#productDialog QLabel#dialogTitle {"
+        "   font-size: 20px;"
+        "   font-weight: bold;"
+        "}"
+        "#productDialog QLabel#imagePreview {"
+        "   border: 2px dashed palette(mid);"
+        "   border-radius: 8px;"
+        "   background: palette(button);"
+        "   color: palette(placeholder-text);"
+        "}"
+        "#productDialog QLabel#imagePreview[hasImage=\"true\"] {"
+        "   border: 2px solid #10b981;"
+        "   background: palette(window);"
+        "}"
+        "#productDialog QLineEdit, #productDialog QTextEdit {"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 6px;"
+        "   padding: 8px 12px;"
+        "   font-size: 14px;"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "}"
+        "#productDialog QLineEdit:focus, #productDialog QTextEdit:focus {"
+        "   border-color: palette(highlight);"
+        "}"
+        "#productDialog QPushButton#selectImageButton {"
+        "   background: #667eea;"
+        "   color: white;"
+        "   border: none;"
+        "   border-radius: 6px;"
+        "   padding: 8px 16px;"
+        "   font-size: 14px;"
+        "   font-weight: bold;"
+        "}"
+        "#productDialog QPushButton#selectImageButton:hover {"
+        "   background: #5568d3;"
+        "}"
+        "#productDialog QPushButton#saveButton {"
         "   background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1, stop: 0 #10b981, stop: 1 #059669);"
         "   color: white;"
         "   border: none;"
@@ -175,19 +187,13 @@ void ProductDialog::setupUI()
         "   font-size: 15px;"
         "   font-weight: bold;"
         "}"
-        "QPushButton:hover {"
+        "#productDialog QPushButton#saveButton:hover {"
         "   background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1, stop: 0 #059669, stop: 1 #047857);"
         "}"
-        "QPushButton:pressed {"
+        "#productDialog QPushButton#saveButton:pressed {"
         "   background: #047857;"
         "}"
-    );
-    connect(btnSave, &QPushButton::clicked, this, &ProductDialog::onSave);
-
-    btnCancel = new QPushButton("❌ Annuler", this);
-    btnCancel->setMinimumHeight(45);
-    btnCancel->setStyleSheet(
-        "QPushButton {"
+        "#productDialog QPushButton#cancelButton {"
         "   background: transparent;"
         "   color: #e53e3e;"
         "   border: 2px solid #e53e3e;"
@@ -196,38 +202,28 @@ void ProductDialog::setupUI()
         "   font-size: 15px;"
         "   font-weight: bold;"
         "}"
-        "QPushButton:hover {"
+        "#productDialog QPushButton#cancelButton:hover {"
         "   background: #e53e3e;"
         "   color: white;"
         "}"
-        "QPushButton:pressed {"
+        "#productDialog QPushButton#cancelButton:pressed {"
         "   background: #c53030;"
         "   border-color: #c53030;"
         "}"
     );
-    connect(btnCancel, &QPushButton::clicked, this, &ProductDialog::onCancel);
-
-    buttonLayout->addStretch();
-    buttonLayout->addWidget(btnSave);
-    buttonLayout->addWidget(btnCancel);
-
-    mainLayout->addLayout(buttonLayout);
 }
 
 void ProductDialog::loadProduct(int productId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT nom_produit, description, photo_produit, prix_vente, prix_achat, stock, seuil_alerte FROM PRODUITS WHERE id_produit = :id");
-    query.bindValue(":id", productId);
-
-    if (query.exec() && query.next()) {
-        txtNom->setText(query.value(0).toString());
-        txtDescription->setText(query.value(1).toString());
-        selectedImagePath = query.value(2).toString();
-        txtPrixVente->setText(QString::number(query.value(3).toDouble(), 'f', 2));
-        txtPrixAchat->setText(query.value(4).isNull() ? "" : QString::number(query.value(4).toDouble(), 'f', 2));
-        txtStock->setText(QString::number(query.value(5).toInt()));
-        txtSeuilAlerte->setText(QString::number(query.value(6).toInt()));
+    Product product;
+    if (ProductRepository::find(productId, product)) {
+        txtNom->setText(product.nom);
+        txtDescription->setText(product.description);
+        selectedImagePath = product.photo;
+        txtPrixVente->setText(QString::number(product.prixVente, 'f', 2));
+        txtPrixAchat->setText(product.hasPrixAchat ? QString::number(product.prixAchat, 'f', 2) : "");
+        txtStock->setText(QString::number(product.stock));
+        txtSeuilAlerte->setText(QString::number(product.seuilAlerte));
 
         updateImagePreview();
     }
@@ -238,19 +234,25 @@ void ProductDialog::updateImagePreview()
     if (!selectedImagePath.isEmpty() && QFile::exists(selectedImagePath)) {
         QPixmap pixmap(selectedImagePath);
         lblImagePreview->setPixmap(pixmap.scaled(120, 120, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        lblImagePreview->setStyleSheet("border: 2px solid #10b981; border-radius: 8px;");
+        setHasImage(true);
     } else {
         lblImagePreview->setPixmap(QPixmap());
         lblImagePreview->setText("📷\nAucune image");
-        lblImagePreview->setStyleSheet(
-            "border: 2px dashed #334155; "
-            "border-radius: 8px; "
-            "background: #1e293b; "
-            "color: #94a3b8;"
-        );
+        setHasImage(false);
     }
 }
 
+void ProductDialog::setHasImage(bool hasImage)
+{
+    // Bordure de l'aperçu choisie par la feuille globale selon "hasImage"
+    if (lblImagePreview->property("hasImage").toBool() == hasImage) {
+        return;
+    }
+    lblImagePreview->setProperty("hasImage", hasImage);
+    lblImagePreview->style()->unpolish(lblImagePreview);
+    lblImagePreview->style()->polish(lblImagePreview);
+}
+
 bool ProductDialog::validateInput()
 {
     if (txtNom->text().trimmed().isEmpty()) {
@@ -319,34 +321,24 @@ void ProductDialog::onSave()
         return;
     }
 
-    QSqlQuery query;
-
-    if (currentProductId == -1) {
-        // Insertion
-        query.prepare("INSERT INTO PRODUITS (nom_produit, description, photo_produit, prix_vente, prix_achat, stock, seuil_alerte) "
-                     "VALUES (:nom, :description, :photo, :prix_vente, :prix_achat, :stock, :seuil)");
-        query.bindValue(":nom", txtNom->text().trimmed());
-        query.bindValue(":description", txtDescription->toPlainText().trimmed());
-        query.bindValue(":photo", selectedImagePath);
-        query.bindValue(":prix_vente", txtPrixVente->text().toDouble());
-        query.bindValue(":prix_achat", txtPrixAchat->text().trimmed().isEmpty() ? QVariant() : txtPrixAchat->text().toDouble());
-        query.bindValue(":stock", txtStock->text().toInt());
-        query.bindValue(":seuil", txtSeuilAlerte->text().trimmed().isEmpty() ? 5 : txtSeuilAlerte->text().toInt());
-    } else {
-        // Mise à jour
-        query.prepare("UPDATE PRODUITS SET nom_produit = :nom, description = :description, photo_produit = :photo, "
-                     "prix_vente = :prix_vente, prix_achat = :prix_achat, stock = :stock, seuil_alerte = :seuil WHERE id_produit = :id");
-        query.bindValue(":id", currentProductId);
-        query.bindValue(":nom", txtNom->text().trimmed());
-        query.bindValue(":description", txtDescription->toPlainText().trimmed());
-        query.bindValue(":photo", selectedImagePath);
-        query.bindValue(":prix_vente", txtPrixVente->text().toDouble());
-        query.bindValue(":prix_achat", txtPrixAchat->text().trimmed().isEmpty() ? QVariant() : txtPrixAchat->text().toDouble());
-        query.bindValue(":stock", txtStock->text().toInt());
-        query.bindValue(":seuil", txtSeuilAlerte->text().trimmed().isEmpty() ? 5 : txtSeuilAlerte->text().toInt());
-    }
-
-    if (query.exec()) {
+    Product product;
+    product.id = currentProductId;
+    product.nom = txtNom->text().trimmed();
+    product.description = txtDescription->toPlainText().trimmed();
+    product.photo = selectedImagePath;
+    product.prixVente = txtPrixVente->text().toDouble();
+    product.hasPrixAchat = !txtPrixAchat->text().trimmed().isEmpty();
+    product.prixAchat = txtPrixAchat->text().toDouble();
+    product.stock = txtStock->text().toInt();
+    product.seuilAlerte = txtSeuilAlerte->text().trimmed().isEmpty() ? 5 : txtSeuilAlerte->text().toInt();
+
+    bool saved = currentProductId == -1
+        ? ProductRepository::insert(product) >= 0
+        : ProductRepository::update(product);
+
+    if (saved) {
+        // La photo choisie a pu être retouchée depuis son dernier affichage
+        ThumbnailCache::instance().invalidate(product.photo);
         QMessageBox::information(this,
             "Succès",
             currentProductId == -1 ? "Produit ajouté avec succès!" : "Produit modifié avec succès!"
@@ -354,7 +346,7 @@ void ProductDialog::onSave()
         accept();
     } else {
         QMessageBox::critical(this, "Erreur",
-            "Erreur lors de l'enregistrement: " + query.lastError().text()
+            "Erreur lors de l'enregistrement: " + ProductRepository::lastError()
         );
     }
 }
@@ -14,6 +14,8 @@ class ProductDialog : public QDialog
 public:
     explicit ProductDialog(QWidget *parent = nullptr, int productId = -1);
 
+    static QString styleRules();
+
 private slots:
     void onSave();
     void onCancel();
@@ -24,6 +26,7 @@ private:
     void loadProduct(int productId);
     bool validateInput();
     void updateImagePreview();
+    void setHasImage(bool hasImage);
 
     int currentProductId;
     QLineEdit *txtNom;
@@ -0,0 +1,283 @@
+#include "productlistmodel.h"
+#include "searchindex.h"
+#include <QSqlRecord>
+#include <QDebug>
+
+ProductListModel::ProductListModel(QObject *parent)
+    : QAbstractListModel(parent), m_count(0), m_countGeneration(0), m_dataGeneration(0)
+{
+    m_blocks.setMaxCost(MaxCachedBlocks);
+}
+
+int ProductListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant ProductListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count) {
+        return QVariant();
+    }
+
+    const ProductRow *product = rowAt(index.row());
+    if (!product) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole:
+        return product->nom;
+    case Qt::ToolTipRole:
+    case DescriptionRole:
+        return product->description;
+    case ProductIdRole:
+        return product->id;
+    case ImagePathRole:
+        return product->imagePath;
+    case PriceRole:
+        return product->prixVente;
+    case StockRole:
+        return product->stock;
+    case AlertThresholdRole:
+        return product->seuilAlerte;
+    case BasketQuantityRole:
+        return m_basket.value(product->id, 0);
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ProductListModel::roleNames() const
+{
+    return {
+        {ProductIdRole, "productId"},
+        {NameRole, "nom"},
+        {DescriptionRole, "description"},
+        {ImagePathRole, "imagePath"},
+        {PriceRole, "prixVente"},
+        {StockRole, "stock"},
+        {AlertThresholdRole, "seuilAlerte"},
+        {BasketQuantityRole, "basketQuantity"}
+    };
+}
+
+void ProductListModel::setSearchText(const QString &text)
+{
+    m_searchText = text.trimmed();
+    m_matchExpression = SearchIndex::isAvailable() ? SearchIndex::matchExpression(m_searchText) : QString();
+}
+
+void ProductListModel::reload()
+{
+    // Le comptage part sur le thread base de données ; les cartes actuelles
+    // restent affichées jusqu'à la réponse, qui active le nouveau filtre.
+    int generation = ++m_countGeneration;
+    QString text = m_searchText;
+    QString match = m_matchExpression;
+    QString countSql = QString("SELECT COUNT(*) FROM %1 WHERE %2").arg(fromClause(match), filterClause(text, match));
+    QVariantList values = filterValues(text, match);
+
+    DatabaseService::instance().run<QueryResult>([countSql, values](QSqlDatabase &db) {
+        QueryResult result;
+        QVariant count = DatabaseService::scalar(db, countSql, values);
+        result.ok = count.isValid();
+        result.totalRows = count.toInt();
+        return result;
+    }).then(this, [this, generation, text, match](const QueryResult &result) {
+        if (generation != m_countGeneration) {
+            return; // Une recherche plus récente est en cours
+        }
+        if (!result.ok) {
+            qDebug() << "Erreur lors du comptage des produits";
+        }
+
+        beginResetModel();
+        m_activeSearchText = text;
+        m_activeMatchExpression = match;
+        ++m_dataGeneration;
+        m_blocks.clear();
+        m_pendingBlocks.clear();
+        m_count = result.ok ? result.totalRows : 0;
+        endResetModel();
+    });
+}
+
+int ProductListModel::basketQuantity(int productId) const
+{
+    return m_basket.value(productId, 0);
+}
+
+void ProductListModel::setBasketQuantity(int productId, int quantity)
+{
+    if (quantity <= 0) {
+        m_basket.remove(productId);
+    } else {
+        m_basket[productId] = quantity;
+    }
+    emitRowChanged(productId);
+}
+
+void ProductListModel::clearBasket()
+{
+    if (m_basket.isEmpty()) {
+        return;
+    }
+    m_basket.clear();
+    if (m_count > 0) {
+        emit dataChanged(index(0), index(m_count - 1), {BasketQuantityRole});
+    }
+}
+
+const ProductRow *ProductListModel::rowAt(int row) const
+{
+    int block = row / BlockSize;
+    QVector<ProductRow> *rows = m_blocks.object(block);
+    if (!rows) {
+        requestBlock(block);
+        return nullptr;
+    }
+
+    int offset = row % BlockSize;
+    if (offset >= rows->size()) {
+        return nullptr;
+    }
+    return &rows->at(offset);
+}
+
+QString ProductListModel::blockSql(const QString &searchText, const QString &matchExpression, bool seek)
+{
+    QString sql = QString("SELECT p.id_produit, p.nom_produit, p.description, p.photo_produit, p.prix_vente, p.stock, p.seuil_alerte, p.date_creation "
+                          "FROM %1 WHERE %2").arg(fromClause(matchExpression),
+                                                  filterClause(searchText, matchExpression));
+    if (seek) {
+        sql += " AND (p.date_creation, p.id_produit) < (?, ?)";
+    }
+    sql += !matchExpression.isEmpty() ? " ORDER BY s.score, p.id_produit DESC LIMIT ?"
+                                      : " ORDER BY p.date_creation DESC, p.id_produit DESC LIMIT ?";
+    if (!seek) {
+        sql += " OFFSET ?";
+    }
+    return sql;
+}
+
+void ProductListModel::requestBlock(int block) const
+{
+    if (m_pendingBlocks.contains(block)) {
+        return;
+    }
+    m_pendingBlocks.insert(block);
+
+    // Si le bloc précédent est en cache, on reprend après sa dernière ligne
+    // plutôt que de payer un OFFSET proportionnel à la profondeur. Les résultats
+    // d'une recherche sont triés par pertinence et paginés par OFFSET.
+    bool ranked = isRankedSearch();
+    const QVector<ProductRow> *previous = block > 0 && !ranked ? m_blocks.object(block - 1) : nullptr;
+    bool seek = previous && !previous->isEmpty();
+
+    QString sql = blockSql(m_activeSearchText, m_activeMatchExpression, seek);
+    QVariantList values = filterValues(m_activeSearchText, m_activeMatchExpression);
+    if (seek) {
+        values << previous->last().dateCreation << previous->last().id;
+    }
+    values << BlockSize;
+    if (!seek) {
+        values << block * BlockSize;
+    }
+
+    // data() est const par contrat Qt : la réponse est rangée par le modèle lui-même
+    auto *self = const_cast<ProductListModel *>(this);
+    int generation = m_dataGeneration;
+    DatabaseService::instance().run<QueryResult>([sql, values](QSqlDatabase &db) {
+        return DatabaseService::select(db, sql, values);
+    }).then(self, [self, generation, block](const QueryResult &result) {
+        self->onBlockLoaded(generation, block, result);
+    });
+}
+
+void ProductListModel::onBlockLoaded(int generation, int block, const QueryResult &result)
+{
+    if (generation != m_dataGeneration) {
+        return; // Bloc d'un filtre qui n'est plus affiché
+    }
+    m_pendingBlocks.remove(block);
+
+    // En cas d'erreur on garde un bloc vide pour ne pas relancer la requête à chaque repeinte
+    auto *rows = new QVector<ProductRow>();
+    if (result.ok) {
+        rows->reserve(result.rows.size());
+        for (const QSqlRecord &record : result.rows) {
+            ProductRow product;
+            product.id = record.value(0).toInt();
+            product.nom = record.value(1).toString();
+            product.description = record.value(2).toString();
+            product.imagePath = record.value(3).toString();
+            product.prixVente = record.value(4).toDouble();
+            product.stock = record.value(5).toInt();
+            product.seuilAlerte = record.value(6).toInt();
+            product.dateCreation = record.value(7).toString();
+            rows->append(product);
+        }
+    } else {
+        qDebug() << "Erreur lors du chargement des produits:" << result.error;
+    }
+    m_blocks.insert(block, rows);
+
+    int first = block * BlockSize;
+    int last = qMin(m_count, first + BlockSize) - 1;
+    if (last >= first) {
+        emit dataChanged(index(first), index(last));
+    }
+}
+
+bool ProductListModel::isRankedSearch() const
+{
+    return !m_activeMatchExpression.isEmpty();
+}
+
+QString ProductListModel::fromClause(const QString &matchExpression)
+{
+    if (!matchExpression.isEmpty()) {
+        // rank vaut bm25() : plus le score est bas, plus le produit est pertinent.
+        // bm25() lui-même est refusé dans une sous-requête aplatie par SQLite.
+        return "PRODUITS p JOIN (SELECT rowid AS id, rank AS score "
+               "FROM PRODUITS_FTS WHERE PRODUITS_FTS MATCH ?) s ON s.id = p.id_produit";
+    }
+    return "PRODUITS p";
+}
+
+QString ProductListModel::filterClause(const QString &searchText, const QString &matchExpression)
+{
+    if (searchText.isEmpty() || !matchExpression.isEmpty()) {
+        return "1=1";
+    }
+    return "(p.nom_produit LIKE ? OR p.description LIKE ?)";
+}
+
+QVariantList ProductListModel::filterValues(const QString &searchText, const QString &matchExpression)
+{
+    if (!matchExpression.isEmpty()) {
+        return {matchExpression};
+    }
+    if (searchText.isEmpty()) {
+        return {};
+    }
+    QString pattern = "%" + searchText + "%";
+    return {pattern, pattern};
+}
+
+void ProductListModel::emitRowChanged(int productId)
+{
+    const QList<int> blocks = m_blocks.keys();
+    for (int block : blocks) {
+        const QVector<ProductRow> *rows = m_blocks.object(block);
+        for (int i = 0; rows && i < rows->size(); ++i) {
+            if (rows->at(i).id == productId) {
+                QModelIndex idx = index(block * BlockSize + i);
+                emit dataChanged(idx, idx, {BasketQuantityRole});
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef PRODUCTLISTMODEL_H
+#define PRODUCTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QHash>
+#include <QVector>
+#include <QSet>
+#include <QVariant>
+#include "databaseservice.h"
+
+struct ProductRow {
+    int id = 0;
+    QString nom;
+    QString description;
+    QString imagePath;
+    double prixVente = 0.0;
+    int stock = 0;
+    int seuilAlerte = 0;
+    QString dateCreation;
+};
+
+// Modèle du catalogue : seules les lignes visibles sont chargées, par blocs,
+// et un nombre borné de blocs est gardé en mémoire quel que soit le catalogue.
+// Comptage et blocs sont lus sur le thread base de données ; une carte dont le
+// bloc n'est pas encore arrivé n'a pas de données (la vue peint une carte vide).
+class ProductListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        ProductIdRole = Qt::UserRole + 1,
+        NameRole,
+        DescriptionRole,
+        ImagePathRole,
+        PriceRole,
+        StockRole,
+        AlertThresholdRole,
+        BasketQuantityRole
+    };
+
+    explicit ProductListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void setSearchText(const QString &text);
+    QString searchText() const { return m_searchText; }
+    void reload();
+
+    // Quantités du panier vendeur, affichées sur les cartes
+    int basketQuantity(int productId) const;
+    void setBasketQuantity(int productId, int quantity);
+    void clearBasket();
+
+    // Requête d'un bloc, vérifiée par QueryPlanCheck. seek : reprise après
+    // la dernière ligne du bloc précédent, sinon LIMIT/OFFSET.
+    static QString blockSql(const QString &searchText, const QString &matchExpression, bool seek);
+
+private:
+    const ProductRow *rowAt(int row) const;
+    void requestBlock(int block) const;
+    void onBlockLoaded(int generation, int block, const QueryResult &result);
+    bool isRankedSearch() const;
+    static QString fromClause(const QString &matchExpression);
+    static QString filterClause(const QString &searchText, const QString &matchExpression);
+    static QVariantList filterValues(const QString &searchText, const QString &matchExpression);
+    void emitRowChanged(int productId);
+
+    static const int BlockSize = 64;
+    static const int MaxCachedBlocks = 32;
+
+    mutable QCache<int, QVector<ProductRow>> m_blocks;
+    mutable QSet<int> m_pendingBlocks;
+    int m_count;
+    int m_countGeneration;   // dernier comptage demandé
+    int m_dataGeneration;    // filtre actuellement affiché
+    QString m_searchText;           // filtre demandé
+    QString m_matchExpression;
+    QString m_activeSearchText;     // filtre des blocs affichés
+    QString m_activeMatchExpression;
+    QHash<int, int> m_basket;
+};
+
+#endif // PRODUCTLISTMODEL_H
@@ -0,0 +1,180 @@
+#include "productrepository.h"
+#include "repositoryerror.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+thread_local RepositoryError repositoryError;
+}
+
+ProductRepository::ProductRepository() {}
+
+QString ProductRepository::lastError()
+{
+    return repositoryError.text();
+}
+
+bool ProductRepository::find(int productId, Product &product, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "SELECT nom_produit, description, photo_produit, prix_vente, prix_achat, stock, seuil_alerte "
+        "FROM PRODUITS WHERE id_produit = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, productId);
+
+    if (!repositoryError.exec(*query) || !query->next()) {
+        query->finish();
+        return false;
+    }
+
+    product.id = productId;
+    product.nom = query->value(0).toString();
+    product.description = query->value(1).toString();
+    product.photo = query->value(2).toString();
+    product.prixVente = query->value(3).toDouble();
+    product.hasPrixAchat = !query->value(4).isNull();
+    product.prixAchat = query->value(4).toDouble();
+    product.stock = query->value(5).toInt();
+    product.seuilAlerte = query->value(6).toInt();
+    query->finish();
+    return true;
+}
+
+int ProductRepository::insert(const Product &product, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "INSERT INTO PRODUITS (nom_produit, description, photo_produit, prix_vente, prix_achat, stock, seuil_alerte) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?)");
+    if (!query) {
+        return -1;
+    }
+    query->bindValue(0, product.nom);
+    query->bindValue(1, product.description);
+    query->bindValue(2, product.photo);
+    query->bindValue(3, product.prixVente);
+    query->bindValue(4, product.hasPrixAchat ? QVariant(product.prixAchat) : QVariant());
+    query->bindValue(5, product.stock);
+    query->bindValue(6, product.seuilAlerte);
+
+    if (!repositoryError.exec(*query)) {
+        return -1;
+    }
+    return query->lastInsertId().toInt();
+}
+
+bool ProductRepository::update(const Product &product, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db,
+        "UPDATE PRODUITS SET nom_produit = ?, description = ?, photo_produit = ?, "
+        "prix_vente = ?, prix_achat = ?, stock = ?, seuil_alerte = ? WHERE id_produit = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, product.nom);
+    query->bindValue(1, product.description);
+    query->bindValue(2, product.photo);
+    query->bindValue(3, product.prixVente);
+    query->bindValue(4, product.hasPrixAchat ? QVariant(product.prixAchat) : QVariant());
+    query->bindValue(5, product.stock);
+    query->bindValue(6, product.seuilAlerte);
+    query->bindValue(7, product.id);
+    return repositoryError.exec(*query);
+}
+
+bool ProductRepository::remove(int productId, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, "DELETE FROM PRODUITS WHERE id_produit = ?");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, productId);
+    return repositoryError.exec(*query);
+}
+
+QHash<int, int> ProductRepository::stockShortages(const QMap<int, int> &basket, bool *ok, const QSqlDatabase &db)
+{
+    // json_each déroule {"id_produit": quantité, ...} : seules les lignes en défaut reviennent
+    QHash<int, int> shortages;
+    QJsonObject json;
+    for (auto it = basket.constBegin(); it != basket.constEnd(); ++it) {
+        json.insert(QString::number(it.key()), it.value());
+    }
+
+    QSqlQuery *query = repositoryError.prepare(db,
+        "SELECT CAST(b.key AS INTEGER), COALESCE(p.stock, 0) "
+        "FROM json_each(?) b "
+        "LEFT JOIN PRODUITS p ON p.id_produit = CAST(b.key AS INTEGER) "
+        "WHERE p.id_produit IS NULL OR b.value > p.stock");
+    if (!query) {
+        if (ok) {
+            *ok = false;
+        }
+        return shortages;
+    }
+    query->bindValue(0, QString::fromUtf8(QJsonDocument(json).toJson(QJsonDocument::Compact)));
+
+    bool success = repositoryError.exec(*query);
+    while (success && query->next()) {
+        shortages.insert(query->value(0).toInt(), query->value(1).toInt());
+    }
+    query->finish();
+
+    if (ok) {
+        *ok = success;
+    }
+    return shortages;
+}
+
+bool ProductRepository::decrementStockForOrder(int commandeId, int productCount, bool *stockConflict,
+                                               const QSqlDatabase &db)
+{
+    // Un produit dont le stock ne suffit plus n'est pas mis à jour : on le
+    // détecte au nombre de lignes modifiées, l'appelant annule la transaction.
+    static const QString orderedQuantity = "(SELECT SUM(d.quantite) FROM DETAILS_COMMANDE d "
+                                           "WHERE d.id_commande = ? AND d.id_produit = PRODUITS.id_produit)";
+    if (stockConflict) {
+        *stockConflict = false;
+    }
+    QSqlQuery *query = repositoryError.prepare(db,
+        QString("UPDATE PRODUITS SET stock = stock - %1 "
+                "WHERE id_produit IN (SELECT id_produit FROM DETAILS_COMMANDE WHERE id_commande = ?) "
+                "AND stock >= %1").arg(orderedQuantity));
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, commandeId);
+    query->bindValue(1, commandeId);
+    query->bindValue(2, commandeId);
+
+    if (!repositoryError.exec(*query)) {
+        return false;
+    }
+    if (query->numRowsAffected() != productCount) {
+        repositoryError.set("Stock insuffisant");
+        if (stockConflict) {
+            *stockConflict = true;
+        }
+        return false;
+    }
+    return true;
+}
+
+QString ProductRepository::restockSql()
+{
+    return "UPDATE PRODUITS SET stock = stock + (SELECT SUM(d.quantite) FROM DETAILS_COMMANDE d "
+           "WHERE d.id_commande = ? AND d.id_produit = PRODUITS.id_produit) "
+           "WHERE id_produit IN (SELECT id_produit FROM DETAILS_COMMANDE WHERE id_commande = ?)";
+}
+
+bool ProductRepository::restockForOrder(int commandeId, const QSqlDatabase &db)
+{
+    QSqlQuery *query = repositoryError.prepare(db, restockSql());
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, commandeId);
+    query->bindValue(1, commandeId);
+    return repositoryError.exec(*query);
+}
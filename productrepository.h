@@ -0,0 +1,50 @@
+#ifndef PRODUCTREPOSITORY_H
+#define PRODUCTREPOSITORY_H
+
+#include <QHash>
+#include <QMap>
+#include <QSqlDatabase>
+#include <QString>
+
+struct Product {
+    int id = -1;
+    QString nom;
+    QString description;
+    QString photo;
+    double prixVente = 0.0;
+    double prixAchat = 0.0;
+    bool hasPrixAchat = false;   // prix_achat est facultatif
+    int stock = 0;
+    int seuilAlerte = 5;
+};
+
+// Accès à PRODUITS par requêtes préparées une fois par connexion (StatementCache)
+class ProductRepository
+{
+public:
+    ProductRepository();
+
+    static bool find(int productId, Product &product, const QSqlDatabase &db = QSqlDatabase::database());
+    static int insert(const Product &product, const QSqlDatabase &db = QSqlDatabase::database());
+    static bool update(const Product &product, const QSqlDatabase &db = QSqlDatabase::database());
+    static bool remove(int productId, const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Lignes du panier (id_produit -> quantité) dont le stock ne suffit pas,
+    // avec le stock disponible, en une seule requête
+    static QHash<int, int> stockShortages(const QMap<int, int> &basket, bool *ok,
+                                          const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Décrémente le stock de toutes les lignes d'une commande ; échoue si un
+    // produit n'a plus assez de stock (aucune ligne n'est alors modifiée)
+    static bool decrementStockForOrder(int commandeId, int productCount, bool *stockConflict,
+                                       const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Remet en stock les quantités d'une commande annulée
+    static bool restockForOrder(int commandeId, const QSqlDatabase &db = QSqlDatabase::database());
+    // Requête de restockForOrder(), vérifiée par QueryPlanCheck
+    static QString restockSql();
+
+    static QString lastError();
+};
+
+#endif // PRODUCTREPOSITORY_H
@@ -4,11 +4,14 @@
 #include <QFrame>
 #include <QLineEdit>
 #include <QPushButton>
-#include <QScrollArea>
+#include <QListView>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QGridLayout>
 #include "orderdialog.h"
+#include "searchcontroller.h"
+
+class ProductListModel;
+class ProductCardDelegate;
 
 class ProductsPage : public QFrame
 {
@@ -16,6 +19,9 @@ class ProductsPage : public QFrame
 
 public:
     explicit ProductsPage(const QString &userRole, int userId, QWidget *parent = nullptr);
+
+    static QString styleRules();
+
     void loadProducts();
 
 private slots:
@@ -24,24 +30,23 @@ private slots:
     void onDeleteProduct(int productId);
     void onOrderProduct();
     void onSearchTextChanged(const QString &text);
+    void onDecrementQuantity(const QModelIndex &index);
+    void onIncrementQuantity(const QModelIndex &index);
 
 signals:
     void orderValidated();
 
 private:
     void setupUI();
-    void setupDatabase();
-    void applyStyles();
-    QWidget* createProductCard(int productId, const QString &nom, const QString &description,
-                              const QString &imagePath, double prixVente, int stock, int seuilAlerte);
 
     QLineEdit *searchInput;
+    SearchController *searchController;
     QPushButton *btnAdd;
     QPushButton *btnOrder;
     QPushButton *btnRefresh;
-    QScrollArea *scrollArea;
-    QWidget *productsContainer;
-    QGridLayout *productsGrid;
+    QListView *productsView;
+    ProductListModel *productsModel;
+    ProductCardDelegate *cardDelegate;
     
     QString userRole;
     int userId;
@@ -0,0 +1,29 @@
+#include "profiledapplication.h"
+#include "uiprofiler.h"
+#include <QThread>
+#include <QWidget>
+
+ProfiledApplication::ProfiledApplication(int &argc, char **argv)
+    : QApplication(argc, argv)
+{
+}
+
+bool ProfiledApplication::notify(QObject *receiver, QEvent *event)
+{
+    UiProfiler &profiler = UiProfiler::instance();
+    if (!profiler.isRunning() || QThread::currentThread() != thread()) {
+        return QApplication::notify(receiver, event);
+    }
+
+    // Relevé avant l'envoi : le destinataire peut être détruit par son
+    // événement (DeferredDelete)
+    const char *className = receiver->metaObject()->className();
+    const bool isWindow = receiver->isWidgetType() && static_cast<QWidget *>(receiver)->isWindow();
+    const int type = event->type();
+    const qint64 beats = profiler.heartbeats();
+    const qint64 startUs = profiler.nowUs();
+
+    bool handled = QApplication::notify(receiver, event);
+    profiler.recordEvent(className, isWindow, type, startUs, beats);
+    return handled;
+}
@@ -0,0 +1,18 @@
+#ifndef PROFILEDAPPLICATION_H
+#define PROFILEDAPPLICATION_H
+
+#include <QApplication>
+
+// QApplication qui chronomètre les événements du thread GUI quand
+// UiProfiler est démarré ; sinon un simple test en plus par événement.
+class ProfiledApplication : public QApplication
+{
+    Q_OBJECT
+
+public:
+    ProfiledApplication(int &argc, char **argv);
+
+    bool notify(QObject *receiver, QEvent *event) override;
+};
+
+#endif // PROFILEDAPPLICATION_H
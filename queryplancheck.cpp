@@ -0,0 +1,138 @@
+#include "queryplancheck.h"
+#include "cashrepository.h"
+#include "clientspage.h"
+#include "keysetpager.h"
+#include "logindialog.h"
+#include "metricsengine.h"
+#include "orderrepository.h"
+#include "orderspage.h"
+#include "paymentrepository.h"
+#include "paymenttablemodel.h"
+#include "productlistmodel.h"
+#include "productrepository.h"
+#include "userspage.h"
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QRegularExpression>
+#include <QVector>
+#include <QDebug>
+
+namespace {
+struct HotQuery {
+    QString name;
+    QString sql;
+};
+
+// Pager placé sur la deuxième page, bornes de la première connues : la
+// requête suit "(date, id) < (?, ?)" comme en navigation normale
+KeysetPager secondPage(KeysetPager pager)
+{
+    pager.beginPage(0, false, 1);
+    pager.collect(QVariant(), 0);
+    pager.endPage();
+    return pager;
+}
+
+// Requêtes construites par les pages, les modèles et les dépôts eux-mêmes,
+// filtres et condition de page compris
+QVector<HotQuery> hotQueries()
+{
+    const int pageSize = 20;
+    QVariantList values;
+    const QString allUsers = UsersPage::listFilter(QString(), QString(), values);
+    const QString usersByRole = UsersPage::listFilter(QString(), "ADMIN", values);
+    const QString ordersByStatus = OrdersPage::listFilter(QString(), "PAYEE", values);
+    const QString orderSource = OrdersPage::listSource(QString());
+
+    return {
+        {"connexion", LoginDialog::credentialsSql()},
+        {"utilisateurs", UsersPage::listSql(allUsers, secondPage(UsersPage::listPager(pageSize)), 1)},
+        {"utilisateurs par rôle", UsersPage::listSql(usersByRole, secondPage(UsersPage::listPager(pageSize)), 1)},
+        {"total des utilisateurs par rôle", UsersPage::countSql(usersByRole)},
+        {"clients", ClientsPage::listSql(ClientsPage::listSource(QString()), "1=1",
+                                         secondPage(ClientsPage::listPager(pageSize)), 1)},
+        {"produits", ProductListModel::blockSql(QString(), QString(), true)},
+        {"commandes par statut", OrdersPage::listSql(orderSource, ordersByStatus,
+                                                     secondPage(OrdersPage::listPager(pageSize)), 1)},
+        {"total des commandes par statut", OrdersPage::countSql(orderSource, ordersByStatus)},
+        {"paiements par statut", PaymentTableModel::batchSql("VALIDE", QString(), true, values)},
+        {"en-tête d'une commande", OrderRepository::findSql()},
+        {"lignes d'une commande", OrderRepository::itemsSql()},
+        {"remise en stock d'une commande", ProductRepository::restockSql()},
+        {"annulation des paiements", PaymentRepository::cancelForOrderSql()},
+        {"produits en alerte", MetricsEngine::lowStockSql()},
+        {"ventes du tableau de bord", MetricsEngine::dailySalesSql()},
+        {"session de caisse ouverte", CashRepository::currentSessionSql()},
+        {"journal de caisse", CashRepository::movementsSql()}
+    };
+}
+
+// "SCAN t" sans index, ou tri hors index. "SCAN t USING ... INDEX" parcourt
+// l'index dans l'ordre demandé et s'arrête à LIMIT.
+bool isFullScan(const QString &detail)
+{
+    if (detail.startsWith("USE TEMP B-TREE")) {
+        return true;
+    }
+    return detail.startsWith("SCAN ") && !detail.contains(" USING ");
+}
+}
+
+QueryPlanCheck::QueryPlanCheck() {}
+
+bool QueryPlanCheck::run(QSqlDatabase db, QStringList *failures)
+{
+    bool ok = true;
+    QSqlQuery query(db);
+    for (const HotQuery &hot : hotQueries()) {
+        const QString &name = hot.name;
+        QString error;
+        const QStringList plan = explain(query, hot.sql, &error);
+        if (!error.isEmpty()) {
+            ok = false;
+            QString failure = QString("%1 : %2").arg(name, error);
+            qDebug() << "Plan de requête illisible," << failure;
+            if (failures) {
+                *failures << failure;
+            }
+            continue;
+        }
+
+        for (const QString &detail : plan) {
+            if (isFullScan(detail)) {
+                ok = false;
+                QString failure = QString("%1 : %2").arg(name, detail);
+                qDebug() << "Requête sans index," << failure;
+                if (failures) {
+                    *failures << failure;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+QStringList QueryPlanCheck::explain(QSqlQuery &query, const QString &sql, QString *error)
+{
+    // Paramètres positionnels (?) ou nommés (:id)
+    static const QRegularExpression placeholders("\\?|(?<=[\\s(=,]):[A-Za-z_]\\w*");
+
+    QStringList plan;
+    query.prepare("EXPLAIN QUERY PLAN " + sql);
+    for (int i = sql.count(placeholders); i > 0; --i) {
+        query.addBindValue(QVariant());
+    }
+    if (!query.exec()) {
+        if (error) {
+            *error = query.lastError().text();
+        }
+        return plan;
+    }
+
+    // Colonnes : id, parent, notused, detail
+    while (query.next()) {
+        plan << query.value(3).toString();
+    }
+    query.finish();
+    return plan;
+}
@@ -0,0 +1,30 @@
+#ifndef QUERYPLANCHECK_H
+#define QUERYPLANCHECK_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+
+// Vérifie par EXPLAIN QUERY PLAN que les requêtes fréquentes (connexion,
+// pages de listes, lignes d'une commande, caisse) passent par un index :
+// ni parcours complet d'une table, ni tri en B-tree temporaire.
+// Les recherches par LIKE '%...%' parcourent la table par nature et ne sont
+// pas vérifiées ; l'index plein texte les remplace quand il est disponible.
+//
+// gestionVenteMateriel --check-query-plans lance la vérification et quitte.
+class QueryPlanCheck
+{
+public:
+    QueryPlanCheck();
+
+    // true si toutes les requêtes utilisent un index ; failures reçoit une
+    // ligne par requête fautive (nom et étape du plan)
+    static bool run(QSqlDatabase db = QSqlDatabase::database(), QStringList *failures = nullptr);
+
+    // Étapes du plan de sql, exécuté par query (connexion de query) ; les
+    // paramètres sont liés à NULL, le plan ne dépend pas de leurs valeurs
+    static QStringList explain(QSqlQuery &query, const QString &sql, QString *error = nullptr);
+};
+
+#endif // QUERYPLANCHECK_H
@@ -0,0 +1,287 @@
+#include "queryprofiler.h"
+#include "databaseservice.h"
+#include "queryplancheck.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QLocale>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+
+namespace {
+// Bornes supérieures des intervalles de l'histogramme, en microsecondes
+const qint64 BucketBoundsUs[QueryStats::BucketCount - 1] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000
+};
+
+const qint64 MaxLogBytes = 1024 * 1024;
+const int LogBackups = 3;
+const int MaxFingerprintCache = 2000;
+
+QMutex statsMutex;
+QHash<QString, QueryStats> allStats;
+QHash<QString, QString> fingerprints;   // SQL brut -> empreinte
+
+QMutex logMutex;
+QString slowLogPath;
+std::atomic<qint64> slowThresholdNs {0};
+
+// Appelée sous statsMutex. Les requêtes préparées gardent le même texte :
+// l'empreinte n'est calculée qu'une fois par SQL distinct.
+QString fingerprintOf(const QString &sql)
+{
+    auto it = fingerprints.constFind(sql);
+    if (it != fingerprints.constEnd()) {
+        return it.value();
+    }
+
+    static const QRegularExpression strings("'(?:[^']|'')*'");
+    static const QRegularExpression numbers("\\b\\d+(?:\\.\\d+)?\\b");
+    QString fingerprint = sql.simplified();
+    fingerprint.replace(strings, "?");
+    fingerprint.replace(numbers, "?");
+
+    if (fingerprints.size() >= MaxFingerprintCache) {
+        fingerprints.clear();
+    }
+    fingerprints.insert(sql, fingerprint);
+    return fingerprint;
+}
+
+int bucketOf(qint64 elapsedNs)
+{
+    const qint64 elapsedUs = elapsedNs / 1000;
+    int bucket = 0;
+    while (bucket < QueryStats::BucketCount - 1 && elapsedUs >= BucketBoundsUs[bucket]) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+QString milliseconds(qint64 ns)
+{
+    return QString::number(ns / 1000000.0, 'f', 2);
+}
+
+// Le fichier plein devient .1, l'ancien .1 devient .2, etc.
+void rotateSlowLog()
+{
+    if (QFileInfo(slowLogPath).size() < MaxLogBytes) {
+        return;
+    }
+    QFile::remove(QString("%1.%2").arg(slowLogPath).arg(LogBackups));
+    for (int i = LogBackups - 1; i >= 1; --i) {
+        QFile::rename(QString("%1.%2").arg(slowLogPath).arg(i), QString("%1.%2").arg(slowLogPath).arg(i + 1));
+    }
+    QFile::rename(slowLogPath, slowLogPath + ".1");
+}
+
+void appendSlowLog(const QString &sql, qint64 elapsedNs, qint64 rows, const QStringList &plan, const QString &error)
+{
+    QMutexLocker locker(&logMutex);
+    if (slowLogPath.isEmpty()) {
+        return;
+    }
+    rotateSlowLog();
+
+    QFile file(slowLogPath);
+    if (!file.open(QIODevice::Append | QIODevice::Text)) {
+        qDebug() << "Journal des requêtes lentes inaccessible:" << file.errorString();
+        return;
+    }
+    QTextStream out(&file);
+    out << QDateTime::currentDateTime().toString(Qt::ISODateWithMs) << "  " << milliseconds(elapsedNs) << " ms";
+    if (rows > 0) {
+        out << "  " << rows << " lignes";
+    }
+    out << "\n    " << sql.simplified() << "\n";
+    for (const QString &step : plan) {
+        out << "    | " << step << "\n";
+    }
+    if (!error.isEmpty()) {
+        out << "    ! " << error << "\n";
+    }
+}
+
+// Plan et journal d'une exécution lente, sur le thread base de données : la
+// requête lente, souvent lancée du thread GUI, ne paie ni l'EXPLAIN ni
+// l'écriture du fichier. Le plan est relu sur la connexion du worker (même
+// base, même schéma).
+void queueSlowLog(const QString &sql, const QString &fingerprint, qint64 elapsedNs, qint64 rows,
+                  const QString &error)
+{
+    DatabaseService::instance().run<bool>([sql, fingerprint, elapsedNs, rows, error](QSqlDatabase &db) {
+        QStringList plan;
+        if (error.isEmpty()) {
+            QSqlQuery explain(db);
+            plan = QueryPlanCheck::explain(explain, sql);
+        }
+        if (!plan.isEmpty()) {
+            QMutexLocker locker(&statsMutex);
+            auto it = allStats.find(fingerprint);
+            if (it != allStats.end()) {
+                it->plan = plan;
+            }
+        }
+        appendSlowLog(sql, elapsedNs, rows, plan, error);
+        return true;
+    });
+}
+
+void record(QSqlQuery &query, qint64 elapsedNs, bool ok)
+{
+    const QString sql = query.lastQuery();
+    const bool select = ok && query.isSelect();
+    const qint64 rows = ok && !select ? qMax(0, query.numRowsAffected()) : 0;
+    const qint64 threshold = slowThresholdNs.load();
+    const bool slow = threshold > 0 && elapsedNs >= threshold;
+
+    QString fingerprint;
+    {
+        QMutexLocker locker(&statsMutex);
+        fingerprint = fingerprintOf(sql);
+        QueryStats &stats = allStats[fingerprint];
+        stats.fingerprint = fingerprint;
+        ++stats.calls;
+        stats.errors += ok ? 0 : 1;
+        stats.totalNs += elapsedNs;
+        stats.maxNs = qMax(stats.maxNs, elapsedNs);
+        stats.rows += rows;
+        // Lignes d'un SELECT inconnues tant que addRows() ne les a pas reçues
+        stats.uncountedCalls += select ? 1 : 0;
+        ++stats.histogram[bucketOf(elapsedNs)];
+        stats.slowCalls += slow ? 1 : 0;
+    }
+
+    if (slow) {
+        queueSlowLog(sql, fingerprint, elapsedNs, rows, ok ? QString() : query.lastError().text());
+    }
+}
+}
+
+QueryProfiler::QueryProfiler() {}
+
+void QueryProfiler::configure(int slowQueryMs, const QString &logPath)
+{
+    slowThresholdNs = qMax(0, slowQueryMs) * qint64(1000000);
+    QMutexLocker locker(&logMutex);
+    slowLogPath = logPath;
+}
+
+bool QueryProfiler::exec(QSqlQuery &query)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = query.exec();
+    record(query, timer.nsecsElapsed(), ok);
+    return ok;
+}
+
+bool QueryProfiler::exec(QSqlQuery &query, const QString &sql)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = query.exec(sql);
+    record(query, timer.nsecsElapsed(), ok);
+    return ok;
+}
+
+bool QueryProfiler::execBatch(QSqlQuery &query)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = query.execBatch();
+    record(query, timer.nsecsElapsed(), ok);
+    return ok;
+}
+
+void QueryProfiler::addRows(const QSqlQuery &query, int rows)
+{
+    QMutexLocker locker(&statsMutex);
+    auto it = allStats.find(fingerprintOf(query.lastQuery()));
+    if (it == allStats.end()) {
+        return;
+    }
+    it->rows += rows;
+    if (it->uncountedCalls > 0) {
+        --it->uncountedCalls;
+    }
+}
+
+QVector<QueryStats> QueryProfiler::top(int count)
+{
+    QVector<QueryStats> stats;
+    {
+        QMutexLocker locker(&statsMutex);
+        stats.reserve(allStats.size());
+        for (const QueryStats &entry : std::as_const(allStats)) {
+            stats.append(entry);
+        }
+    }
+    std::sort(stats.begin(), stats.end(), [](const QueryStats &a, const QueryStats &b) {
+        return a.totalNs > b.totalNs;
+    });
+    if (count >= 0 && stats.size() > count) {
+        stats.resize(count);
+    }
+    return stats;
+}
+
+QString QueryProfiler::report(int count)
+{
+    QString text;
+    QTextStream out(&text);
+    const QVector<QueryStats> stats = top(count);
+    for (const QueryStats &entry : stats) {
+        out << milliseconds(entry.totalNs) << " ms  " << entry.calls << " appels  moy. "
+            << milliseconds(entry.totalNs / qMax<qint64>(1, entry.calls)) << " ms  max "
+            << milliseconds(entry.maxNs) << " ms  lignes : " << rowsLabel(entry);
+        if (entry.slowCalls > 0) {
+            out << "  " << entry.slowCalls << " lentes";
+        }
+        if (entry.errors > 0) {
+            out << "  " << entry.errors << " erreurs";
+        }
+        out << "\n    " << entry.fingerprint << "\n";
+        for (const QString &step : entry.plan) {
+            out << "    | " << step << "\n";
+        }
+    }
+    return text;
+}
+
+void QueryProfiler::reset()
+{
+    QMutexLocker locker(&statsMutex);
+    allStats.clear();
+}
+
+QString QueryProfiler::bucketLabel(int bucket)
+{
+    if (bucket < 0 || bucket >= QueryStats::BucketCount) {
+        return QString();
+    }
+    if (bucket == QueryStats::BucketCount - 1) {
+        return QString("≥ %1 ms").arg(QLocale().toString(BucketBoundsUs[bucket - 1] / 1000.0));
+    }
+    return QString("< %1 ms").arg(QLocale().toString(BucketBoundsUs[bucket] / 1000.0));
+}
+
+QString QueryProfiler::rowsLabel(const QueryStats &stats)
+{
+    if (stats.uncountedCalls <= 0) {
+        return QString::number(stats.rows);
+    }
+    if (stats.uncountedCalls >= stats.calls) {
+        return "non comptées";
+    }
+    return QString("%1 (%2 appels non comptés)").arg(stats.rows).arg(stats.uncountedCalls);
+}
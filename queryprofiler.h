@@ -0,0 +1,62 @@
+#ifndef QUERYPROFILER_H
+#define QUERYPROFILER_H
+
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <array>
+
+// Statistiques d'une requête, regroupées par empreinte : le SQL aux espaces
+// près, littéraux remplacés par ?
+struct QueryStats
+{
+    static constexpr int BucketCount = 12;
+
+    QString fingerprint;
+    qint64 calls = 0;
+    qint64 errors = 0;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+    qint64 rows = 0;             // lignes lues (SELECT) ou modifiées
+    qint64 uncountedCalls = 0;   // SELECT dont les lignes lues n'ont pas été comptées
+    qint64 slowCalls = 0;
+    std::array<qint64, BucketCount> histogram {};
+    QStringList plan;            // EXPLAIN QUERY PLAN de la dernière exécution lente
+};
+
+// Mesure de toutes les exécutions SQL de l'application, GUI et thread base
+// de données confondus : QueryProfiler::exec(query) remplace query.exec().
+// Une exécution plus longue que le seuil est écrite, avec son plan, dans le
+// journal des requêtes lentes (fichier tournant) ; plan et écriture sont faits
+// plus tard sur le thread base de données, pas sur le thread appelant.
+class QueryProfiler
+{
+public:
+    QueryProfiler();
+
+    // Seuil en millisecondes (0 : pas de journal) et fichier du journal
+    static void configure(int slowQueryMs, const QString &logPath);
+
+    static bool exec(QSqlQuery &query);
+    static bool exec(QSqlQuery &query, const QString &sql);
+    static bool execBatch(QSqlQuery &query);
+
+    // Lignes lues après exec() d'un SELECT, comptées avec sa requête. Sans
+    // cet appel (lectures hors DatabaseService::select), l'exécution reste
+    // dans uncountedCalls.
+    static void addRows(const QSqlQuery &query, int rows);
+
+    // Requêtes triées par temps total décroissant
+    static QVector<QueryStats> top(int count);
+    static QString report(int count);
+    static void reset();
+
+    // "< 1 ms", "< 2,5 ms"... ; le dernier intervalle est ouvert
+    static QString bucketLabel(int bucket);
+
+    // "12", "non comptées" ou "12 (3 appels non comptés)"
+    static QString rowsLabel(const QueryStats &stats);
+};
+
+#endif // QUERYPROFILER_H
@@ -0,0 +1,119 @@
+#include "querystatsdialog.h"
+#include "queryprofiler.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+namespace {
+QTableWidgetItem *numberItem(const QString &text)
+{
+    auto *item = new QTableWidgetItem(text);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+QString ms(qint64 ns)
+{
+    return QString::number(ns / 1000000.0, 'f', 2);
+}
+}
+
+QueryStatsDialog::QueryStatsDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Diagnostic des requêtes");
+    resize(1000, 560);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(12);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    summary = new QLabel(this);
+    mainLayout->addWidget(summary);
+
+    table = new QTableWidget(0, 7, this);
+    table->setHorizontalHeaderLabels({"Requête", "Appels", "Total (ms)", "Moyenne (ms)",
+                                      "Max (ms)", "Lignes", "Lentes"});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setWordWrap(false);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    for (int column = 1; column < table->columnCount(); ++column) {
+        table->horizontalHeader()->setSectionResizeMode(column, QHeaderView::ResizeToContents);
+    }
+    mainLayout->addWidget(table, 1);
+
+    QHBoxLayout *buttons = new QHBoxLayout();
+    QPushButton *btnRefresh = new QPushButton("Actualiser", this);
+    QPushButton *btnCopy = new QPushButton("Copier le rapport", this);
+    QPushButton *btnReset = new QPushButton("Réinitialiser", this);
+    QPushButton *btnClose = new QPushButton("Fermer", this);
+    buttons->addWidget(btnRefresh);
+    buttons->addWidget(btnCopy);
+    buttons->addWidget(btnReset);
+    buttons->addStretch();
+    buttons->addWidget(btnClose);
+    mainLayout->addLayout(buttons);
+
+    connect(btnRefresh, &QPushButton::clicked, this, &QueryStatsDialog::refresh);
+    connect(btnCopy, &QPushButton::clicked, this, &QueryStatsDialog::onCopy);
+    connect(btnReset, &QPushButton::clicked, this, &QueryStatsDialog::onReset);
+    connect(btnClose, &QPushButton::clicked, this, &QDialog::accept);
+
+    refresh();
+}
+
+void QueryStatsDialog::refresh()
+{
+    const QVector<QueryStats> stats = QueryProfiler::top(TopCount);
+
+    qint64 calls = 0;
+    qint64 totalNs = 0;
+    table->setRowCount(stats.size());
+    for (int row = 0; row < stats.size(); ++row) {
+        const QueryStats &entry = stats.at(row);
+        calls += entry.calls;
+        totalNs += entry.totalNs;
+
+        // Répartition des durées et plan capturé, en infobulle
+        QStringList details;
+        for (int bucket = 0; bucket < QueryStats::BucketCount; ++bucket) {
+            if (entry.histogram[bucket] > 0) {
+                details << QString("%1 : %2").arg(QueryProfiler::bucketLabel(bucket)).arg(entry.histogram[bucket]);
+            }
+        }
+        if (!entry.plan.isEmpty()) {
+            details << QString() << "Plan :" << entry.plan;
+        }
+
+        auto *sqlItem = new QTableWidgetItem(entry.fingerprint);
+        sqlItem->setToolTip(entry.fingerprint + "\n\n" + details.join('\n'));
+        table->setItem(row, 0, sqlItem);
+        table->setItem(row, 1, numberItem(QString::number(entry.calls)));
+        table->setItem(row, 2, numberItem(ms(entry.totalNs)));
+        table->setItem(row, 3, numberItem(ms(entry.totalNs / qMax<qint64>(1, entry.calls))));
+        table->setItem(row, 4, numberItem(ms(entry.maxNs)));
+        table->setItem(row, 5, numberItem(QueryProfiler::rowsLabel(entry)));
+        table->setItem(row, 6, numberItem(QString::number(entry.slowCalls)));
+    }
+
+    summary->setText(QString("%1 requêtes distinctes affichées — %2 exécutions, %3 ms au total")
+                         .arg(stats.size()).arg(calls).arg(ms(totalNs)));
+}
+
+void QueryStatsDialog::onReset()
+{
+    QueryProfiler::reset();
+    refresh();
+}
+
+void QueryStatsDialog::onCopy()
+{
+    QApplication::clipboard()->setText(QueryProfiler::report(TopCount));
+}
@@ -0,0 +1,31 @@
+#ifndef QUERYSTATSDIALOG_H
+#define QUERYSTATSDIALOG_H
+
+#include <QDialog>
+
+class QTableWidget;
+class QLabel;
+
+// Panneau de diagnostic (Ctrl+Maj+D, administrateurs) : requêtes SQL les
+// plus coûteuses depuis le démarrage, d'après QueryProfiler. L'infobulle
+// d'une ligne donne la répartition des durées et le dernier plan lent.
+class QueryStatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit QueryStatsDialog(QWidget *parent = nullptr);
+
+private slots:
+    void refresh();
+    void onReset();
+    void onCopy();
+
+private:
+    static const int TopCount = 50;
+
+    QTableWidget *table;
+    QLabel *summary;
+};
+
+#endif // QUERYSTATSDIALOG_H
@@ -0,0 +1,51 @@
+#include "repositoryerror.h"
+#include "queryprofiler.h"
+#include "statementcache.h"
+#include <QSqlError>
+
+RepositoryError::RepositoryError() {}
+
+QSqlQuery *RepositoryError::prepare(const QSqlDatabase &db, const QString &sql)
+{
+    QString error;
+    QSqlQuery *query = StatementCache::prepared(db, sql, &error);
+    if (!query) {
+        m_text = error;
+    }
+    return query;
+}
+
+bool RepositoryError::exec(QSqlQuery &query)
+{
+    return record(QueryProfiler::exec(query), query);
+}
+
+bool RepositoryError::execBatch(QSqlQuery &query)
+{
+    return record(QueryProfiler::execBatch(query), query);
+}
+
+bool RepositoryError::record(bool ok, const QSqlQuery &query)
+{
+    if (ok) {
+        m_text.clear();
+    } else {
+        m_text = query.lastError().text();
+    }
+    return ok;
+}
+
+void RepositoryError::set(const QString &message)
+{
+    m_text = message;
+}
+
+void RepositoryError::clear()
+{
+    m_text.clear();
+}
+
+QString RepositoryError::text() const
+{
+    return m_text;
+}
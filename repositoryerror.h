@@ -0,0 +1,34 @@
+#ifndef REPOSITORYERROR_H
+#define REPOSITORYERROR_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+// Dernière erreur d'un dépôt, pour le thread courant. Chaque dépôt en tient
+// une (thread_local) et y fait passer la préparation et l'exécution de ses
+// requêtes : un succès efface l'erreur, lastError() décrit toujours le
+// dernier appel.
+class RepositoryError
+{
+public:
+    RepositoryError();
+
+    // Requête préparée par StatementCache ; nullptr si la préparation échoue
+    QSqlQuery *prepare(const QSqlDatabase &db, const QString &sql);
+
+    // Exécution profilée (QueryProfiler)
+    bool exec(QSqlQuery &query);
+    bool execBatch(QSqlQuery &query);
+
+    void set(const QString &message);
+    void clear();
+    QString text() const;
+
+private:
+    bool record(bool ok, const QSqlQuery &query);
+
+    QString m_text;
+};
+
+#endif // REPOSITORYERROR_H
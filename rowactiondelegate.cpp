@@ -0,0 +1,205 @@
+#include "rowactiondelegate.h"
+#include "thememanager.h"
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QHelpEvent>
+#include <QLinearGradient>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QToolTip>
+
+namespace {
+const int ButtonSize = 22;
+const int ButtonSpacing = 4;
+const int BadgeHeight = 30;
+const int BadgePadding = 20;
+const qreal BadgeRadius = 10.0;
+}
+
+RowActionDelegate::RowActionDelegate(int actionColumn, const QString &editToolTip, const QString &deleteToolTip,
+                                     QObject *parent)
+    : QStyledItemDelegate(parent),
+      m_actionColumn(actionColumn),
+      m_editToolTip(editToolTip),
+      m_deleteToolTip(deleteToolTip),
+      m_hoverButton(NoButton)
+{
+}
+
+QRect RowActionDelegate::buttonRect(const QRect &cell, Button button) const
+{
+    if (button == NoButton) {
+        return QRect();
+    }
+    // Les deux boutons, centrés dans la cellule
+    int left = cell.center().x() - ButtonSize - ButtonSpacing / 2;
+    if (button == DeleteButton) {
+        left += ButtonSize + ButtonSpacing;
+    }
+    return QRect(left, cell.center().y() - ButtonSize / 2, ButtonSize, ButtonSize);
+}
+
+RowActionDelegate::Button RowActionDelegate::buttonAt(const QRect &cell, const QPoint &pos) const
+{
+    if (buttonRect(cell, EditButton).contains(pos)) {
+        return EditButton;
+    }
+    if (buttonRect(cell, DeleteButton).contains(pos)) {
+        return DeleteButton;
+    }
+    return NoButton;
+}
+
+void RowActionDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    if (index.column() == m_actionColumn) {
+        paintPanel(painter, option, index);
+        bool hoveredRow = m_hoverIndex == index;
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        paintButton(painter, option, buttonRect(option.rect, EditButton), EditButton,
+                    hoveredRow && m_hoverButton == EditButton);
+        paintButton(painter, option, buttonRect(option.rect, DeleteButton), DeleteButton,
+                    hoveredRow && m_hoverButton == DeleteButton);
+        painter->restore();
+        return;
+    }
+
+    if (index.data(BadgeRole).toBool()) {
+        paintPanel(painter, option, index);
+        paintBadge(painter, option, index);
+        return;
+    }
+
+    QStyledItemDelegate::paint(painter, option, index);
+}
+
+void RowActionDelegate::paintPanel(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // Fond et sélection de la ligne, sans le texte ni la couleur de la cellule
+    QStyleOptionViewItem panel(option);
+    initStyleOption(&panel, index);
+    panel.text.clear();
+    panel.backgroundBrush = QBrush();
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &panel, painter, widget);
+}
+
+void RowActionDelegate::paintButton(QPainter *painter, const QStyleOptionViewItem &option, const QRect &rect,
+                                    Button button, bool hovered) const
+{
+    // Teintes primaire / danger du thème courant, assombries au survol
+    const ThemeManager &theme = ThemeManager::instance();
+    QLinearGradient gradient(rect.topLeft(), rect.bottomRight());
+    if (button == EditButton) {
+        gradient.setColorAt(0, hovered ? theme.primaryHoverColor() : theme.primaryColor());
+        gradient.setColorAt(1, theme.primaryPressedColor());
+    } else {
+        gradient.setColorAt(0, hovered ? theme.dangerHoverColor() : theme.dangerColor());
+        gradient.setColorAt(1, theme.dangerPressedColor());
+    }
+
+    QPainterPath path;
+    path.addRoundedRect(QRectF(rect), 4, 4);
+    painter->fillPath(path, gradient);
+
+    QFont font = painter->font();
+    font.setPixelSize(11);
+    font.setBold(true);
+    painter->setFont(font);
+    painter->setPen(option.palette.color(QPalette::BrightText));
+    painter->drawText(rect, Qt::AlignCenter, button == EditButton ? "✏️" : "🗑️");
+}
+
+void RowActionDelegate::paintBadge(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QString text = index.data(Qt::DisplayRole).toString();
+    QFont font = option.font;
+    font.setPixelSize(11);
+    font.setWeight(QFont::Bold);
+    font.setLetterSpacing(QFont::AbsoluteSpacing, 0.5);
+
+    int width = QFontMetrics(font).horizontalAdvance(text) + 2 * BadgePadding;
+    QRect badge(option.rect.left() + 8, option.rect.center().y() - BadgeHeight / 2,
+                qMin(width, option.rect.width() - 8), BadgeHeight);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    QPainterPath path;
+    path.addRoundedRect(QRectF(badge), BadgeRadius, BadgeRadius);
+    painter->fillPath(path, index.data(Qt::BackgroundRole).value<QColor>());
+    painter->setFont(font);
+    painter->setPen(index.data(Qt::ForegroundRole).value<QColor>());
+    painter->drawText(badge, Qt::AlignCenter, text);
+    painter->restore();
+}
+
+bool RowActionDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                    const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    switch (event->type()) {
+    case QEvent::MouseMove: {
+        auto *mouseEvent = static_cast<QMouseEvent*>(event);
+        Button hovered = index.column() == m_actionColumn
+                             ? buttonAt(option.rect, mouseEvent->position().toPoint())
+                             : NoButton;
+        if (m_hoverIndex != index || m_hoverButton != hovered) {
+            QModelIndex previous = m_hoverIndex;
+            m_hoverIndex = index;
+            m_hoverButton = hovered;
+            if (auto *view = qobject_cast<QAbstractItemView*>(const_cast<QWidget*>(option.widget))) {
+                view->viewport()->setCursor(hovered == NoButton ? Qt::ArrowCursor : Qt::PointingHandCursor);
+                // Seules l'ancienne et la nouvelle cellule survolées sont repeintes
+                if (previous.isValid()) {
+                    view->update(previous);
+                }
+                view->update(index);
+            }
+        }
+        return false;
+    }
+    case QEvent::MouseButtonRelease: {
+        auto *mouseEvent = static_cast<QMouseEvent*>(event);
+        if (mouseEvent->button() != Qt::LeftButton || index.column() != m_actionColumn) {
+            return false;
+        }
+        QVariant idData = index.data(RowIdRole);
+        if (!idData.isValid()) {
+            return false;
+        }
+        switch (buttonAt(option.rect, mouseEvent->position().toPoint())) {
+        case EditButton:
+            emit editRequested(idData.toInt());
+            return true;
+        case DeleteButton:
+            emit deleteRequested(idData.toInt());
+            return true;
+        default:
+            return false;
+        }
+    }
+    default:
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+}
+
+bool RowActionDelegate::helpEvent(QHelpEvent *event, QAbstractItemView *view,
+                                  const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (index.column() == m_actionColumn) {
+        switch (buttonAt(option.rect, event->pos())) {
+        case EditButton:
+            QToolTip::showText(event->globalPos(), m_editToolTip, view);
+            return true;
+        case DeleteButton:
+            QToolTip::showText(event->globalPos(), m_deleteToolTip, view);
+            return true;
+        default:
+            QToolTip::hideText();
+            return true;
+        }
+    }
+    return QStyledItemDelegate::helpEvent(event, view, option, index);
+}
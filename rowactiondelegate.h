@@ -0,0 +1,58 @@
+#ifndef ROWACTIONDELEGATE_H
+#define ROWACTIONDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+
+// Délégué des tableaux clients et utilisateurs. Les boutons Modifier /
+// Supprimer de la colonne d'actions sont peints et testés au clic ici :
+// aucune ligne ne porte de widgets. Une cellule dont BadgeRole est vrai
+// est peinte en pastille, aux couleurs Qt::BackgroundRole / ForegroundRole ;
+// les boutons prennent les teintes primaire et danger du ThemeManager.
+class RowActionDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        RowIdRole = Qt::UserRole + 1,   // identifiant transmis aux signaux
+        BadgeRole
+    };
+
+    enum Button {
+        NoButton,
+        EditButton,
+        DeleteButton
+    };
+
+    RowActionDelegate(int actionColumn, const QString &editToolTip, const QString &deleteToolTip,
+                      QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    bool helpEvent(QHelpEvent *event, QAbstractItemView *view,
+                   const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+signals:
+    void editRequested(int id);
+    void deleteRequested(int id);
+
+private:
+    QRect buttonRect(const QRect &cell, Button button) const;
+    Button buttonAt(const QRect &cell, const QPoint &pos) const;
+    void paintPanel(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    void paintButton(QPainter *painter, const QStyleOptionViewItem &option, const QRect &rect,
+                     Button button, bool hovered) const;
+    void paintBadge(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+
+    int m_actionColumn;
+    QString m_editToolTip;
+    QString m_deleteToolTip;
+    QPersistentModelIndex m_hoverIndex;
+    Button m_hoverButton;
+};
+
+#endif // ROWACTIONDELEGATE_H
@@ -0,0 +1,355 @@
+#include "saleschart.h"
+#include "databaseservice.h"
+#include "thememanager.h"
+#include <QChart>
+#include <QChartView>
+#include <QLineSeries>
+#include <QDateTimeAxis>
+#include <QValueAxis>
+#include <QLegend>
+#include <QPushButton>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPainter>
+#include <QDebug>
+#include <cmath>
+
+namespace {
+// Au-delà d'un mois affiché, un point par jour ; en dessous, un par heure
+const qint64 HourlyMaxDays = 31;
+const qint64 MinSpanSecs = 6 * 3600;
+const int ZoomDelayMs = 200;
+}
+
+SalesChart::SalesChart(QWidget *parent)
+    : QFrame(parent),
+      chart(nullptr),
+      chartView(nullptr),
+      revenueSeries(nullptr),
+      volumeSeries(nullptr),
+      timeAxis(nullptr),
+      revenueAxis(nullptr),
+      volumeAxis(nullptr),
+      statusLabel(nullptr),
+      presetDays(365),
+      updatingAxes(false),
+      loadGeneration(0)
+{
+    setObjectName("chartFrame");
+    setupUI();
+
+    // Le zoom à la souris modifie l'axe plusieurs fois de suite : une seule
+    // lecture une fois le geste terminé
+    zoomTimer.setSingleShot(true);
+    zoomTimer.setInterval(ZoomDelayMs);
+    connect(&zoomTimer, &QTimer::timeout, this, [this]() {
+        loadRange(timeAxis->min(), timeAxis->max());
+    });
+
+    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &SalesChart::applyChartColors);
+}
+
+void SalesChart::setupUI()
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setSpacing(16);
+    layout->setContentsMargins(24, 24, 24, 24);
+
+    QHBoxLayout *toolbarLayout = new QHBoxLayout();
+    toolbarLayout->setSpacing(8);
+
+    const QList<QPair<QString, int>> ranges = {
+        {"3 ans", 3 * 365},
+        {"1 an", 365},
+        {"1 mois", 30},
+        {"1 semaine", 7},
+        {"24 h", 1}
+    };
+    for (const auto &range : ranges) {
+        QPushButton *button = new QPushButton(range.first, this);
+        button->setCheckable(true);
+        button->setChecked(range.second == presetDays);
+        button->setProperty("days", range.second);
+        button->setMinimumHeight(34);
+        button->setObjectName("rangeButton");
+        connect(button, &QPushButton::clicked, this, &SalesChart::onRangeButtonClicked);
+        toolbarLayout->addWidget(button);
+        rangeButtons.append(button);
+    }
+    toolbarLayout->addStretch();
+
+    statusLabel = new QLabel(this);
+    statusLabel->setObjectName("chartStatus");
+    ThemeManager::setTone(statusLabel, "secondary");
+    toolbarLayout->addWidget(statusLabel);
+    layout->addLayout(toolbarLayout);
+
+    revenueSeries = new QLineSeries();
+    revenueSeries->setName("Chiffre d'affaires (€)");
+    volumeSeries = new QLineSeries();
+    volumeSeries->setName("Commandes");
+
+    chart = new QChart();
+    chart->addSeries(revenueSeries);
+    chart->addSeries(volumeSeries);
+    chart->setBackgroundRoundness(0);
+    chart->legend()->setAlignment(Qt::AlignBottom);
+
+    timeAxis = new QDateTimeAxis();
+    timeAxis->setFormat("dd/MM/yyyy");
+    timeAxis->setTickCount(7);
+    chart->addAxis(timeAxis, Qt::AlignBottom);
+
+    revenueAxis = new QValueAxis();
+    revenueAxis->setLabelFormat("%.0f");
+    chart->addAxis(revenueAxis, Qt::AlignLeft);
+
+    volumeAxis = new QValueAxis();
+    volumeAxis->setLabelFormat("%d");
+    chart->addAxis(volumeAxis, Qt::AlignRight);
+
+    revenueSeries->attachAxis(timeAxis);
+    revenueSeries->attachAxis(revenueAxis);
+    volumeSeries->attachAxis(timeAxis);
+    volumeSeries->attachAxis(volumeAxis);
+
+    connect(timeAxis, &QDateTimeAxis::rangeChanged, this, &SalesChart::onAxisRangeChanged);
+
+    chartView = new QChartView(chart, this);
+    chartView->setRenderHint(QPainter::Antialiasing);
+    chartView->setRubberBand(QChartView::HorizontalRubberBand);
+    chartView->setObjectName("chartView");
+    layout->addWidget(chartView, 1);
+
+    setMinimumHeight(520);
+    applyChartColors();
+}
+
+QString SalesChart::styleRules()
+{
+    return QString(
+        "#chartFrame {"
+        "   background: palette(alternate-base);"
+        "   border: 1px solid palette(mid);"
+        "   border-radius: 16px;"
+        "   padding: 0px;"
+        "}"
+        "#chartFrame QPushButton#rangeButton {"
+        "   background: transparent;"
+        "   color: palette(window-text);"
+        "   border: 1px solid palette(mid);"
+        "   border-radius: 8px;"
+        "   padding: 6px 14px;"
+        "   font-weight: 600;"
+        "}"
+        "#chartFrame QPushButton#rangeButton:checked {"
+        "   background: palette(highlight);"
+        "   color: white;"
+        "   border-color: palette(highlight);"
+        "}"
+        "#chartFrame QGraphicsView#chartView {"
+        "   background: transparent;"
+        "   border: none;"
+        "}"
+    );
+}
+
+void SalesChart::applyChartColors()
+{
+    // Le graphique est peint par QGraphicsView, hors feuille de style : ses
+    // couleurs sont reprises du thème, sans toucher aux séries chargées
+    ThemeManager& theme = ThemeManager::instance();
+    revenueSeries->setColor(theme.primaryColor());
+    volumeSeries->setColor(theme.successColor());
+    chart->setBackgroundBrush(theme.surfaceAltColor());
+    chart->legend()->setLabelColor(theme.textColor());
+    timeAxis->setLabelsColor(theme.textSecondaryColor());
+    revenueAxis->setLabelsColor(theme.textSecondaryColor());
+    volumeAxis->setLabelsColor(theme.textSecondaryColor());
+}
+
+void SalesChart::refresh()
+{
+    // Une plage prédéfinie suit l'heure courante, un zoom reste en place
+    if (presetDays > 0) {
+        QDateTime now = QDateTime::currentDateTime();
+        showRange(now.addDays(-presetDays), now);
+    } else if (rangeFrom.isValid()) {
+        loadRange(rangeFrom, rangeTo);
+    }
+}
+
+void SalesChart::onRangeButtonClicked()
+{
+    QPushButton *clicked = qobject_cast<QPushButton*>(sender());
+    if (!clicked) {
+        return;
+    }
+    for (QPushButton *button : rangeButtons) {
+        button->setChecked(button == clicked);
+    }
+    presetDays = clicked->property("days").toInt();
+    refresh();
+}
+
+void SalesChart::onAxisRangeChanged(const QDateTime &min, const QDateTime &max)
+{
+    Q_UNUSED(min);
+    Q_UNUSED(max);
+    if (updatingAxes) {
+        return;
+    }
+
+    // Zoom à la souris : la plage ne correspond plus à un bouton
+    presetDays = 0;
+    for (QPushButton *button : rangeButtons) {
+        button->setChecked(false);
+    }
+    zoomTimer.start();
+}
+
+void SalesChart::showRange(const QDateTime &from, const QDateTime &to)
+{
+    updatingAxes = true;
+    timeAxis->setRange(from, to);
+    updatingAxes = false;
+    loadRange(from, to);
+}
+
+int SalesChart::targetPoints() const
+{
+    // Un point par pixel de la zone de tracé suffit
+    int width = qRound(chart->plotArea().width());
+    return width > 0 ? qMax(width, 100) : 800;
+}
+
+void SalesChart::loadRange(const QDateTime &from, const QDateTime &to)
+{
+    QDateTime start = from;
+    if (start.secsTo(to) < MinSpanSecs) {
+        start = to.addSecs(-MinSpanSecs);
+    }
+    rangeFrom = start;
+    rangeTo = to;
+
+    const int points = targetPoints();
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    statusLabel->setText("Chargement...");
+
+    pendingLoad = DatabaseService::instance().run<SalesChartData>(
+        [start, to, points](QSqlDatabase &db) {
+            SalesChartData data;
+            data.granularity = start.daysTo(to) > HourlyMaxDays ? MetricsEngine::Daily
+                                                                  : MetricsEngine::Hourly;
+
+            QString error;
+            const QVector<SalesBucket> buckets = MetricsEngine::salesSeries(db, start, to, data.granularity, &error);
+            if (!error.isEmpty()) {
+                data.error = error;
+                return data;
+            }
+
+            QVector<QPointF> revenue;
+            QVector<QPointF> volume;
+            revenue.reserve(buckets.size());
+            volume.reserve(buckets.size());
+            for (const SalesBucket &bucket : buckets) {
+                const qreal x = bucket.start.toMSecsSinceEpoch();
+                revenue.append(QPointF(x, bucket.revenue));
+                volume.append(QPointF(x, bucket.orders));
+                data.maxRevenue = qMax(data.maxRevenue, bucket.revenue);
+                data.maxVolume = qMax(data.maxVolume, double(bucket.orders));
+            }
+
+            data.revenue = SalesChart::downsample(revenue, points);
+            data.volume = SalesChart::downsample(volume, points);
+            data.ok = true;
+            return data;
+        });
+
+    pendingLoad.then(this, [this, generation, start, to](const SalesChartData &data) {
+        if (generation == loadGeneration) {
+            applyData(data, start, to);
+        }
+    });
+}
+
+void SalesChart::applyData(const SalesChartData &data, const QDateTime &from, const QDateTime &to)
+{
+    if (!data.ok) {
+        qDebug() << "Erreur lors du chargement du graphique des ventes:" << data.error;
+        statusLabel->setText("Données indisponibles");
+        return;
+    }
+
+    revenueSeries->replace(data.revenue);
+    volumeSeries->replace(data.volume);
+
+    updatingAxes = true;
+    timeAxis->setFormat(data.granularity == MetricsEngine::Hourly ? "dd/MM HH:mm" : "dd/MM/yyyy");
+    timeAxis->setRange(from, to);
+    revenueAxis->setRange(0, data.maxRevenue > 0 ? data.maxRevenue * 1.1 : 1.0);
+    volumeAxis->setRange(0, data.maxVolume > 0 ? std::ceil(data.maxVolume * 1.1) : 1.0);
+    updatingAxes = false;
+
+    statusLabel->setText(data.granularity == MetricsEngine::Hourly ? "Par heure" : "Par jour");
+}
+
+QVector<QPointF> SalesChart::downsample(const QVector<QPointF> &points, int threshold)
+{
+    const int count = points.size();
+    if (threshold >= count || threshold < 3) {
+        return points;
+    }
+
+    QVector<QPointF> sampled;
+    sampled.reserve(threshold);
+    sampled.append(points.first());
+
+    // Le premier et le dernier point sont gardés, les autres répartis en
+    // threshold - 2 groupes : dans chacun on garde le point qui forme le plus
+    // grand triangle avec le point retenu avant et la moyenne du groupe suivant
+    const double every = double(count - 2) / (threshold - 2);
+    int previous = 0;
+
+    for (int i = 0; i < threshold - 2; ++i) {
+        int nextStart = int(std::floor((i + 1) * every)) + 1;
+        int nextEnd = qMin(int(std::floor((i + 2) * every)) + 1, count);
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (int j = nextStart; j < nextEnd; ++j) {
+            avgX += points[j].x();
+            avgY += points[j].y();
+        }
+        const int nextCount = nextEnd - nextStart;
+        if (nextCount > 0) {
+            avgX /= nextCount;
+            avgY /= nextCount;
+        } else {
+            avgX = points.last().x();
+            avgY = points.last().y();
+        }
+
+        const int rangeStart = int(std::floor(i * every)) + 1;
+        const int rangeEnd = int(std::floor((i + 1) * every)) + 1;
+        const QPointF &a = points[previous];
+        double maxArea = -1.0;
+        int selected = rangeStart;
+        for (int j = rangeStart; j < rangeEnd; ++j) {
+            const double area = std::abs((a.x() - avgX) * (points[j].y() - a.y())
+                                         - (a.x() - points[j].x()) * (avgY - a.y()));
+            if (area > maxArea) {
+                maxArea = area;
+                selected = j;
+            }
+        }
+
+        sampled.append(points[selected]);
+        previous = selected;
+    }
+
+    sampled.append(points.last());
+    return sampled;
+}
@@ -0,0 +1,85 @@
+#ifndef SALESCHART_H
+#define SALESCHART_H
+
+#include <QFrame>
+#include <QDateTime>
+#include <QFuture>
+#include <QPointF>
+#include <QVector>
+#include <QTimer>
+#include "metricsengine.h"
+
+class QChart;
+class QChartView;
+class QLineSeries;
+class QDateTimeAxis;
+class QValueAxis;
+class QPushButton;
+class QLabel;
+
+// Courbes réduites prêtes à afficher (x en millisecondes depuis l'époque)
+struct SalesChartData
+{
+    bool ok = false;
+    QString error;
+    MetricsEngine::Granularity granularity = MetricsEngine::Daily;
+    QVector<QPointF> revenue;
+    QVector<QPointF> volume;
+    double maxRevenue = 0.0;
+    double maxVolume = 0.0;
+};
+
+// Chiffre d'affaires et nombre de commandes dans le temps. Les créneaux
+// viennent de DAILY_SALES / HOURLY_SALES : par jour au-delà d'un mois
+// affiché, par heure en dessous. Sélectionner une zone à la souris zoome,
+// clic droit dézoome. Chaque courbe est réduite (LTTB) à la largeur du
+// graphique sur le thread base de données avant d'être affichée.
+class SalesChart : public QFrame
+{
+    Q_OBJECT
+
+public:
+    explicit SalesChart(QWidget *parent = nullptr);
+
+    static QString styleRules();
+
+    // Algorithme Largest-Triangle-Three-Buckets : garde threshold points en
+    // conservant les pics. points doit être trié par x.
+    static QVector<QPointF> downsample(const QVector<QPointF> &points, int threshold);
+
+public slots:
+    void refresh();
+
+private slots:
+    void onRangeButtonClicked();
+    void onAxisRangeChanged(const QDateTime &min, const QDateTime &max);
+    void applyChartColors();
+
+private:
+    void setupUI();
+    void showRange(const QDateTime &from, const QDateTime &to);
+    void loadRange(const QDateTime &from, const QDateTime &to);
+    void applyData(const SalesChartData &data, const QDateTime &from, const QDateTime &to);
+    int targetPoints() const;
+
+    QChart *chart;
+    QChartView *chartView;
+    QLineSeries *revenueSeries;
+    QLineSeries *volumeSeries;
+    QDateTimeAxis *timeAxis;
+    QValueAxis *revenueAxis;
+    QValueAxis *volumeAxis;
+    QLabel *statusLabel;
+    QList<QPushButton*> rangeButtons;
+
+    int presetDays;              // plage d'un bouton, 0 après un zoom
+    QDateTime rangeFrom;
+    QDateTime rangeTo;
+    QTimer zoomTimer;
+    bool updatingAxes;
+
+    QFuture<SalesChartData> pendingLoad;
+    int loadGeneration;
+};
+
+#endif // SALESCHART_H
@@ -0,0 +1,176 @@
+#include "salesrollup.h"
+#include "queryprofiler.h"
+#include "schemamigrator.h"
+#include "metricsengine.h"
+#include "repositoryerror.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+thread_local RepositoryError rollupError;
+
+struct RollupTable {
+    QString name;
+    QString bucketOf;   // créneau de la commande %1
+};
+
+const QList<RollupTable> Tables = {
+    {"SALES_ROLLUP_HOUR", "strftime('%Y-%m-%d %H:00:00', %1.date_commande, 'localtime')"},
+    {"SALES_ROLLUP_DAY", "date(%1.date_commande, 'localtime')"}
+};
+
+const QString Upsert = "ON CONFLICT(bucket, id_produit, id_user) DO UPDATE SET "
+                       "nb_commandes = nb_commandes + excluded.nb_commandes, "
+                       "quantite = quantite + excluded.quantite, "
+                       "chiffre_affaires = chiffre_affaires + excluded.chiffre_affaires; ";
+
+QString createStatement(const RollupTable &table)
+{
+    return QString("CREATE TABLE IF NOT EXISTS %1 ("
+                   "bucket TEXT NOT NULL, "
+                   "id_produit INTEGER NOT NULL, "
+                   "id_user INTEGER NOT NULL, "
+                   "nb_commandes INTEGER NOT NULL DEFAULT 0, "
+                   "quantite INTEGER NOT NULL DEFAULT 0, "
+                   "chiffre_affaires REAL NOT NULL DEFAULT 0, "
+                   "PRIMARY KEY (bucket, id_produit, id_user)) WITHOUT ROWID").arg(table.name);
+}
+
+// Lignes de commandes payées regroupées par créneau, produit et vendeur
+QString aggregateSelect(const RollupTable &table)
+{
+    return QString("SELECT %1, d.id_produit, c.id_user, COUNT(DISTINCT c.id_commande), "
+                   "SUM(d.quantite), SUM(d.total) "
+                   "FROM DETAILS_COMMANDE d JOIN COMMANDES c ON c.id_commande = d.id_commande ")
+        .arg(table.bucketOf.arg("c"));
+}
+
+// Ajoute (sign = "+") ou retire (sign = "-") la ligne row si sa commande est
+// payée. La commande ne compte pour le produit que sur sa première ligne.
+QString applyLine(const RollupTable &table, const QString &row, const QString &sign)
+{
+    QString statement = QString("INSERT INTO %1 (bucket, id_produit, id_user, nb_commandes, quantite, chiffre_affaires) "
+                                "SELECT %2, %3.id_produit, c.id_user, "
+                                "CASE WHEN EXISTS (SELECT 1 FROM DETAILS_COMMANDE d WHERE d.id_commande = %3.id_commande "
+                                "AND d.id_produit = %3.id_produit AND d.id_detail <> %3.id_detail) THEN 0 ELSE %4 1 END, "
+                                "%4 %3.quantite, %4 %3.total "
+                                "FROM COMMANDES c WHERE c.id_commande = %3.id_commande AND c.statut = 'PAYEE' ")
+                            .arg(table.name, table.bucketOf.arg("c"), row, sign) + Upsert;
+    if (sign == "-") {
+        statement += QString("DELETE FROM %1 WHERE bucket = (SELECT %2 FROM COMMANDES c WHERE c.id_commande = %3.id_commande) "
+                             "AND id_produit = %3.id_produit AND nb_commandes <= 0; ")
+                         .arg(table.name, table.bucketOf.arg("c"), row);
+    }
+    return statement;
+}
+
+// Ajoute ou retire toutes les lignes de la commande row (déjà payée)
+QString applyOrder(const RollupTable &table, const QString &row, const QString &sign)
+{
+    QString statement = QString("INSERT INTO %1 (bucket, id_produit, id_user, nb_commandes, quantite, chiffre_affaires) "
+                                "SELECT %2, d.id_produit, %3.id_user, %4 1, %4 SUM(d.quantite), %4 SUM(d.total) "
+                                "FROM DETAILS_COMMANDE d WHERE d.id_commande = %3.id_commande GROUP BY d.id_produit ")
+                            .arg(table.name, table.bucketOf.arg(row), row, sign) + Upsert;
+    if (sign == "-") {
+        statement += QString("DELETE FROM %1 WHERE bucket = %2 AND nb_commandes <= 0; ")
+                         .arg(table.name, table.bucketOf.arg(row));
+    }
+    return statement;
+}
+
+QString applyLines(const QString &row, const QString &sign)
+{
+    QString body;
+    for (const RollupTable &table : Tables) {
+        body += applyLine(table, row, sign);
+    }
+    return body;
+}
+
+QString applyOrders(const QString &row, const QString &sign)
+{
+    QString body;
+    for (const RollupTable &table : Tables) {
+        body += applyOrder(table, row, sign);
+    }
+    return body;
+}
+}
+
+SalesRollup::SalesRollup() {}
+
+QString SalesRollup::lastError()
+{
+    return rollupError.text();
+}
+
+QStringList SalesRollup::createStatements()
+{
+    bool backfill = !SchemaMigrator::tableExists("SALES_ROLLUP_DAY") || !SchemaMigrator::tableExists("SALES_ROLLUP_HOUR");
+
+    QStringList statements;
+    for (const RollupTable &table : Tables) {
+        statements << createStatement(table);
+    }
+    // Rapports par produit sur une période
+    statements << "CREATE INDEX IF NOT EXISTS idx_sales_rollup_day_produit ON SALES_ROLLUP_DAY(id_produit, bucket)";
+
+    // Lignes ajoutées, modifiées ou supprimées d'une commande payée
+    statements << "CREATE TRIGGER SALES_ROLLUP_DETAIL_AI AFTER INSERT ON DETAILS_COMMANDE BEGIN "
+                      + applyLines("NEW", "+") + "END"
+               << "CREATE TRIGGER SALES_ROLLUP_DETAIL_AU AFTER UPDATE OF id_commande, id_produit, quantite, total "
+                  "ON DETAILS_COMMANDE BEGIN " + applyLines("OLD", "-") + applyLines("NEW", "+") + "END"
+               << "CREATE TRIGGER SALES_ROLLUP_DETAIL_AD AFTER DELETE ON DETAILS_COMMANDE BEGIN "
+                      + applyLines("OLD", "-") + "END";
+
+    // Commande payée, annulée, déplacée ou supprimée : toutes ses lignes
+    statements << "CREATE TRIGGER SALES_ROLLUP_AU_OLD AFTER UPDATE OF date_commande, statut, id_user ON COMMANDES "
+                  "WHEN OLD.statut = 'PAYEE' BEGIN " + applyOrders("OLD", "-") + "END"
+               << "CREATE TRIGGER SALES_ROLLUP_AU_NEW AFTER UPDATE OF date_commande, statut, id_user ON COMMANDES "
+                  "WHEN NEW.statut = 'PAYEE' BEGIN " + applyOrders("NEW", "+") + "END"
+               << "CREATE TRIGGER SALES_ROLLUP_AD AFTER DELETE ON COMMANDES "
+                  "WHEN OLD.statut = 'PAYEE' BEGIN " + applyOrders("OLD", "-") + "END";
+    if (backfill) {
+        statements << backfillStatements();
+    }
+    return statements;
+}
+
+bool SalesRollup::rebuild(QSqlDatabase db)
+{
+    QStringList statements = backfillStatements() + MetricsEngine::rebuildStatements();
+
+    if (!db.transaction()) {
+        rollupError.set(db.lastError().text());
+        return false;
+    }
+    QSqlQuery query(db);
+    for (const QString &statement : statements) {
+        if (!QueryProfiler::exec(query, statement)) {
+            rollupError.set(query.lastError().text());
+            qDebug() << "Erreur lors de la reconstruction des agrégats:" << rollupError.text() << "\n" << statement;
+            db.rollback();
+            return false;
+        }
+    }
+    if (!db.commit()) {
+        rollupError.set(db.lastError().text());
+        db.rollback();
+        return false;
+    }
+    rollupError.clear();
+    return true;
+}
+
+QStringList SalesRollup::backfillStatements()
+{
+    QStringList statements;
+    for (const RollupTable &table : Tables) {
+        statements << QString("DELETE FROM %1").arg(table.name)
+                   << QString("INSERT INTO %1 (bucket, id_produit, id_user, nb_commandes, quantite, chiffre_affaires) "
+                              "%2 WHERE c.statut = 'PAYEE' GROUP BY 1, 2, 3")
+                          .arg(table.name, aggregateSelect(table));
+    }
+    return statements;
+}
@@ -0,0 +1,30 @@
+#ifndef SALESROLLUP_H
+#define SALESROLLUP_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Tables SALES_ROLLUP_HOUR / SALES_ROLLUP_DAY : ventes payées agrégées par
+// (créneau, produit, vendeur) — nombre de commandes, quantité et montant.
+// Comme DAILY_SALES, elles sont tenues par des triggers sur COMMANDES et
+// DETAILS_COMMANDE, quel que soit le code qui modifie une commande : les
+// rapports lisent un créneau au lieu de parcourir les commandes.
+class SalesRollup
+{
+public:
+    SalesRollup();
+
+    // Tables, index et triggers (migration du schéma)
+    static QStringList createStatements();
+
+    // Recalcule toutes les tables d'agrégats depuis l'historique des commandes
+    static bool rebuild(QSqlDatabase db = QSqlDatabase::database());
+
+    static QString lastError();
+
+private:
+    static QStringList backfillStatements();
+};
+
+#endif // SALESROLLUP_H
@@ -0,0 +1,256 @@
+#include "schemamigrator.h"
+#include "queryprofiler.h"
+#include "searchindex.h"
+#include "ordersummary.h"
+#include "countcache.h"
+#include "metricsengine.h"
+#include "salesrollup.h"
+#include "cashrepository.h"
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QDebug>
+#include <iterator>
+
+namespace {
+QString migrationError;
+
+// Nom du trigger défini par statement, vide si ce n'est pas un CREATE TRIGGER
+QString triggerName(const QString &statement)
+{
+    static const QRegularExpression createTrigger(
+        "^\\s*CREATE\\s+TRIGGER\\s+(?:IF\\s+NOT\\s+EXISTS\\s+)?(\\w+)",
+        QRegularExpression::CaseInsensitiveOption);
+    return createTrigger.match(statement).captured(1);
+}
+
+// Tables métier et index de pagination. Tout est en IF NOT EXISTS : une
+// base créée avant le versionnement (user_version = 0) passe chaque
+// migration sans rien perdre, et ses triggers sont redéfinis (execAll).
+QStringList coreStatements()
+{
+    return {
+        "CREATE TABLE IF NOT EXISTS USERS ("
+        "id_user INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "nom TEXT NOT NULL,"
+        "email TEXT NOT NULL UNIQUE,"
+        "mot_de_passe TEXT NOT NULL,"
+        "role TEXT NOT NULL CHECK (role IN ('ADMIN','VENDEUR','CAISSIER')),"
+        "actif INTEGER DEFAULT 1,"
+        "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP"
+        ");",
+
+        "CREATE TABLE IF NOT EXISTS PRODUITS ("
+        "id_produit INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "nom_produit TEXT NOT NULL, "
+        "description TEXT, "
+        "photo_produit VARCHAR(255), "
+        "prix_vente REAL NOT NULL, "
+        "prix_achat REAL, "
+        "stock INTEGER NOT NULL DEFAULT 0, "
+        "seuil_alerte INTEGER DEFAULT 5, "
+        "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP)",
+
+        "CREATE TABLE IF NOT EXISTS CLIENTS ("
+        "id_client INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "nom TEXT NOT NULL, "
+        "prenom TEXT, "
+        "telephone TEXT, "
+        "email TEXT, "
+        "adresse TEXT, "
+        "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP)",
+
+        "CREATE TABLE IF NOT EXISTS COMMANDES ("
+        "id_commande INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "id_client INTEGER NOT NULL, "
+        "id_user INTEGER NOT NULL, "
+        "date_commande DATETIME DEFAULT CURRENT_TIMESTAMP, "
+        "statut TEXT DEFAULT 'EN_COURS' CHECK(statut IN ('EN_COURS', 'PAYEE', 'ANNULEE')), "
+        "total REAL DEFAULT 0, "
+        "FOREIGN KEY(id_client) REFERENCES CLIENTS(id_client), "
+        "FOREIGN KEY(id_user) REFERENCES USERS(id_user))",
+
+        "CREATE TABLE IF NOT EXISTS DETAILS_COMMANDE ("
+        "id_detail INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "id_commande INTEGER NOT NULL, "
+        "id_produit INTEGER NOT NULL, "
+        "quantite INTEGER NOT NULL, "
+        "prix_unitaire REAL NOT NULL, "
+        "total REAL NOT NULL, "
+        "FOREIGN KEY(id_commande) REFERENCES COMMANDES(id_commande), "
+        "FOREIGN KEY(id_produit) REFERENCES PRODUITS(id_produit))",
+
+        "CREATE TABLE IF NOT EXISTS PAIEMENTS ("
+        "id_paiement INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "id_commande INTEGER NOT NULL, "
+        "montant REAL NOT NULL, "
+        "date_paiement DATETIME DEFAULT CURRENT_TIMESTAMP, "
+        "statut TEXT DEFAULT 'VALIDE' CHECK(statut IN ('VALIDE', 'ANNULE')), "
+        "FOREIGN KEY(id_commande) REFERENCES COMMANDES(id_commande))",
+
+        // Index composites (date, id) : tri et pagination par clé sans parcours complet
+        "CREATE INDEX IF NOT EXISTS idx_commandes_date ON COMMANDES(date_commande, id_commande)",
+        "CREATE INDEX IF NOT EXISTS idx_commandes_statut_date ON COMMANDES(statut, date_commande, id_commande)",
+        "CREATE INDEX IF NOT EXISTS idx_clients_date ON CLIENTS(date_creation, id_client)",
+        "CREATE INDEX IF NOT EXISTS idx_users_date ON USERS(date_creation, id_user)",
+        "CREATE INDEX IF NOT EXISTS idx_users_role_date ON USERS(role, date_creation, id_user)",
+        "CREATE INDEX IF NOT EXISTS idx_produits_date ON PRODUITS(date_creation, id_produit)",
+        "CREATE INDEX IF NOT EXISTS idx_paiements_date ON PAIEMENTS(date_paiement, id_paiement)",
+        "CREATE INDEX IF NOT EXISTS idx_paiements_statut_date ON PAIEMENTS(statut, date_paiement, id_paiement)",
+        // Clés étrangères utilisées par les triggers de résumé et d'index
+        "CREATE INDEX IF NOT EXISTS idx_commandes_client ON COMMANDES(id_client)",
+        "CREATE INDEX IF NOT EXISTS idx_commandes_user ON COMMANDES(id_user)",
+        // (id_commande, id_produit) : la remise en stock d'une commande annulée
+        // cherche ses lignes par produit
+        "CREATE INDEX IF NOT EXISTS idx_details_commande_produit ON DETAILS_COMMANDE(id_commande, id_produit)",
+        "CREATE INDEX IF NOT EXISTS idx_details_produit ON DETAILS_COMMANDE(id_produit)",
+        "CREATE INDEX IF NOT EXISTS idx_paiements_commande ON PAIEMENTS(id_commande)"
+    };
+}
+
+QStringList salesStatements()
+{
+    return MetricsEngine::createStatements() + SalesRollup::createStatements();
+}
+
+struct Migration {
+    int version;
+    const char *description;
+    QStringList (*statements)();
+    // Une migration facultative qui échoue est annulée seule et la version
+    // est tout de même atteinte : elle n'est pas retentée
+    bool optional;
+};
+
+// Dans l'ordre des versions. Les statements sont générés au moment de la
+// migration : les remplissages initiaux voient l'état réel de la base.
+const Migration Migrations[] = {
+    {1, "tables métier et index de pagination", coreStatements, false},
+    // Sans FTS5 dans le SQLite de Qt, les pages filtrent par LIKE
+    {2, "index plein texte", SearchIndex::createStatements, true},
+    {3, "résumé des commandes", OrderSummary::createStatements, false},
+    {4, "compteurs", CountCache::createStatements, false},
+    {5, "statistiques et agrégats de ventes", salesStatements, false},
+    {6, "caisse", CashRepository::createStatements, false}
+};
+
+bool execAll(QSqlQuery &query, const QStringList &statements)
+{
+    for (const QString &statement : statements) {
+        // Un trigger existant garde son ancien corps malgré IF NOT EXISTS :
+        // il est supprimé puis recréé
+        const QString trigger = triggerName(statement);
+        if (!trigger.isEmpty() && !QueryProfiler::exec(query, QString("DROP TRIGGER IF EXISTS %1").arg(trigger))) {
+            migrationError = query.lastError().text();
+            qDebug() << "Erreur de migration:" << migrationError << "\n" << statement;
+            return false;
+        }
+        if (!QueryProfiler::exec(query, statement)) {
+            migrationError = query.lastError().text();
+            qDebug() << "Erreur de migration:" << migrationError << "\n" << statement;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool apply(QSqlDatabase &db, const Migration &migration)
+{
+    if (!db.transaction()) {
+        migrationError = db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (migration.optional) {
+        QueryProfiler::exec(query, "SAVEPOINT migration_facultative");
+    }
+    if (!execAll(query, migration.statements())) {
+        if (!migration.optional) {
+            db.rollback();
+            return false;
+        }
+        QueryProfiler::exec(query, "ROLLBACK TO migration_facultative");
+        qDebug() << "Migration" << migration.version << "ignorée (" << migration.description << ")";
+    }
+    if (migration.optional) {
+        QueryProfiler::exec(query, "RELEASE migration_facultative");
+    }
+
+    // Le numéro de version est écrit dans la même transaction que le schéma
+    if (!QueryProfiler::exec(query, QString("PRAGMA user_version = %1").arg(migration.version))) {
+        migrationError = query.lastError().text();
+        db.rollback();
+        return false;
+    }
+    if (!db.commit()) {
+        migrationError = db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+}
+
+SchemaMigrator::SchemaMigrator() {}
+
+bool SchemaMigrator::migrate(QSqlDatabase db)
+{
+    migrationError.clear();
+
+    int version = currentVersion(db);
+    if (version < 0) {
+        qDebug() << "Impossible de lire la version du schéma:" << migrationError;
+        return false;
+    }
+    if (version > latestVersion()) {
+        // Base migrée par une version plus récente de l'application : les
+        // migrations n'ajoutant que des objets, on continue
+        qDebug() << "Schéma en version" << version << ", plus récent que l'application (" << latestVersion() << ")";
+        return true;
+    }
+
+    for (const Migration &migration : Migrations) {
+        if (migration.version <= version) {
+            continue;
+        }
+        if (!apply(db, migration)) {
+            qDebug() << "Échec de la migration" << migration.version << "(" << migration.description << "):"
+                     << migrationError;
+            return false;
+        }
+        qDebug() << "Migration" << migration.version << "appliquée :" << migration.description;
+    }
+
+    qDebug() << "Schéma à jour, version" << latestVersion();
+    return true;
+}
+
+int SchemaMigrator::currentVersion(const QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (!QueryProfiler::exec(query, "PRAGMA user_version") || !query.next()) {
+        migrationError = query.lastError().text();
+        return -1;
+    }
+    return query.value(0).toInt();
+}
+
+bool SchemaMigrator::tableExists(const QString &name, const QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    query.prepare("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?");
+    query.addBindValue(name);
+    return QueryProfiler::exec(query) && query.next();
+}
+
+int SchemaMigrator::latestVersion()
+{
+    return Migrations[std::size(Migrations) - 1].version;
+}
+
+QString SchemaMigrator::lastError()
+{
+    return migrationError;
+}
@@ -0,0 +1,43 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// Schéma de la base, versionné par PRAGMA user_version. Chaque migration
+// s'applique une seule fois, dans sa propre transaction avec le numéro de
+// version qu'elle atteint : une base n'est jamais laissée à mi-chemin.
+//
+// Tables et index sont créés en IF NOT EXISTS : un objet existant est
+// conservé tel quel. Les triggers, eux, sont toujours redéfinis : avant
+// chaque CREATE TRIGGER, la migration supprime le trigger du même nom, et
+// une base ancienne reçoit le corps actuel au lieu de garder le sien.
+//
+// Chaque migration appelle le createStatements() actuel de son module : tant
+// qu'une version n'est pas livrée, un correctif du module modifie la
+// migration qui le crée. Une fois livrée, la version est figée et toute
+// évolution s'ajoute en fin de liste dans schemamigrator.cpp, avec ses
+// propres instructions (copiées, pas le createStatements() du module) :
+//  - trigger modifié ou retiré : son CREATE ou un DROP TRIGGER IF EXISTS ;
+//  - colonne : ALTER TABLE ... ADD COLUMN.
+class SchemaMigrator
+{
+public:
+    SchemaMigrator();
+
+    // Applique les migrations manquantes ; false si l'une d'elles échoue
+    // (la base reste alors à la dernière version atteinte)
+    static bool migrate(QSqlDatabase db = QSqlDatabase::database());
+
+    // Version enregistrée dans la base, -1 si elle n'a pas pu être lue
+    static int currentVersion(const QSqlDatabase &db = QSqlDatabase::database());
+    static int latestVersion();
+
+    // Aide des migrations : la table (ou table virtuelle) existe-t-elle ?
+    // Les modules s'en servent pour ne remplir une table qu'à sa création.
+    static bool tableExists(const QString &name, const QSqlDatabase &db = QSqlDatabase::database());
+
+    static QString lastError();
+};
+
+#endif // SCHEMAMIGRATOR_H
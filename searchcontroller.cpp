@@ -0,0 +1,142 @@
+#include "searchcontroller.h"
+#include <QRegularExpression>
+
+SearchController::SearchController(QLineEdit *input, QObject *parent)
+    : QObject(parent), m_input(input), m_term(input->text().trimmed()),
+      m_hasResult(false), m_resultMode(Substring)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(defaultDebounceInterval());
+    connect(&m_timer, &QTimer::timeout, this, &SearchController::commit);
+    connect(m_input, &QLineEdit::textChanged, this, &SearchController::onTextChanged);
+    connect(m_input, &QLineEdit::returnPressed, this, &SearchController::flush);
+}
+
+int SearchController::defaultDebounceInterval()
+{
+    // Réglable sans recompiler : VENTE_SEARCH_DEBOUNCE_MS=0 désactive le délai
+    bool ok = false;
+    int msec = qEnvironmentVariableIntValue("VENTE_SEARCH_DEBOUNCE_MS", &ok);
+    return ok && msec >= 0 ? msec : 250;
+}
+
+void SearchController::setDebounceInterval(int msec)
+{
+    m_timer.setInterval(qMax(0, msec));
+}
+
+int SearchController::debounceInterval() const
+{
+    return m_timer.interval();
+}
+
+void SearchController::onTextChanged(const QString &text)
+{
+    Q_UNUSED(text);
+    m_timer.start();
+}
+
+void SearchController::flush()
+{
+    m_timer.stop();
+    commit();
+}
+
+void SearchController::commit()
+{
+    // Un espace ajouté ou retiré ne change pas la recherche
+    QString term = m_input->text().trimmed();
+    if (term == m_term) {
+        return;
+    }
+    m_term = term;
+    emit searchRequested(m_term);
+}
+
+void SearchController::rememberResult(const QString &term, MatchMode mode, const QVector<QSqlRecord> &rows)
+{
+    m_hasResult = true;
+    m_resultTerm = term;
+    m_resultMode = mode;
+    m_resultRows = rows;
+}
+
+void SearchController::forgetResult()
+{
+    m_hasResult = false;
+    m_resultTerm.clear();
+    m_resultRows.clear();
+}
+
+bool SearchController::narrowedResult(const QString &term, MatchMode mode,
+                                      const std::function<QString(const QSqlRecord &)> &text,
+                                      QVector<QSqlRecord> *rows) const
+{
+    if (!m_hasResult || mode != m_resultMode || !isNarrowing(m_resultTerm, term, mode)) {
+        return false;
+    }
+
+    rows->clear();
+    for (const QSqlRecord &record : m_resultRows) {
+        if (matches(term, text(record), mode)) {
+            rows->append(record);
+        }
+    }
+    return true;
+}
+
+bool SearchController::isNarrowing(const QString &previous, const QString &term, MatchMode mode)
+{
+    // Prolonger le terme ne peut que restreindre un LIKE comme un MATCH par
+    // préfixes : le nouveau résultat est inclus dans l'ancien
+    if (previous.isEmpty() || term.size() <= previous.size()) {
+        return false;
+    }
+    if (mode == Substring) {
+        return term.startsWith(previous, Qt::CaseInsensitive);
+    }
+    return fold(term).startsWith(fold(previous));
+}
+
+bool SearchController::matches(const QString &term, const QString &text, MatchMode mode)
+{
+    if (mode == Substring) {
+        return text.contains(term, Qt::CaseInsensitive);
+    }
+
+    const QStringList textWords = words(text);
+    const QStringList termWords = words(term);
+    for (const QString &termWord : termWords) {
+        bool found = false;
+        for (const QString &word : textWords) {
+            if (word.startsWith(termWord)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString SearchController::fold(const QString &text)
+{
+    // Comme le tokenizer unicode61 remove_diacritics : sans accents ni casse
+    const QString decomposed = text.normalized(QString::NormalizationForm_D);
+    QString folded;
+    folded.reserve(decomposed.size());
+    for (const QChar &c : decomposed) {
+        if (c.category() != QChar::Mark_NonSpacing) {
+            folded.append(c);
+        }
+    }
+    return folded.toCaseFolded();
+}
+
+QStringList SearchController::words(const QString &text)
+{
+    static const QRegularExpression separators("[^\\w]+", QRegularExpression::UseUnicodePropertiesOption);
+    return fold(text).split(separators, Qt::SkipEmptyParts);
+}
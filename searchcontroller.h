@@ -0,0 +1,68 @@
+#ifndef SEARCHCONTROLLER_H
+#define SEARCHCONTROLLER_H
+
+#include <QObject>
+#include <QLineEdit>
+#include <QSqlRecord>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+// Recherche commune aux pages de liste :
+//  - la saisie est regroupée (délai configurable) avant de relancer une requête ;
+//  - le dernier résultat complet est mémorisé, et un terme qui le prolonge
+//    ("dup" -> "dupo") est filtré en mémoire au lieu d'interroger la base.
+// Les résultats arrivés après une recherche plus récente sont écartés par
+// les pages (compteur de génération).
+class SearchController : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Sémantique du filtre SQL à reproduire en mémoire
+    enum MatchMode {
+        PrefixWords,   // FTS5 : chaque mot est préfixe d'un mot du texte
+        Substring      // LIKE '%terme%'
+    };
+
+    explicit SearchController(QLineEdit *input, QObject *parent = nullptr);
+
+    static int defaultDebounceInterval();
+    void setDebounceInterval(int msec);
+    int debounceInterval() const;
+
+    // Terme validé (après le délai), sans espaces autour
+    QString term() const { return m_term; }
+    void flush();
+
+    void rememberResult(const QString &term, MatchMode mode, const QVector<QSqlRecord> &rows);
+    void forgetResult();
+    bool narrowedResult(const QString &term, MatchMode mode,
+                        const std::function<QString(const QSqlRecord &)> &text,
+                        QVector<QSqlRecord> *rows) const;
+
+    static bool isNarrowing(const QString &previous, const QString &term, MatchMode mode);
+    static bool matches(const QString &term, const QString &text, MatchMode mode);
+
+signals:
+    void searchRequested(const QString &term);
+
+private slots:
+    void onTextChanged(const QString &text);
+    void commit();
+
+private:
+    static QString fold(const QString &text);
+    static QStringList words(const QString &text);
+
+    QLineEdit *m_input;
+    QTimer m_timer;
+    QString m_term;
+
+    bool m_hasResult;
+    QString m_resultTerm;
+    MatchMode m_resultMode;
+    QVector<QSqlRecord> m_resultRows;
+};
+
+#endif // SEARCHCONTROLLER_H
@@ -0,0 +1,194 @@
+#include "searchindex.h"
+#include "queryprofiler.h"
+#include "schemamigrator.h"
+#include "statementcache.h"
+#include <QSqlError>
+#include <QStringList>
+#include <QRegularExpression>
+#include <QDebug>
+
+namespace {
+// Document dénormalisé d'une commande : nom du client et noms des produits
+const QString ClientOf = "(SELECT nom || ' ' || COALESCE(prenom, '') FROM CLIENTS WHERE id_client = %1)";
+const QString ProductsOf = "(SELECT COALESCE(GROUP_CONCAT(p.nom_produit, ' '), '') "
+                           "FROM DETAILS_COMMANDE d JOIN PRODUITS p ON p.id_produit = d.id_produit "
+                           "WHERE d.id_commande = %1)";
+}
+
+bool SearchIndex::available = false;
+
+SearchIndex::SearchIndex() {}
+
+QStringList SearchIndex::createStatements()
+{
+    return productsIndexStatements() + clientsIndexStatements() + ordersIndexStatements();
+}
+
+bool SearchIndex::detect()
+{
+    // La migration qui crée l'index est facultative : une base ouverte par
+    // un SQLite sans FTS5 n'a aucune de ces tables
+    available = SchemaMigrator::tableExists("PRODUITS_FTS") && SchemaMigrator::tableExists("CLIENTS_FTS")
+                && SchemaMigrator::tableExists("COMMANDES_FTS");
+    if (available) {
+        qDebug() << "Index de recherche FTS5 prêt.";
+    } else {
+        qDebug() << "Index plein texte indisponible, recherche par LIKE.";
+    }
+    return available;
+}
+
+bool SearchIndex::indexOrderProducts(int commandeId, const QSqlDatabase &db, QString *error)
+{
+    if (!available) {
+        return true;
+    }
+
+    QSqlQuery *query = StatementCache::prepared(db,
+        QString("UPDATE COMMANDES_FTS SET produits = %1 WHERE rowid = ?").arg(ProductsOf.arg("?")), error);
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, commandeId);
+    query->bindValue(1, commandeId);
+    if (!QueryProfiler::exec(*query)) {
+        if (error) {
+            *error = query->lastError().text();
+        }
+        return false;
+    }
+    return true;
+}
+
+bool SearchIndex::isAvailable()
+{
+    return available;
+}
+
+QString SearchIndex::matchExpression(const QString &text)
+{
+    static const QRegularExpression separators("[^\\w]+", QRegularExpression::UseUnicodePropertiesOption);
+
+    QStringList terms;
+    const QStringList words = text.split(separators, Qt::SkipEmptyParts);
+    for (const QString &word : words) {
+        terms << QString("\"%1\"*").arg(word);
+    }
+    return terms.join(' ');
+}
+
+QStringList SearchIndex::productsIndexStatements()
+{
+    bool backfill = !SchemaMigrator::tableExists("PRODUITS_FTS");
+
+    // Table à contenu externe : le texte n'est stocké qu'une fois, dans PRODUITS
+    QStringList statements = {
+        "CREATE VIRTUAL TABLE IF NOT EXISTS PRODUITS_FTS USING fts5("
+        "nom_produit, description, "
+        "content='PRODUITS', content_rowid='id_produit', "
+        "tokenize='unicode61 remove_diacritics 2')",
+
+        "CREATE TRIGGER PRODUITS_FTS_AI AFTER INSERT ON PRODUITS BEGIN "
+        "INSERT INTO PRODUITS_FTS(rowid, nom_produit, description) "
+        "VALUES (NEW.id_produit, NEW.nom_produit, NEW.description); "
+        "END",
+
+        "CREATE TRIGGER PRODUITS_FTS_AD AFTER DELETE ON PRODUITS BEGIN "
+        "INSERT INTO PRODUITS_FTS(PRODUITS_FTS, rowid, nom_produit, description) "
+        "VALUES ('delete', OLD.id_produit, OLD.nom_produit, OLD.description); "
+        "END",
+
+        "CREATE TRIGGER PRODUITS_FTS_AU AFTER UPDATE OF nom_produit, description ON PRODUITS BEGIN "
+        "INSERT INTO PRODUITS_FTS(PRODUITS_FTS, rowid, nom_produit, description) "
+        "VALUES ('delete', OLD.id_produit, OLD.nom_produit, OLD.description); "
+        "INSERT INTO PRODUITS_FTS(rowid, nom_produit, description) "
+        "VALUES (NEW.id_produit, NEW.nom_produit, NEW.description); "
+        "END"
+    };
+    if (backfill) {
+        statements << "INSERT INTO PRODUITS_FTS(PRODUITS_FTS) VALUES ('rebuild')";
+    }
+    return statements;
+}
+
+QStringList SearchIndex::clientsIndexStatements()
+{
+    bool backfill = !SchemaMigrator::tableExists("CLIENTS_FTS");
+
+    QStringList statements = {
+        "CREATE VIRTUAL TABLE IF NOT EXISTS CLIENTS_FTS USING fts5("
+        "nom, prenom, email, "
+        "content='CLIENTS', content_rowid='id_client', "
+        "tokenize='unicode61 remove_diacritics 2')",
+
+        "CREATE TRIGGER CLIENTS_FTS_AI AFTER INSERT ON CLIENTS BEGIN "
+        "INSERT INTO CLIENTS_FTS(rowid, nom, prenom, email) "
+        "VALUES (NEW.id_client, NEW.nom, NEW.prenom, NEW.email); "
+        "END",
+
+        "CREATE TRIGGER CLIENTS_FTS_AD AFTER DELETE ON CLIENTS BEGIN "
+        "INSERT INTO CLIENTS_FTS(CLIENTS_FTS, rowid, nom, prenom, email) "
+        "VALUES ('delete', OLD.id_client, OLD.nom, OLD.prenom, OLD.email); "
+        "END",
+
+        "CREATE TRIGGER CLIENTS_FTS_AU AFTER UPDATE OF nom, prenom, email ON CLIENTS BEGIN "
+        "INSERT INTO CLIENTS_FTS(CLIENTS_FTS, rowid, nom, prenom, email) "
+        "VALUES ('delete', OLD.id_client, OLD.nom, OLD.prenom, OLD.email); "
+        "INSERT INTO CLIENTS_FTS(rowid, nom, prenom, email) "
+        "VALUES (NEW.id_client, NEW.nom, NEW.prenom, NEW.email); "
+        "END"
+    };
+    if (backfill) {
+        statements << "INSERT INTO CLIENTS_FTS(CLIENTS_FTS) VALUES ('rebuild')";
+    }
+    return statements;
+}
+
+QStringList SearchIndex::ordersIndexStatements()
+{
+    bool backfill = !SchemaMigrator::tableExists("COMMANDES_FTS");
+
+    // Document dénormalisé par commande (rowid = id_commande) : nom du client,
+    // numéro de commande et noms des produits commandés.
+
+    QStringList statements = {
+        "CREATE VIRTUAL TABLE IF NOT EXISTS COMMANDES_FTS USING fts5("
+        "client, numero, produits, "
+        "tokenize='unicode61 remove_diacritics 2')",
+
+        QString("CREATE TRIGGER COMMANDES_FTS_AI AFTER INSERT ON COMMANDES BEGIN "
+                "INSERT INTO COMMANDES_FTS(rowid, client, numero, produits) "
+                "VALUES (NEW.id_commande, %1, NEW.id_commande, %2); "
+                "END").arg(ClientOf.arg("NEW.id_client"), ProductsOf.arg("NEW.id_commande")),
+
+        "CREATE TRIGGER COMMANDES_FTS_AD AFTER DELETE ON COMMANDES BEGIN "
+        "DELETE FROM COMMANDES_FTS WHERE rowid = OLD.id_commande; "
+        "END",
+
+        QString("CREATE TRIGGER COMMANDES_FTS_AU AFTER UPDATE OF id_client ON COMMANDES BEGIN "
+                "UPDATE COMMANDES_FTS SET client = %1 WHERE rowid = NEW.id_commande; "
+                "END").arg(ClientOf.arg("NEW.id_client")),
+
+        // Pas de trigger à l'insertion d'une ligne : il recalculait toute la
+        // commande à chaque ligne d'un lot (voir indexOrderProducts)
+        QString("CREATE TRIGGER COMMANDES_FTS_DETAIL_AD AFTER DELETE ON DETAILS_COMMANDE BEGIN "
+                "UPDATE COMMANDES_FTS SET produits = %1 WHERE rowid = OLD.id_commande; "
+                "END").arg(ProductsOf.arg("OLD.id_commande")),
+
+        QString("CREATE TRIGGER COMMANDES_FTS_CLIENT_AU AFTER UPDATE OF nom, prenom ON CLIENTS BEGIN "
+                "UPDATE COMMANDES_FTS SET client = %1 "
+                "WHERE rowid IN (SELECT id_commande FROM COMMANDES WHERE id_client = NEW.id_client); "
+                "END").arg(ClientOf.arg("NEW.id_client")),
+
+        QString("CREATE TRIGGER COMMANDES_FTS_PRODUIT_AU AFTER UPDATE OF nom_produit ON PRODUITS BEGIN "
+                "UPDATE COMMANDES_FTS SET produits = %1 "
+                "WHERE rowid IN (SELECT id_commande FROM DETAILS_COMMANDE WHERE id_produit = NEW.id_produit); "
+                "END").arg(ProductsOf.arg("COMMANDES_FTS.rowid"))
+    };
+    if (backfill) {
+        statements << QString("INSERT INTO COMMANDES_FTS(rowid, client, numero, produits) "
+                              "SELECT c.id_commande, %1, c.id_commande, %2 FROM COMMANDES c")
+                          .arg(ClientOf.arg("c.id_client"), ProductsOf.arg("c.id_commande"));
+    }
+    return statements;
+}
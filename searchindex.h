@@ -0,0 +1,43 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Index plein texte FTS5 des produits, clients et commandes.
+// Les tables virtuelles sont tenues à jour par des triggers ; si le module
+// FTS5 n'est pas disponible, les pages retombent sur des filtres LIKE.
+// Exception : les produits d'une commande sont indexés une fois pour toutes
+// ses lignes par indexOrderProducts(), qu'appelle OrderRepository::checkout,
+// seul endroit où DETAILS_COMMANDE reçoit des lignes.
+class SearchIndex
+{
+public:
+    SearchIndex();
+
+    // Tables virtuelles et triggers (migration facultative du schéma)
+    static QStringList createStatements();
+
+    // Relève au démarrage si l'index existe dans la base ouverte
+    static bool detect();
+    static bool isAvailable();
+
+    // Transforme la saisie utilisateur en requête MATCH par préfixes :
+    // "dell lat" -> "dell"* "lat"*  (chaîne vide si aucun mot exploitable)
+    static QString matchExpression(const QString &text);
+
+    // Recalcule les produits indexés d'une commande après l'insertion de ses
+    // lignes, dans la transaction de l'appelant. Sans index : ne fait rien.
+    static bool indexOrderProducts(int commandeId, const QSqlDatabase &db = QSqlDatabase::database(),
+                                   QString *error = nullptr);
+
+private:
+    static QStringList productsIndexStatements();
+    static QStringList clientsIndexStatements();
+    static QStringList ordersIndexStatements();
+
+    static bool available;
+};
+
+#endif // SEARCHINDEX_H
@@ -1,5 +1,4 @@
 #include "sidebar.h"
-#include "thememanager.h"
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QSignalMapper>
@@ -20,72 +19,6 @@ Sidebar::Sidebar(const QString &userRole, QWidget *parent) : QWidget(parent)
     layout->addWidget(appTitle);
     layout->addSpacing(30); // Espace après le titre
 
-    // Appliquer les styles initaux du sidebar
-    QString sidebarStyle = QString(
-        "#sidebar { "
-        "background-color: %1; "
-        "border-right: 1px solid %2; "
-        "}"
-        "#sidebarTitle { "
-        "font-size: 18px; "
-        "font-weight: bold; "
-        "color: %3; "
-        "margin: 16px 0; "
-        "}"
-        "#sidebarButton { "
-        "background-color: transparent; "
-        "color: %3; "
-        "border: 2px solid transparent; "
-        "border-radius: 8px; "
-        "padding: 10px 12px; "
-        "font-size: 13px; "
-        "text-align: left; "
-        "font-weight: 500; "
-        "}"
-        "#sidebarButton:hover { "
-        "background-color: %4; "
-        "border: 2px solid %5; "
-        "}"
-        "#sidebarButton:checked { "
-        "background-color: %5; "
-        "color: white; "
-        "border: 2px solid %5; "
-        "}"
-        "#themeButton { "
-        "background-color: %4; "
-        "color: %3; "
-        "border: 2px solid %5; "
-        "border-radius: 8px; "
-        "padding: 10px 12px; "
-        "font-size: 13px; "
-        "font-weight: bold; "
-        "}"
-        "#themeButton:hover { "
-        "background-color: %5; "
-        "color: white; "
-        "}"
-        "#logoutButton { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #ef4444, stop:1 #dc2626); "
-        "color: white; "
-        "border: none; "
-        "border-radius: 8px; "
-        "padding: 10px 12px; "
-        "font-weight: bold; "
-        "font-size: 13px; "
-        "}"
-        "#logoutButton:hover { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #dc2626, stop:1 #991b1b); "
-        "}"
-    ).arg(
-        ThemeManager::instance().backgroundColor().name(),
-        ThemeManager::instance().borderColor().name(),
-        ThemeManager::instance().textColor().name(),
-        ThemeManager::instance().surfaceColor().name(),
-        ThemeManager::instance().primaryColor().name()
-    );
-    
-    setStyleSheet(sidebarStyle);
-
     mapper = new QSignalMapper(this);
     connect(mapper, SIGNAL(mappedInt(int)), this, SIGNAL(pageChanged(int)));
 
@@ -122,31 +55,18 @@ Sidebar::Sidebar(const QString &userRole, QWidget *parent) : QWidget(parent)
 
     layout->addStretch(); // Pousse les boutons vers le haut
 
+    // Bascule clair/sombre, sans recharger les pages (ThemeManager)
+    QPushButton *themeBtn = new QPushButton("🌓  Thème clair / sombre", this);
+    themeBtn->setObjectName("themeButton");
+    themeBtn->setCursor(Qt::PointingHandCursor);
+    connect(themeBtn, &QPushButton::clicked, this, &Sidebar::themeToggled);
+    layout->addWidget(themeBtn);
+
     // Ajouter le bouton de déconnexion en bas
     QPushButton *logoutBtn = new QPushButton("🚪 Déconnexion", this);
     logoutBtn->setObjectName("logoutButton");
     logoutBtn->setMinimumHeight(48);
     logoutBtn->setCursor(Qt::PointingHandCursor);
-    logoutBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
-        "   stop:0 #ef4444, stop:1 #dc2626);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 12px;"
-        "   padding: 12px 20px;"
-        "   font-size: 14px;"
-        "   font-weight: 600;"
-        "   margin: 8px 0;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
-        "   stop:0 #dc2626, stop:1 #b91c1c);"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #b91c1c;"
-        "}"
-    );
     connect(logoutBtn, &QPushButton::clicked, this, &Sidebar::logoutRequested);
     layout->addWidget(logoutBtn);
 
@@ -155,24 +75,22 @@ Sidebar::Sidebar(const QString &userRole, QWidget *parent) : QWidget(parent)
     }
 }
 
-void Sidebar::updateTheme()
+QString Sidebar::styleRules()
 {
-    ThemeManager& theme = ThemeManager::instance();
-    
-    QString sidebarStyle = QString(
+    return QString(
         "#sidebar {"
-        "   background-color: %1;"
-        "   border-right: 1px solid %2;"
+        "   background-color: palette(window);"
+        "   border-right: 1px solid palette(mid);"
         "}"
-        "#sidebarTitle {"
+        "#sidebar #sidebarTitle {"
         "   font-size: 18px;"
         "   font-weight: bold;"
-        "   color: %3;"
+        "   color: palette(window-text);"
         "   margin: 16px 0;"
         "}"
-        "#sidebarButton {"
+        "#sidebar #sidebarButton {"
         "   background-color: transparent;"
-        "   color: %3;"
+        "   color: palette(window-text);"
         "   border: 2px solid transparent;"
         "   border-radius: 8px;"
         "   padding: 10px 12px;"
@@ -180,50 +98,43 @@ void Sidebar::updateTheme()
         "   text-align: left;"
         "   font-weight: 500;"
         "}"
-        "#sidebarButton:hover {"
-        "   background-color: %4;"
-        "   border: 2px solid %5;"
+        "#sidebar #sidebarButton:hover {"
+        "   background-color: palette(button);"
+        "   border: 2px solid palette(highlight);"
         "}"
-        "#sidebarButton:checked {"
-        "   background-color: %5;"
+        "#sidebar #sidebarButton:checked {"
+        "   background-color: palette(highlight);"
         "   color: white;"
-        "   border: 2px solid %5;"
+        "   border: 2px solid palette(highlight);"
         "}"
-        "#themeButton {"
-        "   background-color: %4;"
-        "   color: %3;"
-        "   border: 2px solid %5;"
+        "#sidebar #themeButton {"
+        "   background-color: palette(button);"
+        "   color: palette(window-text);"
+        "   border: 2px solid palette(highlight);"
         "   border-radius: 8px;"
         "   padding: 10px 12px;"
         "   font-size: 13px;"
         "   font-weight: bold;"
         "}"
-        "#themeButton:hover {"
-        "   background-color: %5;"
+        "#sidebar #themeButton:hover {"
+        "   background-color: palette(highlight);"
         "   color: white;"
         "}"
-        "#logoutButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 %6, stop:1 %7);"
+        "#sidebar QPushButton#logoutButton {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #ef4444, stop:1 #dc2626);"
         "   color: white;"
         "   border: none;"
-        "   border-radius: 8px;"
-        "   padding: 10px 12px;"
-        "   font-weight: bold;"
-        "   font-size: 13px;"
+        "   border-radius: 12px;"
+        "   padding: 12px 20px;"
+        "   font-size: 14px;"
+        "   font-weight: 600;"
+        "   margin: 8px 0;"
+        "}"
+        "#sidebar QPushButton#logoutButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #dc2626, stop:1 #b91c1c);"
         "}"
-        "#logoutButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 %7, stop:1 %8);"
+        "#sidebar QPushButton#logoutButton:pressed {"
+        "   background: #b91c1c;"
         "}"
-    ).arg(
-        theme.backgroundColor().name(),
-        theme.borderColor().name(),
-        theme.textColor().name(),
-        theme.surfaceColor().name(),
-        theme.primaryColor().name(),
-        theme.dangerColor().name(),
-        theme.dangerHoverColor().name(),
-        theme.dangerPressedColor().name()
     );
-    
-    setStyleSheet(sidebarStyle);
 }
@@ -13,13 +13,13 @@ class Sidebar : public QWidget
 public:
     explicit Sidebar(const QString &userRole, QWidget *parent = nullptr);
 
+    static QString styleRules();
+
 signals:
     void pageChanged(int pageIndex);
+    void themeToggled();
     void logoutRequested();
 
-public slots:
-    void updateTheme();
-
 private:
     QVBoxLayout *layout;
     QSignalMapper *mapper;
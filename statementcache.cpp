@@ -0,0 +1,62 @@
+#include "statementcache.h"
+#include <QCache>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+// Clé : nom de connexion + SQL. QCache supprime la requête la moins
+// récemment utilisée quand le cache est plein.
+using Statements = QCache<QString, QSqlQuery>;
+
+Statements &threadStatements()
+{
+    thread_local Statements statements(StatementCache::MaxStatements);
+    return statements;
+}
+
+QString keyFor(const QString &connectionName, const QString &sql)
+{
+    return connectionName + QLatin1Char('\n') + sql;
+}
+}
+
+StatementCache::StatementCache() {}
+
+QSqlQuery *StatementCache::prepared(const QSqlDatabase &db, const QString &sql, QString *error)
+{
+    Statements &statements = threadStatements();
+    const QString key = keyFor(db.connectionName(), sql);
+
+    if (QSqlQuery *query = statements.object(key)) {
+        query->finish();
+        return query;
+    }
+
+    auto *query = new QSqlQuery(db);
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        // Pas mis en cache (table pas encore créée, par exemple) : le
+        // prochain appel réessaiera
+        const QString message = query->lastError().text();
+        qDebug() << "Erreur de préparation:" << message << "\n" << sql;
+        delete query;
+        if (error) {
+            *error = message;
+        }
+        return nullptr;
+    }
+    statements.insert(key, query);
+    return query;
+}
+
+void StatementCache::clear(const QString &connectionName)
+{
+    Statements &statements = threadStatements();
+    const QString prefix = connectionName + QLatin1Char('\n');
+    const QList<QString> keys = statements.keys();
+    for (const QString &key : keys) {
+        if (key.startsWith(prefix)) {
+            statements.remove(key);
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+// Requêtes préparées une seule fois par connexion et réutilisées ensuite :
+// SQLite ne réanalyse ni ne replanifie le SQL à chaque appel.
+// Chaque thread a son propre cache (une connexion SQLite n'est utilisée que
+// par le thread qui l'a ouverte), limité aux MaxStatements requêtes les plus
+// récemment utilisées : le SQL construit par les pages (filtre, reprise,
+// LIMIT) ne s'accumule pas. Les valeurs se lient par position et les
+// résultats se lisent en avant ; appeler finish() après une lecture.
+class StatementCache
+{
+public:
+    StatementCache();
+
+    // Requête préparée, ou nullptr si la préparation échoue (error reçoit
+    // alors le message). Le pointeur reste valide jusqu'à ce que
+    // MaxStatements autres requêtes soient préparées sur ce thread.
+    static QSqlQuery *prepared(const QSqlDatabase &db, const QString &sql, QString *error = nullptr);
+
+    // À appeler avant de fermer une connexion, depuis son thread
+    static void clear(const QString &connectionName);
+
+    static const int MaxStatements = 64;
+};
+
+#endif // STATEMENTCACHE_H
@@ -3,34 +3,24 @@
 
 #include <QString>
 
+// Feuille de style unique de l'application. Elle est assemblée une seule
+// fois : règles communes de ThemeManager, puis les règles de chaque page,
+// ciblées par objectName (#clientsPage QLabel#pageIcon...). Aucun widget
+// ne porte sa propre feuille : Qt n'analyse le QSS qu'une fois, à son
+// installation, au lieu d'une fois par widget construit.
+//
+// Les couleurs neutres (fonds, textes, bordures) passent par palette(...),
+// les teintes d'état par [theme=...] avec setTone() ou "variant" : la
+// feuille ne dépend pas du thème et n'est jamais reconstruite. Restent en
+// dur les couleurs d'accent des boutons (dégradés, texte blanc), lisibles
+// dans les deux thèmes.
 class StyleSheet
 {
 public:
-    StyleSheet();
-
-    static QString getStyleSheet();
+    static const QString &getStyleSheet();
 
 private:
-    // Couleurs primaires
-    static const QString PRIMARY;
-    static const QString SECONDARY;
-    static const QString ACCENT;
-
-    // Couleurs fonctionnelles
-    static const QString SUCCESS;
-    static const QString WARNING;
-    static const QString ERROR;
-    static const QString INFO;
-
-    // Neutres
-    static const QString BACKGROUND;
-    static const QString SURFACE;
-    static const QString BORDER;
-    static const QString TEXT_PRIMARY;
-    static const QString TEXT_SECONDARY;
-
-    // Typographie
-    static const QString FONT_FAMILY;
+    static QString compile();
 };
 
 #endif // STYLESHEET_H
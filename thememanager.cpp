@@ -1,8 +1,10 @@
 #include "thememanager.h"
+#include "stylesheet.h"
+#include "uiprofiler.h"
 #include <QSettings>
 #include <QApplication>
-#include <QFile>
-#include <QTextStream>
+#include <QStyle>
+#include <QWidget>
 
 ThemeManager& ThemeManager::instance()
 {
@@ -11,10 +13,8 @@ ThemeManager& ThemeManager::instance()
 }
 
 ThemeManager::ThemeManager()
-    : QObject(), m_currentTheme(DarkMode)
+    : QObject(), m_currentTheme(DarkMode), m_appliedTheme(DarkMode), m_styleSheetInstalled(false)
 {
-    // Force le mode sombre uniquement
-    m_currentTheme = DarkMode;
     loadThemePreference();
 }
 
@@ -25,32 +25,17 @@ ThemeManager::Theme ThemeManager::currentTheme() const
 
 void ThemeManager::setTheme(Theme theme)
 {
-    // Force toujours le mode sombre
-    theme = DarkMode;
-    
     if (m_currentTheme != theme) {
         m_currentTheme = theme;
         saveThemePreference();
-        
-        // Charge toujours le fichier dark theme
-        QString qssFile = ":/themes/dark_theme.qss";
-        
-        QFile file(qssFile);
-        if (file.open(QFile::ReadOnly | QFile::Text)) {
-            QTextStream stream(&file);
-            QString stylesheet = stream.readAll();
-            file.close();
-            qApp->setStyleSheet(stylesheet);
-        }
-        
+        applyToApplication();
         emit themeChanged(theme);
     }
 }
 
 void ThemeManager::toggleTheme()
 {
-    // Ne fait rien - le mode sombre est forcé
-    return;
+    setTheme(m_currentTheme == LightMode ? DarkMode : LightMode);
 }
 
 // Couleurs générales
@@ -197,167 +182,314 @@ QColor ThemeManager::disabledColor() const
     return (m_currentTheme == LightMode) ? QColor("#cbd5e1") : QColor("#64748b");
 }
 
+QPalette ThemeManager::palette() const
+{
+    QPalette palette;
+    palette.setColor(QPalette::Window, backgroundColor());
+    palette.setColor(QPalette::WindowText, textColor());
+    palette.setColor(QPalette::Text, textColor());
+    palette.setColor(QPalette::ButtonText, textColor());
+    palette.setColor(QPalette::Base, inputBackground());
+    palette.setColor(QPalette::AlternateBase, surfaceAltColor());
+    palette.setColor(QPalette::Button, surfaceColor());
+    palette.setColor(QPalette::PlaceholderText, textTertiaryColor());
+    palette.setColor(QPalette::ToolTipBase, surfaceAltColor());
+    palette.setColor(QPalette::ToolTipText, textColor());
+    palette.setColor(QPalette::Mid, borderColor());
+    palette.setColor(QPalette::Midlight, borderLightColor());
+    palette.setColor(QPalette::Highlight, primaryColor());
+    palette.setColor(QPalette::HighlightedText, QColor(Qt::white));
+    palette.setColor(QPalette::Link, primaryColor());
+    palette.setColor(QPalette::LinkVisited, primaryPressedColor());
+    palette.setColor(QPalette::BrightText, QColor(Qt::white));
+
+    palette.setColor(QPalette::Disabled, QPalette::Button, disabledColor());
+    palette.setColor(QPalette::Disabled, QPalette::ButtonText, textTertiaryColor());
+    palette.setColor(QPalette::Disabled, QPalette::WindowText, textTertiaryColor());
+    palette.setColor(QPalette::Disabled, QPalette::Text, textTertiaryColor());
+    return palette;
+}
+
+void ThemeManager::applyToApplication()
+{
+    UiProfiler::Scope scope("ThemeManager::applyToApplication");
+    QString name = themeName(m_currentTheme);
+    const QWidgetList windows = QApplication::topLevelWidgets();
+    for (QWidget *window : windows) {
+        window->setProperty("theme", name);
+    }
+
+    // Première installation : Qt analyse la feuille et polit tout lui-même
+    if (!m_styleSheetInstalled) {
+        qApp->setPalette(palette());
+        qApp->setStyleSheet(StyleSheet::getStyleSheet());
+        m_styleSheetInstalled = true;
+        m_appliedTheme = m_currentTheme;
+        return;
+    }
+
+    // Nouvelle fenêtre, même thème : elle sera polie à son affichage
+    if (m_appliedTheme == m_currentTheme) {
+        return;
+    }
+    m_appliedTheme = m_currentTheme;
+    qApp->setPalette(palette());
+
+    // palette(...) et [theme=...] ne sont réévalués qu'au polish
+    const QWidgetList widgets = QApplication::allWidgets();
+    for (QWidget *widget : widgets) {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+        widget->update();
+    }
+}
+
+void ThemeManager::setTone(QWidget *widget, const QString &tone)
+{
+    if (widget->property("tone").toString() == tone) {
+        return;
+    }
+    widget->setProperty("tone", tone);
+    widget->style()->unpolish(widget);
+    widget->style()->polish(widget);
+}
+
+QString ThemeManager::themeName(Theme theme)
+{
+    return (theme == LightMode) ? "light" : "dark";
+}
+
+ThemeManager::StatusColors ThemeManager::statusColors(Theme theme) const
+{
+    StatusColors colors;
+    if (theme == LightMode) {
+        colors.primary = lightColors.primary;
+        colors.primaryHover = lightColors.primaryHover;
+        colors.primaryPressed = lightColors.primaryPressed;
+        colors.textSecondary = lightColors.textSecondary;
+        colors.success = lightColors.success;
+        colors.warning = lightColors.warning;
+        colors.danger = lightColors.danger;
+        colors.info = lightColors.info;
+        colors.disabled = QColor("#cbd5e1");
+    } else {
+        colors.primary = darkColors.primary;
+        colors.primaryHover = darkColors.primaryHover;
+        colors.primaryPressed = darkColors.primaryPressed;
+        colors.textSecondary = darkColors.textSecondary;
+        colors.success = darkColors.success;
+        colors.warning = darkColors.warning;
+        colors.danger = darkColors.danger;
+        colors.info = darkColors.info;
+        colors.disabled = QColor("#64748b");
+    }
+    return colors;
+}
+
+QString ThemeManager::buttonRules(const QString &selector, const QString &color,
+                                  const QString &hover, const QString &pressed)
+{
+    return QString(
+        "%1 {"
+        "   background: %2;"
+        "   color: palette(highlighted-text);"
+        "   border: 2px solid %2;"
+        "   border-radius: 6px;"
+        "   padding: 10px 20px;"
+        "   font-weight: 600;"
+        "   font-size: 13px;"
+        "}"
+        "%1:hover {"
+        "   background: %3;"
+        "   border-color: %3;"
+        "}"
+        "%1:pressed {"
+        "   background: %4;"
+        "   border-color: %4;"
+        "}"
+        "%1:disabled {"
+        "   background: palette(midlight);"
+        "   color: palette(placeholder-text);"
+        "   border-color: palette(midlight);"
+        "}"
+    ).arg(selector, color, hover, pressed);
+}
+
+QString ThemeManager::statusRules() const
+{
+    // Texte tertiaire : rôle palette dédié
+    QString rules = "*[tone=\"tertiary\"] { color: palette(placeholder-text); }";
+
+    // Texte secondaire, boutons primaires (survol, appui) et teintes d'état
+    // n'ont pas de rôle palette : une règle par thème, choisie par la
+    // propriété "theme" de la fenêtre ; les deux thèmes sont dans la même feuille
+    for (Theme theme : {LightMode, DarkMode}) {
+        StatusColors colors = statusColors(theme);
+        QString scope = QString("*[theme=\"%1\"] ").arg(themeName(theme));
+        rules += QString("%1*[tone=\"secondary\"] { color: %2; }").arg(scope, colors.textSecondary.name());
+        rules += buttonRules(QString("%1QPushButton[variant=\"primary\"]").arg(scope),
+                             colors.primary.name(), colors.primaryHover.name(), colors.primaryPressed.name());
+
+        const QList<QPair<QString, QColor>> tones = {
+            {"success", colors.success},
+            {"warning", colors.warning},
+            {"danger", colors.danger},
+            {"info", colors.info}
+        };
+        for (const auto &tone : tones) {
+            rules += QString("%1*[tone=\"%2\"] { color: %3; }")
+                         .arg(scope, tone.first, tone.second.name());
+            rules += buttonRules(QString("%1QPushButton[variant=\"%2\"]").arg(scope, tone.first),
+                                 tone.second.name(),
+                                 tone.second.darker(115).name(),
+                                 tone.second.darker(130).name());
+        }
+        rules += QString("%1QPushButton[variant]:disabled { background: %2; border-color: %2; }")
+                     .arg(scope, colors.disabled.name());
+    }
+
+    // Boutons d'action des lignes de tableau, identiques dans les deux thèmes
+    rules +=
+        "QPushButton[rowAction] {"
+        "   color: white;"
+        "   border: none;"
+        "   border-radius: 4px;"
+        "   font-size: 11px;"
+        "   font-weight: bold;"
+        "   padding: 0px;"
+        "}"
+        "QPushButton[rowAction=\"edit\"] {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
+        "}"
+        "QPushButton[rowAction=\"edit\"]:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #5568d3, stop:1 #6a3a8a);"
+        "}"
+        "QPushButton[rowAction=\"edit\"]:pressed {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #4556b8, stop:1 #5a2a7a);"
+        "}"
+        "QPushButton[rowAction=\"delete\"] {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #f56565, stop:1 #e53e3e);"
+        "}"
+        "QPushButton[rowAction=\"delete\"]:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #e53e3e, stop:1 #c53030);"
+        "}"
+        "QPushButton[rowAction=\"delete\"]:pressed {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #c53030, stop:1 #742a2a);"
+        "}";
+    return rules;
+}
+
 QString ThemeManager::getTableStylesheet() const
 {
-    QString bgColor = backgroundColor().name();
-    QString surfaceColor_str = surfaceColor().name();
-    QString textColor_str = textColor().name();
-    QString textSecondary = textSecondaryColor().name();
-    QString borderColor_str = borderColor().name();
-    QString headerBg = tableHeaderBackground().name();
-    
     return QString(
         "QTableWidget {"
-        "   background: %1;"
-        "   border: 1px solid %2;"
+        "   background: palette(button);"
+        "   border: 1px solid palette(mid);"
         "   border-radius: 8px;"
         "   font-size: 13px;"
-        "   color: %3;"
-        "   gridline-color: %2;"
+        "   color: palette(text);"
+        "   gridline-color: palette(mid);"
         "}"
         "QTableWidget::item {"
         "   padding: 12px 16px;"
         "   border: none;"
         "}"
         "QTableWidget::item:selected {"
-        "   background: %2;"
-        "   color: %3;"
+        "   background: palette(mid);"
+        "   color: palette(text);"
         "}"
         "QHeaderView::section {"
-        "   background: %4;"
-        "   color: %3;"
+        "   background: palette(alternate-base);"
+        "   color: palette(text);"
         "   padding: 12px 16px;"
         "   border: none;"
-        "   border-bottom: 2px solid %2;"
+        "   border-bottom: 2px solid palette(mid);"
         "   font-weight: 600;"
         "   font-size: 12px;"
         "   text-align: left;"
         "}"
-    ).arg(surfaceColor_str, borderColor_str, textColor_str, headerBg);
+    );
 }
 
 QString ThemeManager::getInputStylesheet() const
 {
-    QString inputBg = inputBackground().name();
-    QString inputBrd = inputBorder().name();
-    QString focusBrd = inputFocusBorder().name();
-    QString textCol = textColor().name();
-    
     return QString(
         "QLineEdit, QTextEdit, QComboBox {"
-        "   background: %1;"
-        "   color: %3;"
-        "   border: 2px solid %2;"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "   border: 2px solid palette(mid);"
         "   border-radius: 6px;"
         "   padding: 10px;"
         "   font-size: 13px;"
         "}"
         "QLineEdit:focus, QTextEdit:focus, QComboBox:focus {"
-        "   border: 2px solid %4;"
+        "   border: 2px solid palette(highlight);"
         "}"
-    ).arg(inputBg, inputBrd, textCol, focusBrd);
+    );
 }
 
 QString ThemeManager::getButtonStylesheet(const QString &color) const
 {
-    QColor btnColor, btnHover, btnPressed;
-    
-    if (color == "primary") {
-        btnColor = primaryColor();
-        btnHover = primaryHoverColor();
-        btnPressed = primaryPressedColor();
-    } else if (color == "danger") {
-        btnColor = dangerColor();
-        btnHover = dangerHoverColor();
-        btnPressed = dangerPressedColor();
-    } else if (color == "success") {
-        btnColor = successColor();
-        btnHover = successColor();
-        btnPressed = successColor();
-    } else {
-        btnColor = primaryColor();
-        btnHover = primaryHoverColor();
-        btnPressed = primaryPressedColor();
+    if (color == "danger" || color == "success") {
+        // Pas de rôle palette pour ces teintes : une règle par thème
+        QString rules;
+        for (Theme theme : {LightMode, DarkMode}) {
+            StatusColors colors = statusColors(theme);
+            QColor base = (color == "danger") ? colors.danger : colors.success;
+            rules += buttonRules(QString("*[theme=\"%1\"] QPushButton").arg(themeName(theme)),
+                                 base.name(), base.darker(115).name(), base.darker(130).name());
+        }
+        return rules;
     }
-    
-    return QString(
-        "QPushButton {"
-        "   background: %1;"
-        "   color: white;"
-        "   border: 2px solid %1;"
-        "   border-radius: 6px;"
-        "   padding: 10px 20px;"
-        "   font-weight: 600;"
-        "   font-size: 13px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: %2;"
-        "   border-color: %2;"
-        "}"
-        "QPushButton:pressed {"
-        "   background: %3;"
-        "   border-color: %3;"
-        "}"
-        "QPushButton:disabled {"
-        "   background: %4;"
-        "   color: %5;"
-        "   border-color: %4;"
-        "}"
-    ).arg(btnColor.name(), btnHover.name(), btnPressed.name(), 
-          disabledColor().name(), textTertiaryColor().name());
+
+    // Primaire : la base suit la palette, survol et appui sont donnés par thème
+    QString rules = buttonRules("QPushButton", "palette(highlight)", "palette(highlight)", "palette(highlight)");
+    for (Theme theme : {LightMode, DarkMode}) {
+        StatusColors colors = statusColors(theme);
+        rules += QString("*[theme=\"%1\"] QPushButton:hover { background: %2; border-color: %2; }"
+                         "*[theme=\"%1\"] QPushButton:pressed { background: %3; border-color: %3; }")
+                     .arg(themeName(theme), colors.primaryHover.name(), colors.primaryPressed.name());
+    }
+    return rules;
 }
 
 QString ThemeManager::getCompleteStylesheet() const
 {
-    QString bgColor = backgroundColor().name();
-    QString surfaceColor_str = surfaceColor().name();
-    QString textColor_str = textColor().name();
-    QString textSecondary = textSecondaryColor().name();
-    QString borderColor_str = borderColor().name();
-    QString primaryColor_str = primaryColor().name();
-    QString primaryHover_str = primaryHoverColor().name();
-    QString primaryPressed_str = primaryPressedColor().name();
-    
     return QString(
-        "QMainWindow, QDialog, QWidget, QFrame { background: %1; color: %2; }"
-        "%3%4%5"
-    ).arg(bgColor, textColor_str, getTableStylesheet(), getInputStylesheet(), 
-          getButtonStylesheet());
+        "QMainWindow, QDialog, QWidget, QFrame {"
+        "   background: palette(window);"
+        "   color: palette(window-text);"
+        "   font-family: 'Segoe UI', system-ui, -apple-system, sans-serif;"
+        "}"
+        "%1%2%3%4"
+    ).arg(getTableStylesheet(), getInputStylesheet(), getButtonStylesheet(), statusRules());
 }
 
 QString ThemeManager::getCardStylesheet() const
 {
-    QString cardBg = cardBackground().name();
-    QString cardBrd = cardBorder().name();
-    QString textCol = textColor().name();
-    
     return QString(
-        "background: %1;"
-        "border: 1px solid %2;"
+        "background: palette(button);"
+        "border: 1px solid palette(mid);"
         "border-radius: 8px;"
         "padding: 16px;"
-        "color: %3;"
-    ).arg(cardBg, cardBrd, textCol);
+        "color: palette(text);"
+    );
 }
 
 QString ThemeManager::getDialogStylesheet() const
 {
-    QString bgColor = backgroundColor().name();
-    QString textCol = textColor().name();
-    QString surfaceCol = surfaceColor().name();
-    
     return QString(
         "QDialog {"
-        "   background: %1;"
-        "   color: %2;"
+        "   background: palette(window);"
+        "   color: palette(window-text);"
         "}"
         "QLabel {"
-        "   color: %2;"
+        "   color: palette(window-text);"
         "}"
         "QGroupBox {"
-        "   background: %3;"
-        "   color: %2;"
-        "   border: 1px solid %1;"
+        "   background: palette(button);"
+        "   color: palette(window-text);"
+        "   border: 1px solid palette(window);"
         "   border-radius: 6px;"
         "   padding: 12px;"
         "   margin-top: 12px;"
@@ -367,7 +499,7 @@ QString ThemeManager::getDialogStylesheet() const
         "   left: 10px;"
         "   padding: 0 3px 0 3px;"
         "}"
-    ).arg(bgColor, textCol, surfaceCol);
+    );
 }
 
 void ThemeManager::saveThemePreference()
@@ -379,6 +511,7 @@ void ThemeManager::saveThemePreference()
 void ThemeManager::loadThemePreference()
 {
     QSettings settings("GestionVente", "GestionVenteMateriel");
-    QString theme = settings.value("theme", "light").toString();
+    // Sombre par défaut : c'était le seul thème avant le bouton de la sidebar
+    QString theme = settings.value("theme", "dark").toString();
     m_currentTheme = (theme == "dark") ? DarkMode : LightMode;
 }
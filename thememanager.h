@@ -5,6 +5,9 @@
 #include <QColor>
 #include <QMap>
 #include <QObject>
+#include <QPalette>
+
+class QWidget;
 
 class ThemeManager : public QObject
 {
@@ -58,10 +61,34 @@ public:
     QColor inputFocusBorder() const;
     QColor disabledColor() const;
     
+    // Palette de l'application pour le thème courant. Les feuilles de style
+    // n'écrivent pas les couleurs neutres en dur mais des rôles palette(...) :
+    //   window            fond                 window-text, text  texte
+    //   base              champs de saisie     alternate-base     surface alternative
+    //   button            surface              placeholder-text   texte tertiaire
+    //   highlight         primaire             mid, midlight      bordures
+    //   highlighted-text  texte sur primaire
+    // Les autres rôles gardent leur sens (bulles d'aide, liens...). Le texte
+    // secondaire, le survol des boutons primaires et les couleurs d'état
+    // n'ont pas de rôle : la feuille globale les donne pour chaque thème,
+    // selon la propriété "theme" de la fenêtre, aux widgets marqués par
+    // setTone() ou par la propriété "variant".
+    QPalette palette() const;
+
+    // Installe palette et feuille globale (StyleSheet::getStyleSheet()). La
+    // feuille ne dépend pas du thème, Qt ne l'analyse qu'une fois : changer
+    // de thème revient à changer la palette et à repolir les widgets, sans
+    // reconstruire ni relire de données. Sans changement de thème, seule la
+    // propriété "theme" des nouvelles fenêtres est posée.
+    void applyToApplication();
+
+    // Teinte d'un widget (success, warning, danger, info, secondary,
+    // tertiary ; vide pour aucune), résolue par la feuille globale
+    static void setTone(QWidget *widget, const QString &tone);
+
+    static QString themeName(Theme theme);
+
     // Stylesheets complets
-    QString getTableStylesheet() const;
-    QString getInputStylesheet() const;
-    QString getButtonStylesheet(const QString &color = "primary") const;
     QString getCompleteStylesheet() const;
     QString getCardStylesheet() const;
     QString getDialogStylesheet() const;
@@ -76,8 +103,31 @@ signals:
 private:
     ThemeManager();
     ~ThemeManager() = default;
-    
+
+    struct StatusColors {
+        QColor primary;
+        QColor primaryHover;
+        QColor primaryPressed;
+        QColor textSecondary;
+        QColor success;
+        QColor warning;
+        QColor danger;
+        QColor info;
+        QColor disabled;
+    };
+    StatusColors statusColors(Theme theme) const;
+    QString statusRules() const;
+
+    // Parties de getCompleteStylesheet()
+    QString getTableStylesheet() const;
+    QString getInputStylesheet() const;
+    QString getButtonStylesheet(const QString &color = "primary") const;
+    static QString buttonRules(const QString &selector, const QString &color,
+                               const QString &hover, const QString &pressed);
+
     Theme m_currentTheme;
+    Theme m_appliedTheme;
+    bool m_styleSheetInstalled;
     
     struct LightColors {
         QColor background = QColor("#ffffff");
@@ -0,0 +1,227 @@
+#include "thumbnailcache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSqlDatabase>
+#include <QThread>
+#include <QDebug>
+
+namespace {
+// Côté le plus long des miniatures générées ; la taille demandée est arrondie
+// au palier supérieur pour que les vues de tailles voisines partagent le cache.
+const int BucketEdges[] = {96, 192, 320, 640};
+const int MemoryCacheKb = 48 * 1024;
+// Cache disque : taille maximale, âge maximal d'une miniature inutilisée et
+// nombre d'écritures entre deux nettoyages
+const qint64 DiskCacheMaxBytes = 256LL * 1024 * 1024;
+const int DiskCacheMaxAgeDays = 60;
+const int WritesBetweenPrunes = 256;
+}
+
+ThumbnailCache& ThumbnailCache::instance()
+{
+    static ThumbnailCache _instance;
+    return _instance;
+}
+
+ThumbnailCache::ThumbnailCache()
+    : QObject(), m_writesSincePrune(0)
+{
+    m_memory.setMaxCost(MemoryCacheKb);
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount() - 1));
+}
+
+QSize ThumbnailCache::bucketFor(const QSize &size)
+{
+    int edge = qMax(size.width(), size.height());
+    for (int bucket : BucketEdges) {
+        if (edge <= bucket) {
+            return QSize(bucket, bucket);
+        }
+    }
+    return QSize(BucketEdges[3], BucketEdges[3]);
+}
+
+QPixmap ThumbnailCache::thumbnail(const QString &imagePath, const QSize &size)
+{
+    if (imagePath.isEmpty()) {
+        return QPixmap();
+    }
+
+    QSize bucket = bucketFor(size);
+    QString requestKey = requestKeyFor(imagePath, bucket);
+
+    auto key = m_keys.constFind(requestKey);
+    if (key != m_keys.constEnd()) {
+        if (QPixmap *pixmap = m_memory.object(key.value())) {
+            return *pixmap;
+        }
+        if (key.value().isEmpty()) {
+            return QPixmap(); // Fichier absent ou illisible
+        }
+    }
+
+    if (!m_pending.contains(requestKey)) {
+        m_pending.insert(requestKey);
+        QString diskDir = diskCacheDirectory();
+        m_pool.start([this, imagePath, requestKey, bucket, diskDir]() {
+            Result result = load(imagePath, requestKey, bucket, diskDir);
+            QMetaObject::invokeMethod(this, [this, result]() { onLoaded(result); }, Qt::QueuedConnection);
+        });
+    }
+
+    return QPixmap();
+}
+
+QString ThumbnailCache::requestKeyFor(const QString &imagePath, const QSize &bucket)
+{
+    // Un fichier remplacé change de date ou de taille : sa nouvelle clé manque
+    // le cache et la miniature est régénérée sans vider le reste
+    QFileInfo info(imagePath);
+    return QString("%1|%2|%3|%4")
+        .arg(imagePath)
+        .arg(info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0)
+        .arg(info.exists() ? info.size() : -1)
+        .arg(bucket.width());
+}
+
+void ThumbnailCache::invalidate(const QString &imagePath)
+{
+    if (imagePath.isEmpty()) {
+        return;
+    }
+
+    const QString prefix = imagePath + '|';
+    for (auto it = m_keys.begin(); it != m_keys.end();) {
+        if (it.key().startsWith(prefix)) {
+            m_memory.remove(it.value());
+            it = m_keys.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QString ThumbnailCache::diskCacheDirectory()
+{
+    if (m_diskDir.isEmpty()) {
+        QFileInfo dbFile(QSqlDatabase::database().databaseName());
+        m_diskDir = dbFile.absoluteDir().filePath("thumbnails");
+        if (!QDir().mkpath(m_diskDir)) {
+            qDebug() << "Impossible de créer le cache de miniatures:" << m_diskDir;
+        } else {
+            schedulePrune();
+        }
+    }
+    return m_diskDir;
+}
+
+void ThumbnailCache::schedulePrune()
+{
+    m_writesSincePrune = 0;
+    QString diskDir = m_diskDir;
+    m_pool.start([diskDir]() { pruneDiskCache(diskDir); });
+}
+
+void ThumbnailCache::pruneDiskCache(const QString &diskDir)
+{
+    // La date de modification sert de date de dernier usage : load() la met
+    // à jour à chaque lecture depuis le disque
+    QDir dir(diskDir);
+    const QFileInfoList files = dir.entryInfoList({"*.png"}, QDir::Files, QDir::Time);
+    const QDateTime oldest = QDateTime::currentDateTime().addDays(-DiskCacheMaxAgeDays);
+
+    qint64 kept = 0;
+    int removed = 0;
+    for (const QFileInfo &file : files) {   // du plus récent au plus ancien
+        if (kept + file.size() <= DiskCacheMaxBytes && file.lastModified() >= oldest) {
+            kept += file.size();
+        } else if (QFile::remove(file.absoluteFilePath())) {
+            ++removed;
+        }
+    }
+    if (removed > 0) {
+        qDebug() << "Cache de miniatures:" << removed << "fichiers supprimés," << kept / 1024 << "Ko conservés";
+    }
+}
+
+ThumbnailCache::Result ThumbnailCache::load(const QString &imagePath, const QString &requestKey,
+                                            const QSize &bucket, const QString &diskDir)
+{
+    Result result;
+    result.imagePath = imagePath;
+    result.requestKey = requestKey;
+
+    QFileInfo info(imagePath);
+    if (!info.exists()) {
+        return result;
+    }
+
+    QByteArray identity = QString("%1|%2|%3|%4")
+                              .arg(info.absoluteFilePath())
+                              .arg(info.lastModified().toMSecsSinceEpoch())
+                              .arg(info.size())
+                              .arg(bucket.width())
+                              .toUtf8();
+    result.cacheKey = QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex();
+
+    QString diskFile = QDir(diskDir).filePath(result.cacheKey + ".png");
+    if (QFile::exists(diskFile) && result.image.load(diskFile)) {
+        QFile used(diskFile);
+        if (used.open(QIODevice::ReadWrite)) {
+            used.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+        return result;
+    }
+
+    // Le décodeur JPEG sait réduire pendant la lecture : bien moins coûteux
+    // que de décoder l'image pleine taille puis de la redimensionner.
+    QImageReader reader(imagePath);
+    reader.setAutoTransform(true);
+    QSize sourceSize = reader.size();
+    if (sourceSize.isValid()) {
+        reader.setScaledSize(sourceSize.scaled(bucket, Qt::KeepAspectRatio).boundedTo(sourceSize));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qDebug() << "Impossible de lire l'image" << imagePath << ":" << reader.errorString();
+        result.cacheKey.clear();
+        return result;
+    }
+
+    if (image.width() > bucket.width() || image.height() > bucket.height()) {
+        image = image.scaled(bucket, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    if (!diskDir.isEmpty()) {
+        result.written = image.save(diskFile, "PNG");
+        if (!result.written) {
+            qDebug() << "Impossible d'écrire la miniature" << diskFile;
+        }
+    }
+
+    result.image = image;
+    return result;
+}
+
+void ThumbnailCache::onLoaded(const Result &result)
+{
+    m_pending.remove(result.requestKey);
+    m_keys.insert(result.requestKey, result.cacheKey);
+
+    if (!result.cacheKey.isEmpty() && !result.image.isNull()) {
+        auto *pixmap = new QPixmap(QPixmap::fromImage(result.image));
+        int costKb = qMax<qsizetype>(1, result.image.sizeInBytes() / 1024);
+        m_memory.insert(result.cacheKey, pixmap, costKb);
+    }
+
+    if (result.written && ++m_writesSincePrune >= WritesBetweenPrunes) {
+        schedulePrune();
+    }
+
+    emit thumbnailReady(result.imagePath);
+}
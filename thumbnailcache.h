@@ -0,0 +1,65 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QSet>
+#include <QPixmap>
+#include <QImage>
+#include <QThreadPool>
+
+// Miniatures des photos produit : décodage et mise à l'échelle sur un pool de
+// threads, cache LRU en mémoire et cache disque à côté de la base de données.
+// Le cache disque est borné : au démarrage puis toutes les quelques centaines
+// de miniatures écrites, les fichiers trop vieux ou les moins récemment
+// utilisés au-delà de la taille maximale sont supprimés.
+class ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ThumbnailCache& instance();
+
+    // Renvoie la miniature si elle est disponible ; sinon lance son chargement
+    // en arrière-plan et renvoie un QPixmap nul (l'appelant peint un substitut).
+    QPixmap thumbnail(const QString &imagePath, const QSize &size);
+
+    // Oublie les miniatures d'une image, après modification de la photo d'un
+    // produit ; les autres restent en cache
+    void invalidate(const QString &imagePath);
+
+    static QSize bucketFor(const QSize &size);
+
+signals:
+    void thumbnailReady(const QString &imagePath);
+
+private:
+    struct Result {
+        QString imagePath;
+        QString requestKey;
+        QString cacheKey;
+        QImage image;
+        bool written = false;   // nouvelle miniature écrite sur disque
+    };
+
+    ThumbnailCache();
+    ~ThumbnailCache() = default;
+
+    QString diskCacheDirectory();
+    static QString requestKeyFor(const QString &imagePath, const QSize &bucket);
+    static Result load(const QString &imagePath, const QString &requestKey,
+                       const QSize &bucket, const QString &diskDir);
+    void onLoaded(const Result &result);
+    void schedulePrune();
+    static void pruneDiskCache(const QString &diskDir);
+
+    QCache<QString, QPixmap> m_memory;      // clé path+mtime+taille+bucket -> miniature
+    QHash<QString, QString> m_keys;         // path+mtime+taille+bucket -> clé du cache mémoire
+    QSet<QString> m_pending;
+    QThreadPool m_pool;
+    QString m_diskDir;
+    int m_writesSincePrune;
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,218 @@
+#include "uiprofiler.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaEnum>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const int HeartbeatMs = 50;
+const qint64 StallThresholdUs = 100 * 1000;
+// Au-delà d'une image à 60 Hz, un événement figure dans le trace
+const qint64 SlowEventUs = 16 * 1000;
+const int MaxEvents = 200000;
+const int RecentScopeCount = 64;
+}
+
+UiProfiler::Scope::Scope(const char *name)
+    : m_name(name), m_startUs(-1)
+{
+    UiProfiler &profiler = UiProfiler::instance();
+    if (profiler.m_running && profiler.onGuiThread()) {
+        m_startUs = profiler.nowUs();
+        profiler.m_openScopes.append(name);
+    }
+}
+
+UiProfiler::Scope::~Scope()
+{
+    if (m_startUs >= 0) {
+        UiProfiler::instance().closeScope(m_name, m_startUs);
+    }
+}
+
+UiProfiler& UiProfiler::instance()
+{
+    static UiProfiler _instance;
+    return _instance;
+}
+
+UiProfiler::UiProfiler()
+    : m_running(false),
+      m_heartbeats(0),
+      m_lastBeatUs(0),
+      m_recentNext(0),
+      m_stalls(0),
+      m_stalledUs(0)
+{
+    m_heartbeat.setInterval(HeartbeatMs);
+    m_heartbeat.setTimerType(Qt::PreciseTimer);
+    connect(&m_heartbeat, &QTimer::timeout, this, &UiProfiler::onHeartbeat);
+}
+
+void UiProfiler::start()
+{
+    m_events.clear();
+    m_openScopes.clear();
+    m_recentScopes.clear();
+    m_recentNext = 0;
+    m_frameTimesUs.clear();
+    m_stalls = 0;
+    m_stalledUs = 0;
+    m_heartbeats = 0;
+
+    m_clock.start();
+    m_lastBeatUs = 0;
+    m_heartbeat.start();
+    m_running = true;
+    qDebug() << "Profilage de l'interface démarré.";
+}
+
+bool UiProfiler::stop(const QString &tracePath)
+{
+    if (!m_running) {
+        return false;
+    }
+    m_heartbeat.stop();
+    m_running = false;
+    logSummary();
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+    events.append(QJsonObject{{"name", "thread_name"}, {"ph", "M"}, {"pid", pid}, {"tid", 1},
+                              {"args", QJsonObject{{"name", "GUI"}}}});
+    for (const TraceEvent &event : std::as_const(m_events)) {
+        QJsonObject entry{{"name", QString::fromUtf8(event.name)}, {"cat", event.category}, {"ph", "X"},
+                          {"ts", event.startUs}, {"dur", event.durationUs}, {"pid", pid}, {"tid", 1}};
+        if (!event.args.isEmpty()) {
+            entry.insert("args", event.args);
+        }
+        events.append(entry);
+    }
+
+    QFile file(tracePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Impossible d'écrire le profil de l'interface:" << file.errorString();
+        return false;
+    }
+    QJsonObject trace{{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    qDebug() << "Profil de l'interface écrit dans" << tracePath;
+    return true;
+}
+
+void UiProfiler::recordEvent(const char *className, bool isWindow, int eventType, qint64 startUs,
+                             qint64 beatsBefore)
+{
+    const qint64 durationUs = nowUs() - startUs;
+
+    // Une image : mise à jour complète d'une fenêtre (layout et peinture)
+    if (isWindow && eventType == QEvent::UpdateRequest) {
+        if (m_frameTimesUs.size() < MaxEvents) {
+            m_frameTimesUs.append(durationUs);
+        }
+        append({QByteArray("Image ") + className, "frame", startUs, durationUs, QJsonObject()});
+        return;
+    }
+
+    // Si le battement a eu lieu pendant l'événement, il contenait une boucle
+    // imbriquée (exec() d'un dialogue) : ce n'est pas un blocage
+    if (durationUs < SlowEventUs || m_heartbeats != beatsBefore) {
+        return;
+    }
+    const char *typeName = QMetaEnum::fromType<QEvent::Type>().valueToKey(eventType);
+    QByteArray name = typeName ? QByteArray(typeName) : QByteArray::number(eventType);
+    append({name + ' ' + className, "event", startUs, durationUs, QJsonObject()});
+}
+
+void UiProfiler::onHeartbeat()
+{
+    const qint64 now = nowUs();
+    const qint64 expectedUs = m_lastBeatUs + HeartbeatMs * 1000;
+    const qint64 lateUs = now - expectedUs;
+    ++m_heartbeats;
+    m_lastBeatUs = now;
+
+    if (lateUs < StallThresholdUs) {
+        return;
+    }
+
+    ++m_stalls;
+    m_stalledUs += lateUs;
+    const QStringList scopes = scopesDuring(expectedUs, now);
+    append({"Blocage", "stall", expectedUs, lateUs, QJsonObject{{"portions", QJsonArray::fromStringList(scopes)}}});
+    qDebug() << "Interface bloquée" << lateUs / 1000 << "ms"
+             << (scopes.isEmpty() ? QString("(hors portion mesurée)") : scopes.join(", "));
+}
+
+bool UiProfiler::onGuiThread() const
+{
+    return QThread::currentThread() == thread();
+}
+
+void UiProfiler::append(const TraceEvent &event)
+{
+    if (m_events.size() >= MaxEvents) {
+        return;
+    }
+    m_events.append(event);
+}
+
+void UiProfiler::closeScope(const char *name, qint64 startUs)
+{
+    const qint64 endUs = nowUs();
+    // Les portions se ferment dans l'ordre inverse de leur ouverture
+    int open = m_openScopes.lastIndexOf(name);
+    if (open >= 0) {
+        m_openScopes.remove(open);
+    }
+
+    ClosedScope closed{name, startUs, endUs};
+    if (m_recentScopes.size() < RecentScopeCount) {
+        m_recentScopes.append(closed);
+    } else {
+        m_recentScopes[m_recentNext] = closed;
+    }
+    m_recentNext = (m_recentNext + 1) % RecentScopeCount;
+
+    append({QByteArray(name), "scope", startUs, endUs - startUs, QJsonObject()});
+}
+
+QStringList UiProfiler::scopesDuring(qint64 fromUs, qint64 toUs) const
+{
+    // Portions encore ouvertes, puis portions fermées qui recouvrent le blocage
+    QStringList names;
+    for (const char *name : m_openScopes) {
+        names << QString::fromUtf8(name);
+    }
+    for (const ClosedScope &scope : m_recentScopes) {
+        if (scope.startUs < toUs && scope.endUs > fromUs) {
+            names << QString::fromUtf8(scope.name);
+        }
+    }
+    names.removeDuplicates();
+    return names;
+}
+
+void UiProfiler::logSummary() const
+{
+    if (!m_frameTimesUs.isEmpty()) {
+        QVector<qint64> frames = m_frameTimesUs;
+        std::sort(frames.begin(), frames.end());
+        qint64 total = 0;
+        for (qint64 frame : frames) {
+            total += frame;
+        }
+        qDebug().noquote() << QString("Images : %1, moyenne %2 ms, 95e centile %3 ms, max %4 ms")
+                                  .arg(frames.size())
+                                  .arg(total / frames.size() / 1000.0, 0, 'f', 2)
+                                  .arg(frames.at(frames.size() * 95 / 100) / 1000.0, 0, 'f', 2)
+                                  .arg(frames.last() / 1000.0, 0, 'f', 2);
+    }
+    qDebug().noquote() << QString("Blocages de plus de %1 ms : %2, %3 ms au total")
+                              .arg(StallThresholdUs / 1000).arg(m_stalls).arg(m_stalledUs / 1000);
+}
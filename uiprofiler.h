@@ -0,0 +1,95 @@
+#ifndef UIPROFILER_H
+#define UIPROFILER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+// Profileur du thread GUI, actif avec --profile-ui :
+//  - un battement toutes les 50 ms mesure le retard de la boucle
+//    d'événements ; un retard de plus de 100 ms est un blocage, attribué
+//    aux portions nommées (Scope) qui l'ont recouvert ;
+//  - ProfiledApplication mesure chaque image des fenêtres (UpdateRequest)
+//    et les événements longs ;
+//  - stop() écrit le tout au format Chrome trace (chrome://tracing,
+//    Perfetto) et résume images et blocages dans le journal.
+class UiProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Portion synchrone nommée, mesurée de la construction à la
+    // destruction. Sans effet hors du thread GUI ou profileur arrêté.
+    // name doit rester valide (littéral).
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name);
+        ~Scope();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        const char *m_name;
+        qint64 m_startUs;
+    };
+
+    static UiProfiler& instance();
+
+    void start();
+    // Arrête la mesure et écrit le trace dans tracePath ; false si
+    // l'écriture échoue
+    bool stop(const QString &tracePath);
+    bool isRunning() const { return m_running; }
+
+    // Appelés par ProfiledApplication, sur le thread GUI
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+    qint64 heartbeats() const { return m_heartbeats; }
+    void recordEvent(const char *className, bool isWindow, int eventType, qint64 startUs, qint64 beatsBefore);
+
+private slots:
+    void onHeartbeat();
+
+private:
+    struct TraceEvent {
+        QByteArray name;
+        const char *category;
+        qint64 startUs;
+        qint64 durationUs;
+        QJsonObject args;
+    };
+
+    struct ClosedScope {
+        const char *name;
+        qint64 startUs;
+        qint64 endUs;
+    };
+
+    UiProfiler();
+    UiProfiler(const UiProfiler&) = delete;
+    UiProfiler& operator=(const UiProfiler&) = delete;
+
+    bool onGuiThread() const;
+    void append(const TraceEvent &event);
+    void closeScope(const char *name, qint64 startUs);
+    QStringList scopesDuring(qint64 fromUs, qint64 toUs) const;
+    void logSummary() const;
+
+    QElapsedTimer m_clock;
+    QTimer m_heartbeat;
+    bool m_running;
+    qint64 m_heartbeats;
+    qint64 m_lastBeatUs;
+    QVector<TraceEvent> m_events;
+    QVector<const char *> m_openScopes;
+    QVector<ClosedScope> m_recentScopes;   // tampon circulaire pour l'attribution
+    int m_recentNext;
+    QVector<qint64> m_frameTimesUs;
+    int m_stalls;
+    qint64 m_stalledUs;
+};
+
+#endif // UIPROFILER_H
@@ -1,4 +1,6 @@
 #include "userdialog.h"
+#include "queryprofiler.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QLabel>
@@ -10,6 +12,7 @@
 UserDialog::UserDialog(QWidget *parent, int userId)
     : QDialog(parent), currentUserId(userId)
 {
+    UiProfiler::Scope scope("UserDialog::UserDialog");
     setupUI();
     if (userId != -1) {
         loadUser(userId);
@@ -21,7 +24,7 @@ void UserDialog::setupUI()
     setWindowTitle(currentUserId == -1 ? "Ajouter un utilisateur" : "Modifier l'utilisateur");
     setMinimumWidth(500);
     setModal(true);
-    setStyleSheet("QDialog { background: #0f172a; }");
+    setObjectName("userDialog");
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setSpacing(20);
@@ -29,7 +32,7 @@ void UserDialog::setupUI()
 
     // Titre
     QLabel *title = new QLabel(currentUserId == -1 ? "➕ Nouvel Utilisateur" : "✏️ Modifier l'Utilisateur", this);
-    title->setStyleSheet("font-size: 20px; font-weight: bold; color: #f1f5f9;");
+    title->setObjectName("dialogTitle");
     mainLayout->addWidget(title);
 
     // Formulaire
@@ -55,54 +58,17 @@ void UserDialog::setupUI()
     
     chkActif = new QCheckBox("Compte actif", this);
     chkActif->setChecked(true);
-    chkActif->setStyleSheet("QCheckBox { color: #f1f5f9; }");
-
-    // Style des inputs dark mode
-    QString inputStyle = 
-        "QLineEdit, QComboBox {"
-        "   border: 2px solid #334155;"
-        "   border-radius: 6px;"
-        "   padding: 8px 12px;"
-        "   font-size: 14px;"
-        "   background: #1e293b;"
-        "   color: #f1f5f9;"
-        "}"
-        "QLineEdit:focus, QComboBox:focus {"
-        "   border-color: #667eea;"
-        "   background: #1e293b;"
-        "}"
-        "QLineEdit::placeholder {"
-        "   color: #64748b;"
-        "}"
-        "QComboBox::drop-down {"
-        "   background: #0f172a;"
-        "}"
-        "QComboBox::down-arrow {"
-        "   color: #f1f5f9;"
-        "}";
-    
-    txtNom->setStyleSheet(inputStyle);
-    txtEmail->setStyleSheet(inputStyle);
-    txtPassword->setStyleSheet(inputStyle);
-    cboRole->setStyleSheet(inputStyle);
-
-    // Style des labels
-    QString labelStyle = "QLabel { color: #f1f5f9; }";
 
     QLabel *nomLabel = new QLabel("Nom complet *", this);
-    nomLabel->setStyleSheet(labelStyle);
     formLayout->addRow(nomLabel, txtNom);
     
     QLabel *emailLabel = new QLabel("Email *", this);
-    emailLabel->setStyleSheet(labelStyle);
     formLayout->addRow(emailLabel, txtEmail);
     
     QLabel *passLabel = new QLabel("Mot de passe *", this);
-    passLabel->setStyleSheet(labelStyle);
     formLayout->addRow(passLabel, txtPassword);
     
     QLabel *roleLabel = new QLabel("Rôle *", this);
-    roleLabel->setStyleSheet(labelStyle);
     formLayout->addRow(roleLabel, cboRole);
     formLayout->addRow("", chkActif);
 
@@ -114,8 +80,49 @@ void UserDialog::setupUI()
 
     btnSave = new QPushButton("💾 Enregistrer", this);
     btnSave->setMinimumHeight(45);
-    btnSave->setStyleSheet(
-        "QPushButton {"
+    btnSave->setObjectName("saveButton");
+    connect(btnSave, &QPushButton::clicked, this, &UserDialog::onSave);
+
+    btnCancel = new QPushButton("❌ Annuler", this);
+    btnCancel->setMinimumHeight(45);
+    btnCancel->setObjectName("cancelButton");
+    connect(btnCancel, &QPushButton::clicked, this, &UserDialog::onCancel);
+
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(btnSave);
+    buttonLayout->addWidget(btnCancel);
+
+    mainLayout->addLayout(buttonLayout);
+}
+
+QString UserDialog::styleRules()
+{
+    return QString(
+        "QDialog#userDialog {"
+        "   background: palette(window);"
+        "}"
+        "#userDialog QLabel, #userDialog QCheckBox {"
+        "   color: palette(text);"
+        "}"
+        "#userDialog QLabel#dialogTitle {"
+        "   font-size: 20px;"
+        "   font-weight: bold;"
+        "}"
+        "#userDialog QLineEdit, #userDialog QComboBox {"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 6px;"
+        "   padding: 8px 12px;"
+        "   font-size: 14px;"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "}"
+        "#userDialog QLineEdit:focus, #userDialog QComboBox:focus {"
+        "   border-color: palette(highlight);"
+        "}"
+        "#userDialog QComboBox::drop-down {"
+        "   background: palette(window);"
+        "}"
+        "#userDialog QPushButton#saveButton {"
         "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #10b981, stop:1 #059669);"
         "   color: white;"
         "   border: none;"
@@ -125,19 +132,13 @@ void UserDialog::setupUI()
         "   font-weight: bold;"
         "   outline: none;"
         "}"
-        "QPushButton:hover {"
+        "#userDialog QPushButton#saveButton:hover {"
         "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #059669, stop:1 #047857);"
         "}"
-        "QPushButton:pressed {"
+        "#userDialog QPushButton#saveButton:pressed {"
         "   background: #047857;"
         "}"
-    );
-    connect(btnSave, &QPushButton::clicked, this, &UserDialog::onSave);
-
-    btnCancel = new QPushButton("❌ Annuler", this);
-    btnCancel->setMinimumHeight(45);
-    btnCancel->setStyleSheet(
-        "QPushButton {"
+        "#userDialog QPushButton#cancelButton {"
         "   background: transparent;"
         "   color: #e53e3e;"
         "   border: 2px solid #e53e3e;"
@@ -147,21 +148,14 @@ void UserDialog::setupUI()
         "   font-weight: bold;"
         "   outline: none;"
         "}"
-        "QPushButton:hover {"
+        "#userDialog QPushButton#cancelButton:hover {"
         "   background: #e53e3e;"
         "   color: white;"
         "}"
-        "QPushButton:pressed {"
+        "#userDialog QPushButton#cancelButton:pressed {"
         "   background: #c53030;"
         "}"
     );
-    connect(btnCancel, &QPushButton::clicked, this, &UserDialog::onCancel);
-
-    buttonLayout->addStretch();
-    buttonLayout->addWidget(btnSave);
-    buttonLayout->addWidget(btnCancel);
-
-    mainLayout->addLayout(buttonLayout);
 }
 
 void UserDialog::loadUser(int userId)
@@ -170,7 +164,7 @@ void UserDialog::loadUser(int userId)
     query.prepare("SELECT nom, email, role, actif FROM USERS WHERE id_user = :id");
     query.bindValue(":id", userId);
     
-    if (query.exec() && query.next()) {
+    if (QueryProfiler::exec(query) && query.next()) {
         txtNom->setText(query.value(0).toString());
         txtEmail->setText(query.value(1).toString());
         cboRole->setCurrentText(query.value(2).toString());
@@ -258,7 +252,7 @@ void UserDialog::onSave()
         query.bindValue(":actif", chkActif->isChecked() ? 1 : 0);
     }
 
-    if (query.exec()) {
+    if (QueryProfiler::exec(query)) {
         QMessageBox::information(this, "Succès", 
             currentUserId == -1 ? "Utilisateur ajouté avec succès!" : "Utilisateur modifié avec succès!");
         accept();
@@ -14,6 +14,8 @@ class UserDialog : public QDialog
 public:
     explicit UserDialog(QWidget *parent = nullptr, int userId = -1);
 
+    static QString styleRules();
+
 private slots:
     void onSave();
     void onCancel();
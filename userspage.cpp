@@ -1,5 +1,9 @@
 #include "userspage.h"
+#include "queryprofiler.h"
 #include "userdialog.h"
+#include "usertablemodel.h"
+#include "rowactiondelegate.h"
+#include "uiprofiler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -9,30 +13,19 @@
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QScrollBar>
-#include "thememanager.h"
+#include <algorithm>
+#include "databaseservice.h"
+#include "searchcontroller.h"
+#include "countcache.h"
 
-UsersPage::UsersPage(QWidget *parent) : QFrame(parent), currentPage(0), itemsPerPage(5), totalItems(0)
+UsersPage::UsersPage(QWidget *parent) : QFrame(parent), currentPage(0), itemsPerPage(20), totalItems(0),
+    pager(listPager(itemsPerPage)), loadGeneration(0)
 {
     setObjectName("usersPage");
-    setupDatabase();
     setupUI();
-    applyStyles();
     loadUsers();
 }
 
-void UsersPage::setupDatabase()
-{
-    QSqlQuery query;
-    query.exec("CREATE TABLE IF NOT EXISTS USERS ("
-               "id_user INTEGER PRIMARY KEY AUTOINCREMENT, "
-               "nom TEXT NOT NULL, "
-               "email TEXT UNIQUE NOT NULL, "
-               "mot_de_passe TEXT NOT NULL, "
-               "role TEXT CHECK(role IN ('ADMIN','VENDEUR','CAISSIER')) NOT NULL, "
-               "actif INTEGER DEFAULT 1, "
-               "date_creation DATETIME DEFAULT CURRENT_TIMESTAMP)");
-}
-
 void UsersPage::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -41,23 +34,10 @@ void UsersPage::setupUI()
 
     QHBoxLayout *headerLayout = new QHBoxLayout();
     QLabel *icon = new QLabel(this);
-    icon->setStyleSheet(
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "stop:0 #667eea, stop:1 #764ba2);"
-        "border-radius: 12px;"
-        "min-width: 48px; max-width: 48px;"
-        "min-height: 48px; max-height: 48px;"
-    );
+    icon->setObjectName("pageIcon");
     
     QLabel *title = new QLabel("Gestion des Utilisateurs", this);
     title->setObjectName("titleH1");
-    ThemeManager& theme = ThemeManager::instance();
-    title->setStyleSheet(QString(
-        "font-size: 32px;"
-        "font-weight: 700;"
-        "color: %1;"
-        "letter-spacing: -0.5px;").arg(theme.textColor().name())
-    );
     
     headerLayout->addWidget(icon);
     headerLayout->addWidget(title);
@@ -70,50 +50,15 @@ void UsersPage::setupUI()
     searchInput = new QLineEdit(this);
     searchInput->setPlaceholderText("Rechercher par nom ou email...");
     searchInput->setMinimumHeight(48);
-    searchInput->setStyleSheet(
-        "QLineEdit {"
-        "   border: 1px solid #e2e8f0;"
-        "   border-radius: 12px;"
-        "   padding: 12px 20px;"
-        "   font-size: 15px;"
-        "   background: white;"
-        "   color: #2d3748;"
-        "}"
-        "QLineEdit:focus {"
-        "   border: 2px solid #667eea;"
-        "   outline: none;"
-        "}"
-        "QLineEdit::placeholder {"
-        "   color: #a0aec0;"
-        "}"
-    );
-    connect(searchInput, &QLineEdit::textChanged, this, &UsersPage::onSearchTextChanged);
+    searchInput->setObjectName("searchInput");
+    searchController = new SearchController(searchInput, this);
+    connect(searchController, &SearchController::searchRequested, this, &UsersPage::onSearchTextChanged);
 
     roleFilter = new QComboBox(this);
     roleFilter->addItems({"Tous les roles", "ADMIN", "VENDEUR", "CAISSIER"});
     roleFilter->setMinimumHeight(48);
     roleFilter->setMinimumWidth(200);
-    roleFilter->setStyleSheet(
-        "QComboBox {"
-        "   border: 1px solid #e2e8f0;"
-        "   border-radius: 12px;"
-        "   padding: 12px 20px;"
-        "   font-size: 15px;"
-        "   background: white;"
-        "   color: #2d3748;"
-        "}"
-        "QComboBox:focus {"
-        "   border: 2px solid #667eea;"
-        "}"
-        "QComboBox::drop-down {"
-        "   border: none;"
-        "   width: 35px;"
-        "}"
-        "QComboBox::down-arrow {"
-        "   width: 12px;"
-        "   height: 12px;"
-        "}"
-    );
+    roleFilter->setObjectName("roleFilter");
     connect(roleFilter, &QComboBox::currentTextChanged, this, &UsersPage::onFilterRoleChanged);
 
     searchLayout->addWidget(searchInput, 3);
@@ -126,49 +71,13 @@ void UsersPage::setupUI()
     btnAdd = new QPushButton("+ Ajouter", this);
     btnAdd->setMinimumHeight(48);
     btnAdd->setCursor(Qt::PointingHandCursor);
-    btnAdd->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #3b82f6, stop:1 #2563eb);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 12px;"
-        "   padding: 12px 32px;"
-        "   font-size: 15px;"
-        "   font-weight: 600;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #2563eb, stop:1 #1d4ed8);"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #1d4ed8;"
-        "}"
-    );
+    btnAdd->setObjectName("addButton");
     connect(btnAdd, &QPushButton::clicked, this, &UsersPage::onAddUser);
 
     btnRefresh = new QPushButton("Actualiser", this);
     btnRefresh->setMinimumHeight(48);
     btnRefresh->setCursor(Qt::PointingHandCursor);
-    btnRefresh->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #3b82f6, stop:1 #2563eb);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 12px;"
-        "   padding: 12px 32px;"
-        "   font-size: 15px;"
-        "   font-weight: 600;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #2563eb, stop:1 #1d4ed8);"
-        "}"
-        "QPushButton:pressed {"
-        "   background: #1d4ed8;"
-        "}"
-    );
+    btnRefresh->setObjectName("refreshButton");
     connect(btnRefresh, &QPushButton::clicked, this, &UsersPage::loadUsers);
 
     buttonLayout->addWidget(btnAdd);
@@ -177,51 +86,36 @@ void UsersPage::setupUI()
 
     mainLayout->addLayout(buttonLayout);
 
-    tableWidget = new QTableWidget(this);
-    tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    tableWidget->setAlternatingRowColors(false);
-    tableWidget->verticalHeader()->setVisible(false);
-    tableWidget->horizontalHeader()->setStretchLastSection(true);
-    tableWidget->setShowGrid(false);
-    tableWidget->verticalHeader()->setDefaultSectionSize(50);
-    tableWidget->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    
-    // Style du tableau identique à clientspage
-    tableWidget->setStyleSheet(
-        "QTableWidget {"
-        "   background: #0f172a;"
-        "   color: #e2e8f0;"
-        "   gridline-color: #334155;"
-        "}"
-        "QTableWidget::item {"
-        "   color: #f1f5f9;"
-        "   padding: 8px;"
-        "}"
-        "QHeaderView::section {"
-        "   background: #1e293b;"
-        "   color: #e2e8f0;"
-        "   padding: 8px;"
-        "   border: none;"
-        "   border-right: 1px solid #334155;"
-        "   font-weight: bold;"
-        "}"
-    );
-
-    QStringList headers = {"ID", "NOM", "EMAIL", "ROLE", "ACTIONS"};
-    tableWidget->setColumnCount(headers.size());
-    tableWidget->setHorizontalHeaderLabels(headers);
-
-    tableWidget->setColumnWidth(0, 60);
-    tableWidget->setColumnWidth(1, 200);
-    tableWidget->setColumnWidth(2, 250);
-    tableWidget->setColumnWidth(3, 130);
-    tableWidget->setColumnWidth(4, 120);
-
-    tableWidget->verticalHeader()->setDefaultSectionSize(50);
-
-    mainLayout->addWidget(tableWidget);
+    usersModel = new UserTableModel(this);
+    rowDelegate = new RowActionDelegate(UserTableModel::ActionsColumn,
+                                        "Modifier l'utilisateur", "Supprimer l'utilisateur", this);
+    connect(rowDelegate, &RowActionDelegate::editRequested, this, &UsersPage::onEditUser);
+    connect(rowDelegate, &RowActionDelegate::deleteRequested, this, &UsersPage::onDeleteUser);
+
+    tableView = new QTableView(this);
+    tableView->setObjectName("usersTable");
+    tableView->setModel(usersModel);
+    tableView->setItemDelegate(rowDelegate);
+    tableView->setMouseTracking(true);
+    tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableView->setAlternatingRowColors(false);
+    tableView->verticalHeader()->setVisible(false);
+    tableView->horizontalHeader()->setStretchLastSection(true);
+    tableView->setShowGrid(false);
+    tableView->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+
+    tableView->setColumnWidth(UserTableModel::IdColumn, 60);
+    tableView->setColumnWidth(UserTableModel::NomColumn, 200);
+    tableView->setColumnWidth(UserTableModel::EmailColumn, 250);
+    tableView->setColumnWidth(UserTableModel::RoleColumn, 130);
+    tableView->setColumnWidth(UserTableModel::ActionsColumn, 120);
+
+    tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tableView->verticalHeader()->setDefaultSectionSize(50);
+
+    mainLayout->addWidget(tableView);
 
     QHBoxLayout *paginationLayout = new QHBoxLayout();
     paginationLayout->setSpacing(12);
@@ -229,58 +123,30 @@ void UsersPage::setupUI()
     btnFirstPage = new QPushButton("|<", this);
     btnFirstPage->setFixedSize(45, 45);
     btnFirstPage->setCursor(Qt::PointingHandCursor);
-    btnFirstPage->setStyleSheet(
-        "QPushButton {"
-        "   background: white;"
-        "   color: #4a5568;"
-        "   border: 2px solid #e2e8f0;"
-        "   border-radius: 10px;"
-        "   font-size: 16px;"
-        "   font-weight: bold;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
-        "   color: white;"
-        "   border-color: transparent;"
-        "}"
-        "QPushButton:disabled {"
-        "   background: #f7fafc;"
-        "   color: #cbd5e0;"
-        "   border-color: #e2e8f0;"
-        "}"
-    );
+    btnFirstPage->setObjectName("paginationButton");
     connect(btnFirstPage, &QPushButton::clicked, this, &UsersPage::onFirstPage);
     
     btnPrevPage = new QPushButton("<", this);
     btnPrevPage->setFixedSize(45, 45);
     btnPrevPage->setCursor(Qt::PointingHandCursor);
-    btnPrevPage->setStyleSheet(btnFirstPage->styleSheet());
+    btnPrevPage->setObjectName("paginationButton");
     connect(btnPrevPage, &QPushButton::clicked, this, &UsersPage::onPreviousPage);
     
     lblPageInfo = new QLabel("Page 1 / 1", this);
     lblPageInfo->setAlignment(Qt::AlignCenter);
     lblPageInfo->setMinimumWidth(150);
-    lblPageInfo->setStyleSheet(
-        "font-size: 14px;"
-        "font-weight: 600;"
-        "color: #4a5568;"
-        "background: white;"
-        "border: 2px solid #e2e8f0;"
-        "border-radius: 10px;"
-        "padding: 10px 20px;"
-    );
+    lblPageInfo->setObjectName("pageInfo");
     
     btnNextPage = new QPushButton(">", this);
     btnNextPage->setFixedSize(45, 45);
     btnNextPage->setCursor(Qt::PointingHandCursor);
-    btnNextPage->setStyleSheet(btnFirstPage->styleSheet());
+    btnNextPage->setObjectName("paginationButton");
     connect(btnNextPage, &QPushButton::clicked, this, &UsersPage::onNextPage);
     
     btnLastPage = new QPushButton(">|", this);
     btnLastPage->setFixedSize(45, 45);
     btnLastPage->setCursor(Qt::PointingHandCursor);
-    btnLastPage->setStyleSheet(btnFirstPage->styleSheet());
+    btnLastPage->setObjectName("paginationButton");
     connect(btnLastPage, &QPushButton::clicked, this, &UsersPage::onLastPage);
     
     paginationLayout->addStretch();
@@ -294,186 +160,247 @@ void UsersPage::setupUI()
     mainLayout->addLayout(paginationLayout);
 }
 
-void UsersPage::applyStyles()
+QString UsersPage::styleRules()
 {
-    ThemeManager& theme = ThemeManager::instance();
-    QString bgColor = (theme.currentTheme() == ThemeManager::LightMode) 
-        ? "#f7fafc" 
-        : theme.backgroundColor().name();
-    
-    setStyleSheet(QString(
-        "#usersPage {"
-        "   background: %1;"
+    return QString(
+        "#usersPage QLabel#pageIcon {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
+        "   border-radius: 12px;"
+        "   min-width: 48px;"
+        "   max-width: 48px;"
+        "   min-height: 48px;"
+        "   max-height: 48px;"
         "}"
-    ).arg(bgColor));
-}
-
-QWidget* UsersPage::createRoleBadge(const QString &role)
-{
-    QWidget *badgeContainer = new QWidget();
-    QHBoxLayout *layout = new QHBoxLayout(badgeContainer);
-    layout->setContentsMargins(0, 0, 0, 0);
-    layout->setAlignment(Qt::AlignLeft);
-    
-    QLabel *badge = new QLabel(role);
-    badge->setAlignment(Qt::AlignCenter);
-    
-    QString bgColor, textColor;
-    if (role == "ADMIN") {
-        bgColor = "#fee2e2";
-        textColor = "#991b1b";
-    } else if (role == "VENDEUR") {
-        bgColor = "#dbeafe";
-        textColor = "#1e40af";
-    } else {
-        bgColor = "#fef3c7";
-        textColor = "#92400e";
-    }
-    
-    badge->setStyleSheet(QString(
-        "background: %1;"
-        "color: %2;"
-        "border-radius: 10px;"
-        "padding: 8px 20px;"
-        "font-weight: 700;"
-        "font-size: 11px;"
-        "letter-spacing: 0.5px;"
-    ).arg(bgColor).arg(textColor));
-    
-    layout->addWidget(badge);
-    return badgeContainer;
-}
-
-QWidget* UsersPage::createActionButtons(int userId)
-{
-    QWidget *actionWidget = new QWidget();
-    QHBoxLayout *actionLayout = new QHBoxLayout(actionWidget);
-    actionLayout->setContentsMargins(2, 2, 2, 2);
-    actionLayout->setSpacing(4);
-    actionLayout->setAlignment(Qt::AlignCenter);
-
-    QPushButton *editBtn = new QPushButton("✏️", this);
-    editBtn->setFixedSize(22, 22);
-    editBtn->setCursor(Qt::PointingHandCursor);
-    editBtn->setToolTip("Modifier l'utilisateur");
-    editBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #667eea, stop:1 #764ba2);"
+        "#usersPage QLabel#titleH1 {"
+        "   font-size: 32px;"
+        "   font-weight: 700;"
+        "   color: palette(window-text);"
+        "   letter-spacing: -0.5px;"
+        "}"
+        "#usersPage QLineEdit#searchInput {"
+        "   border: 1px solid palette(mid);"
+        "   border-radius: 12px;"
+        "   padding: 12px 20px;"
+        "   font-size: 15px;"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "}"
+        "#usersPage QLineEdit#searchInput:focus {"
+        "   border: 2px solid palette(highlight);"
+        "   outline: none;"
+        "}"
+        "#usersPage QLineEdit#searchInput::placeholder {"
+        "   color: palette(placeholder-text);"
+        "}"
+        "#usersPage QComboBox#roleFilter {"
+        "   border: 1px solid palette(mid);"
+        "   border-radius: 12px;"
+        "   padding: 12px 20px;"
+        "   font-size: 15px;"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "}"
+        "#usersPage QComboBox#roleFilter:focus {"
+        "   border: 2px solid palette(highlight);"
+        "}"
+        "#usersPage QComboBox#roleFilter::drop-down {"
+        "   border: none;"
+        "   width: 35px;"
+        "}"
+        "#usersPage QComboBox#roleFilter::down-arrow {"
+        "   width: 12px;"
+        "   height: 12px;"
+        "}"
+        "#usersPage QPushButton#addButton {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #3b82f6, stop:1 #2563eb);"
         "   color: white;"
         "   border: none;"
-        "   border-radius: 4px;"
-        "   font-size: 11px;"
-        "   font-weight: bold;"
-        "   padding: 0px;"
+        "   border-radius: 12px;"
+        "   padding: 12px 32px;"
+        "   font-size: 15px;"
+        "   font-weight: 600;"
         "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #5568d3, stop:1 #6a3a8a);"
+        "#usersPage QPushButton#addButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #2563eb, stop:1 #1d4ed8);"
         "}"
-        "QPushButton:pressed {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #4556b8, stop:1 #5a2a7a);"
+        "#usersPage QPushButton#addButton:pressed {"
+        "   background: #1d4ed8;"
         "}"
-    );
-    connect(editBtn, &QPushButton::clicked, this, [this, userId]() { onEditUser(userId); });
-
-    QPushButton *deleteBtn = new QPushButton("🗑️", this);
-    deleteBtn->setFixedSize(22, 22);
-    deleteBtn->setCursor(Qt::PointingHandCursor);
-    deleteBtn->setToolTip("Supprimer l'utilisateur");
-    deleteBtn->setStyleSheet(
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #f56565, stop:1 #e53e3e);"
+        "#usersPage QPushButton#refreshButton {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #3b82f6, stop:1 #2563eb);"
         "   color: white;"
         "   border: none;"
-        "   border-radius: 4px;"
-        "   font-size: 11px;"
+        "   border-radius: 12px;"
+        "   padding: 12px 32px;"
+        "   font-size: 15px;"
+        "   font-weight: 600;"
+        "}"
+        "#usersPage QPushButton#refreshButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #2563eb, stop:1 #1d4ed8);"
+        "}"
+        "#usersPage QPushButton#refreshButton:pressed {"
+        "   background: #1d4ed8;"
+        "}"
+        "#usersPage QTableView#usersTable {"
+        "   background: palette(window);"
+        "   color: palette(text);"
+        "   gridline-color: palette(mid);"
+        "}"
+        "#usersPage QTableView#usersTable::item {"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "}"
+        "#usersPage #usersTable QHeaderView::section {"
+        "   background: palette(button);"
+        "   color: palette(text);"
+        "   padding: 8px;"
+        "   border: none;"
+        "   border-right: 1px solid palette(mid);"
         "   font-weight: bold;"
-        "   padding: 0px;"
         "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #e53e3e, stop:1 #c53030);"
+        "#usersPage QPushButton#paginationButton {"
+        "   background: palette(base);"
+        "   color: palette(text);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   font-size: 16px;"
+        "   font-weight: bold;"
         "}"
-        "QPushButton:pressed {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 #c53030, stop:1 #742a2a);"
+        "#usersPage QPushButton#paginationButton:hover {"
+        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2);"
+        "   color: white;"
+        "   border-color: transparent;"
+        "}"
+        "#usersPage QPushButton#paginationButton:disabled {"
+        "   background: palette(alternate-base);"
+        "   color: palette(placeholder-text);"
+        "   border-color: palette(mid);"
+        "}"
+        "#usersPage QLabel#pageInfo {"
+        "   font-size: 14px;"
+        "   font-weight: 600;"
+        "   color: palette(text);"
+        "   background: palette(base);"
+        "   border: 2px solid palette(mid);"
+        "   border-radius: 10px;"
+        "   padding: 10px 20px;"
+        "}"
+        "#usersPage {"
+        "   background: palette(window);"
         "}"
     );
-    connect(deleteBtn, &QPushButton::clicked, this, [this, userId]() { onDeleteUser(userId); });
-
-    actionLayout->addWidget(editBtn);
-    actionLayout->addWidget(deleteBtn);
-
-    return actionWidget;
 }
 
-void UsersPage::loadUsers()
+KeysetPager UsersPage::listPager(int pageSize)
 {
-    QSqlQuery countQuery;
-    QString filter = "1=1";
+    return KeysetPager("date_creation", "id_user", pageSize);
+}
 
-    QString searchText = searchInput->text();
+QString UsersPage::listFilter(const QString &searchText, const QString &role, QVariantList &values)
+{
+    QStringList conditions;
     if (!searchText.isEmpty()) {
-        filter += QString(" AND (nom LIKE '%%1%' OR email LIKE '%%1%')").arg(searchText);
+        conditions << "(nom LIKE ? OR email LIKE ?)";
+        values << "%" + searchText + "%" << "%" + searchText + "%";
     }
-
-    QString roleText = roleFilter->currentText();
-    if (roleText != "Tous les roles") {
-        filter += QString(" AND role = '%1'").arg(roleText);
+    if (!role.isEmpty() && role != "Tous les roles") {
+        conditions << "role = ?";
+        values << role;
     }
+    return conditions.isEmpty() ? "1=1" : conditions.join(" AND ");
+}
 
-    countQuery.prepare(QString("SELECT COUNT(*) FROM USERS WHERE %1").arg(filter));
-    if (countQuery.exec() && countQuery.next()) {
-        totalItems = countQuery.value(0).toInt();
-    }
+QString UsersPage::listSql(const QString &filter, const KeysetPager &pager, int page)
+{
+    return QString("SELECT id_user, nom, email, role, date_creation FROM USERS WHERE %1 AND %2 %3 %4")
+        .arg(filter, pager.seekCondition(page), pager.orderClause(page), pager.limitClause(page));
+}
 
-    tableWidget->setRowCount(0);
+QString UsersPage::countSql(const QString &filter)
+{
+    return QString("SELECT COUNT(*) FROM USERS WHERE %1").arg(filter);
+}
 
-    QSqlQuery query;
-    int offset = currentPage * itemsPerPage;
-    
-    query.prepare(QString("SELECT id_user, nom, email, role FROM USERS WHERE %1 ORDER BY date_creation DESC LIMIT %2 OFFSET %3")
-                  .arg(filter).arg(itemsPerPage).arg(offset));
+void UsersPage::loadUsers()
+{
+    UiProfiler::Scope scope("UsersPage::loadUsers");
+    QVariantList filterValues;
+    QString searchText = searchController->term();
+    QString roleText = roleFilter->currentText();
+    QString filter = listFilter(searchText, roleText, filterValues);
+
+    pager.setFilterKey(searchText + "|" + roleText);
+
+    countQuery.table = "USERS";
+    countQuery.filterKey = filterValues.isEmpty() ? QString() : searchText + "|" + roleText;
+    countQuery.sql = countSql(filter);
+    countQuery.bindValues = filterValues;
+    QString pageSql = listSql(filter, pager, currentPage);
+    QVariantList pageValues = filterValues + pager.pageBindValues(currentPage);
+
+    int page = currentPage;
+    bool reversed = pager.isReversed(page);
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    searchController->forgetResult();
+    const CountQuery count = countQuery;
+    const int pageSize = pager.pageSize();
+    pendingLoad = DatabaseService::instance().run<QueryResult>(
+        [count, pageSql, pageValues, page, pageSize, reversed](QSqlDatabase &db) {
+            QueryResult result = DatabaseService::select(db, pageSql, pageValues);
+            if (result.ok) {
+                CountCache::resolveTotal(db, count, page, pageSize, reversed, result);
+            }
+            return result;
+        });
+    pendingLoad.then(this, [this, generation, page, reversed, searchText](const QueryResult &result) {
+        if (generation != loadGeneration) {
+            return;
+        }
+        // Tous les utilisateurs trouvés tiennent dans la page : gardés pour
+        // filtrer en mémoire la suite de la saisie
+        if (result.ok && page == 0 && result.rows.size() <= pager.pageSize()) {
+            searchController->rememberResult(searchText, SearchController::Substring, result.rows);
+        }
+        displayUsers(result, page, reversed);
+    });
+}
 
-    if (!query.exec()) {
-        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement des utilisateurs: " + query.lastError().text());
+void UsersPage::displayUsers(const QueryResult &result, int page, bool reversed)
+{
+    if (!result.ok) {
+        QMessageBox::critical(this, "Erreur", "Erreur lors du chargement des utilisateurs: " + result.error);
         return;
     }
+    UiProfiler::Scope scope("UsersPage::displayUsers");
+
+    if (result.dataVersion >= 0) {
+        pager.setDataVersion(result.dataVersion);
+    }
+    totalItems = result.totalRows;
+    pager.setTotalRows(totalItems);
+
+    // Une page lue depuis la fin arrive en ordre croissant : on la retourne.
+    // La ligne lue en plus n'est pas affichée.
+    pager.beginPage(page, reversed, result.rows.size());
+    const int visibleRows = pager.visibleRows(result.rows.size());
+    QVector<UserRow> users;
+    users.reserve(visibleRows);
+    for (int i = 0; i < visibleRows; ++i) {
+        const QSqlRecord &record = result.rows.at(i);
+        pager.collect(record.value(4), record.value(0).toInt());
+        users.append(UserTableModel::fromRecord(record));
+    }
+    if (reversed) {
+        std::reverse(users.begin(), users.end());
+    }
+    usersModel->setUsers(users);
+    pager.endPage();
 
-    int row = 0;
-    while (query.next()) {
-        tableWidget->insertRow(row);
-
-        int id = query.value(0).toInt();
-        QString nom = query.value(1).toString();
-        QString email = query.value(2).toString();
-        QString role = query.value(3).toString();
-
-        QTableWidgetItem *idItem = new QTableWidgetItem(QString::number(id));
-        idItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        idItem->setForeground(QColor("#718096"));
-        idItem->setFont(QFont("Arial", 13, QFont::Bold));
-        
-        QTableWidgetItem *nomItem = new QTableWidgetItem(nom);
-        nomItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        nomItem->setFont(QFont("Arial", 14, QFont::DemiBold));
-        nomItem->setForeground(QColor("#1a202c"));
-        
-        QTableWidgetItem *emailItem = new QTableWidgetItem(email);
-        emailItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        emailItem->setForeground(QColor("#4a5568"));
-
-        tableWidget->setItem(row, 0, idItem);
-        tableWidget->setItem(row, 1, nomItem);
-        tableWidget->setItem(row, 2, emailItem);
-        
-        tableWidget->setCellWidget(row, 3, createRoleBadge(role));
-        tableWidget->setCellWidget(row, 4, createActionButtons(id));
-
-        row++;
+    // Dernière page atteinte en avançant : le total s'en déduit
+    if (!pager.hasTotalRows() && !pager.hasNextPage()) {
+        totalItems = page * pager.pageSize() + visibleRows;
+        pager.setTotalRows(totalItems);
     }
     
     updatePaginationControls();
@@ -481,18 +408,19 @@ void UsersPage::loadUsers()
 
 void UsersPage::updatePaginationControls()
 {
-    int totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-    if (totalPages == 0) totalPages = 1;
-    
-    lblPageInfo->setText(QString("Page %1 / %2 (%3 utilisateurs)")
-                         .arg(currentPage + 1)
-                         .arg(totalPages)
-                         .arg(totalItems));
+    if (pager.hasTotalRows()) {
+        lblPageInfo->setText(QString("Page %1 / %2 (%3 utilisateurs)")
+                             .arg(currentPage + 1)
+                             .arg(pager.pageCount())
+                             .arg(totalItems));
+    } else {
+        lblPageInfo->setText(QString("Page %1").arg(currentPage + 1));
+    }
     
     btnFirstPage->setEnabled(currentPage > 0);
     btnPrevPage->setEnabled(currentPage > 0);
-    btnNextPage->setEnabled(currentPage < totalPages - 1);
-    btnLastPage->setEnabled(currentPage < totalPages - 1);
+    btnNextPage->setEnabled(pager.hasNextPage());
+    btnLastPage->setEnabled(pager.hasNextPage());
 }
 
 void UsersPage::onFirstPage()
@@ -511,8 +439,7 @@ void UsersPage::onPreviousPage()
 
 void UsersPage::onNextPage()
 {
-    int totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-    if (currentPage < totalPages - 1) {
+    if (pager.hasNextPage()) {
         currentPage++;
         loadUsers();
     }
@@ -520,10 +447,27 @@ void UsersPage::onNextPage()
 
 void UsersPage::onLastPage()
 {
-    int totalPages = (totalItems + itemsPerPage - 1) / itemsPerPage;
-    currentPage = totalPages - 1;
-    if (currentPage < 0) currentPage = 0;
-    loadUsers();
+    if (pager.hasTotalRows()) {
+        currentPage = pager.pageCount() - 1;
+        loadUsers();
+        return;
+    }
+
+    // Seul cas où le total filtré est compté (puis mémorisé)
+    const CountQuery count = countQuery;
+    int generation = ++loadGeneration;
+    pendingLoad.cancel();
+    DatabaseService::instance().run<int>([count](QSqlDatabase &db) {
+        return CountCache::count(db, count);
+    }).then(this, [this, generation](int total) {
+        if (generation != loadGeneration || total < 0) {
+            return;
+        }
+        totalItems = total;
+        pager.setTotalRows(total);
+        currentPage = pager.pageCount() - 1;
+        loadUsers();
+    });
 }
 
 void UsersPage::onAddUser()
@@ -548,7 +492,7 @@ void UsersPage::onDeleteUser(int userId)
     QSqlQuery query;
     query.prepare("SELECT nom FROM USERS WHERE id_user = :id");
     query.bindValue(":id", userId);
-    if (!query.exec() || !query.next()) {
+    if (!QueryProfiler::exec(query) || !query.next()) {
         QMessageBox::critical(this, "Erreur", "Utilisateur introuvable.");
         return;
     }
@@ -564,7 +508,7 @@ void UsersPage::onDeleteUser(int userId)
     if (reply == QMessageBox::Yes) {
         query.prepare("DELETE FROM USERS WHERE id_user = :id");
         query.bindValue(":id", userId);
-        if (query.exec()) {
+        if (QueryProfiler::exec(query)) {
             QMessageBox::information(this, "Succes", "Utilisateur supprime avec succes.");
             loadUsers();
         } else {
@@ -576,7 +520,27 @@ void UsersPage::onDeleteUser(int userId)
 void UsersPage::onSearchTextChanged(const QString &text)
 {
     currentPage = 0;
-    loadUsers();
+
+    QVector<QSqlRecord> rows;
+    bool narrowed = searchController->narrowedResult(text, SearchController::Substring, [](const QSqlRecord &record) {
+        return record.value(1).toString() + '\n' + record.value(2).toString();
+    }, &rows);
+    if (!narrowed) {
+        loadUsers();
+        return;
+    }
+
+    // Sous-ensemble du résultat précédent : pas de requête
+    ++loadGeneration;
+    pendingLoad.cancel();
+    pager.setFilterKey(text + "|" + roleFilter->currentText());
+
+    QueryResult result;
+    result.ok = true;
+    result.rows = rows;
+    result.totalRows = rows.size();
+    searchController->rememberResult(text, SearchController::Substring, rows);
+    displayUsers(result, 0, false);
 }
 
 void UsersPage::onFilterRoleChanged(const QString &role)
@@ -2,11 +2,19 @@
 #define USERSPAGE_H
 
 #include <QFrame>
-#include <QTableWidget>
+#include <QTableView>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QComboBox>
 #include <QLabel>
+#include <QFuture>
+#include "keysetpager.h"
+#include "databaseservice.h"
+#include "searchcontroller.h"
+#include "countcache.h"
+
+class UserTableModel;
+class RowActionDelegate;
 
 class UsersPage : public QFrame
 {
@@ -15,6 +23,15 @@ class UsersPage : public QFrame
 public:
     explicit UsersPage(QWidget *parent = nullptr);
 
+    static QString styleRules();
+
+    // Requêtes de la liste, construites ici et vérifiées par QueryPlanCheck.
+    // listFilter ajoute à values les valeurs de ses paramètres.
+    static KeysetPager listPager(int pageSize);
+    static QString listFilter(const QString &searchText, const QString &role, QVariantList &values);
+    static QString listSql(const QString &filter, const KeysetPager &pager, int page);
+    static QString countSql(const QString &filter);
+
 private slots:
     void onAddUser();
     void onEditUser(int userId);
@@ -28,15 +45,15 @@ private slots:
 
 private:
     void setupUI();
-    void setupDatabase();
     void loadUsers();
-    void applyStyles();
+    void displayUsers(const QueryResult &result, int page, bool reversed);
     void updatePaginationControls();
-    QWidget* createActionButtons(int userId);
-    QWidget* createRoleBadge(const QString &role);
     
-    QTableWidget *tableWidget;
+    QTableView *tableView;
+    UserTableModel *usersModel;
+    RowActionDelegate *rowDelegate;
     QLineEdit *searchInput;
+    SearchController *searchController;
     QComboBox *roleFilter;
     QPushButton *btnAdd;
     QPushButton *btnRefresh;
@@ -49,6 +66,10 @@ private:
     int currentPage;
     int itemsPerPage;
     int totalItems;
+    KeysetPager pager;
+    CountQuery countQuery;
+    QFuture<QueryResult> pendingLoad;
+    int loadGeneration;
 };
 
 #endif // USERSPAGE_H
@@ -0,0 +1,116 @@
+#include "usertablemodel.h"
+#include "rowactiondelegate.h"
+#include "thememanager.h"
+#include <QColor>
+#include <QFont>
+
+UserTableModel::UserTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int UserTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_users.size();
+}
+
+int UserTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QColor UserTableModel::roleColor(const QString &role)
+{
+    const ThemeManager &theme = ThemeManager::instance();
+    if (role == "ADMIN") {
+        return theme.dangerColor();
+    }
+    return role == "VENDEUR" ? theme.infoColor() : theme.warningColor();
+}
+
+QVariant UserTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_users.size()) {
+        return QVariant();
+    }
+
+    static const QFont idFont("Arial", 13, QFont::Bold);
+    static const QFont nomFont("Arial", 14, QFont::DemiBold);
+
+    const UserRow &user = m_users.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case IdColumn: return QString::number(user.id);
+        case NomColumn: return user.nom;
+        case EmailColumn: return user.email;
+        case RoleColumn: return user.role;
+        default: return QVariant();
+        }
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignLeft | Qt::AlignVCenter);
+    case Qt::FontRole:
+        if (index.column() == IdColumn) {
+            return idFont;
+        }
+        if (index.column() == NomColumn) {
+            return nomFont;
+        }
+        return QVariant();
+    case Qt::ForegroundRole:
+        // Couleurs du thème courant ; le nom garde le texte de la palette
+        switch (index.column()) {
+        case NomColumn: return QVariant();
+        case RoleColumn: return roleColor(user.role);
+        default: return ThemeManager::instance().textSecondaryColor();
+        }
+    case Qt::BackgroundRole: {
+        // Fond de la pastille de rôle : sa teinte, translucide
+        if (index.column() != RoleColumn) {
+            return QVariant();
+        }
+        QColor badge = roleColor(user.role);
+        badge.setAlpha(48);
+        return badge;
+    }
+    case RowActionDelegate::BadgeRole:
+        return index.column() == RoleColumn;
+    case RowActionDelegate::RowIdRole:
+        return user.id;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant UserTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case IdColumn: return "ID";
+    case NomColumn: return "NOM";
+    case EmailColumn: return "EMAIL";
+    case RoleColumn: return "ROLE";
+    case ActionsColumn: return "ACTIONS";
+    default: return QVariant();
+    }
+}
+
+void UserTableModel::setUsers(const QVector<UserRow> &users)
+{
+    beginResetModel();
+    m_users = users;
+    endResetModel();
+}
+
+UserRow UserTableModel::fromRecord(const QSqlRecord &record)
+{
+    UserRow user;
+    user.id = record.value(0).toInt();
+    user.nom = record.value(1).toString();
+    user.email = record.value(2).toString();
+    user.role = record.value(3).toString();
+    return user;
+}
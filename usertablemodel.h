@@ -0,0 +1,51 @@
+#ifndef USERTABLEMODEL_H
+#define USERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include <QSqlRecord>
+#include <QVector>
+
+struct UserRow {
+    int id = 0;
+    QString nom;
+    QString email;
+    QString role;
+};
+
+// Page courante de la liste des utilisateurs. Le rôle est peint en pastille
+// et les boutons d'action par RowActionDelegate, sans widget par ligne.
+class UserTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        IdColumn,
+        NomColumn,
+        EmailColumn,
+        RoleColumn,
+        ActionsColumn,
+        ColumnCount
+    };
+
+    explicit UserTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void setUsers(const QVector<UserRow> &users);
+
+    // Ligne lue par UsersPage : id, nom, email, rôle
+    static UserRow fromRecord(const QSqlRecord &record);
+
+private:
+    // Teinte du thème pour un rôle : pastille et texte
+    static QColor roleColor(const QString &role);
+
+    QVector<UserRow> m_users;
+};
+
+#endif // USERTABLEMODEL_H